@@ -0,0 +1,80 @@
+// ChecksumBench.cpp
+// 校验内核微基准：对每种内核、每种帧长统计吞吐（MB/s）。
+// 用法：checksum_bench [最短测量毫秒数，默认200]
+#include "Checksum.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct NamedKernel
+    {
+        const char *name;
+        Checksum::Kernel fn;
+    };
+
+    volatile quint32 g_sink = 0; // 防止结果被优化掉
+
+    double measureMBps(Checksum::Kernel fn, const std::vector<uchar> &buf, qint64 minMs)
+    {
+        // 先粗估每批迭代次数，使单次计时足够长
+        std::size_t iters = 1;
+        QElapsedTimer t;
+        for (;;)
+        {
+            t.start();
+            quint32 acc = 0;
+            for (std::size_t i = 0; i < iters; ++i)
+                acc += fn(buf.data(), buf.size());
+            g_sink = g_sink + acc;
+            const qint64 ns = t.nsecsElapsed();
+            if (ns >= minMs * 1000000 || iters > (std::size_t(1) << 40))
+                return double(buf.size()) * double(iters) / (double(ns) / 1e9) / 1e6;
+            iters *= 2;
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const qint64 minMs = argc > 1 ? std::atoll(argv[1]) : 200;
+
+    std::vector<NamedKernel> kernels;
+    kernels.push_back({"sum16-scalar", &Checksum::sum16Scalar});
+    if (auto k = Checksum::sum16Sse2Kernel())
+        kernels.push_back({"sum16-sse2", k});
+    if (auto k = Checksum::sum16Avx2Kernel())
+        kernels.push_back({"sum16-avx2", k});
+    if (auto k = Checksum::sum16NeonKernel())
+        kernels.push_back({"sum16-neon", k});
+    kernels.push_back({"crc16-bitwise", &Checksum::crc16IbmBitwise});
+    kernels.push_back({"crc16-slice8", &Checksum::crc16IbmSlice8});
+
+    // 命令帧、航迹帧、状态帧、以太网MTU、大块
+    const std::size_t sizes[] = {49, 140, 198, 1472, 65536};
+
+    std::mt19937 rng(12345);
+    std::printf("dispatch sum16 kernel: %s\n", Checksum::sum16KernelName());
+    std::printf("%-16s", "kernel");
+    for (std::size_t n : sizes)
+        std::printf("%12zuB", n);
+    std::printf("   (MB/s)\n");
+
+    for (const NamedKernel &k : kernels)
+    {
+        std::printf("%-16s", k.name);
+        for (std::size_t n : sizes)
+        {
+            std::vector<uchar> buf(n);
+            for (auto &b : buf)
+                b = uchar(rng());
+            std::printf("%13.1f", measureMBps(k.fn, buf, minMs));
+            std::fflush(stdout);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
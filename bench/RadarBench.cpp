@@ -0,0 +1,785 @@
+// RadarBench.cpp
+// 热路径基准：报文解析、校验、报文构造、显示器航迹更新与离屏绘制。
+// 结果以 JSON 输出（默认 stdout），便于各版本之间对比回归：
+//   radar_bench [--min-ms 200] [--filter scope/] [--out result.json]
+// 每个用例单独计时：迭代次数倍增直到单次计时不短于 min-ms，报告每次操作耗时与吞吐。
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QSysInfo>
+#include <QtMath>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include "Protocol.h"
+#include "Checksum.h"
+#include "MessageIds.h"
+#include "RadarStatus.h"
+#include "TrackMessage.h"
+#include "TrackBatch.h"
+#include "RadarScopeWidget.h"
+#include "PhosphorLayer.h"
+#include "ScopeRenderer.h"
+#include "TrackTable.h"
+#include "TrackModel.h"
+#include "ThreatScorer.h"
+#include "TrackGrid.h"
+#include "TrackFilter.h"
+
+namespace
+{
+    volatile quint64 g_sink = 0; // 防止结果被优化掉
+
+    struct BenchResult
+    {
+        QString name;
+        qint64 param{-1};    // 用例参数（帧长/航迹数），-1 表示无
+        quint64 iterations{};
+        double nsPerOp{};
+        qint64 bytesPerOp{}; // 0 表示不统计字节吞吐
+    };
+
+    class BenchRunner
+    {
+    public:
+        BenchRunner(qint64 minMs, const QString &filter) : m_minMs(minMs), m_filter(filter) {}
+
+        // 该用例是否会运行（未被 --filter 排除）；构造数据较慢的用例先查询再准备
+        bool enabled(const QString &name, qint64 param) const
+        {
+            return m_filter.isEmpty() || fullName(name, param).contains(m_filter);
+        }
+
+        // fn 执行一次操作；bytesPerOp > 0 时额外报告 MB/s
+        void run(const QString &name, qint64 param, qint64 bytesPerOp, const std::function<void()> &fn)
+        {
+            if (!enabled(name, param))
+                return;
+            const QString full = fullName(name, param);
+            fn(); // 预热
+            quint64 iters = 1;
+            QElapsedTimer t;
+            for (;;)
+            {
+                t.start();
+                for (quint64 i = 0; i < iters; ++i)
+                    fn();
+                const qint64 ns = t.nsecsElapsed();
+                if (ns >= m_minMs * 1000000 || iters >= (quint64(1) << 36))
+                {
+                    BenchResult r;
+                    r.name = name;
+                    r.param = param;
+                    r.iterations = iters;
+                    r.nsPerOp = double(ns) / double(iters);
+                    r.bytesPerOp = bytesPerOp;
+                    m_results.push_back(r);
+                    std::fprintf(stderr, "%-32s %14.1f ns/op\n", qPrintable(full), r.nsPerOp);
+                    return;
+                }
+                // 按已测时间估计下一轮次数，避免从1开始倍增太多轮
+                const double scale = ns > 0 ? double(m_minMs) * 1e6 / double(ns) : 16.0;
+                iters = quint64(double(iters) * qBound(2.0, scale * 1.2, 16.0));
+            }
+        }
+
+        // 非计时的附加指标（如压缩比、每航迹内存），写入 meta
+        void note(const QString &key, double value)
+        {
+            m_notes[key] = value;
+            std::fprintf(stderr, "%-32s %14.1f\n", qPrintable(key), value);
+        }
+
+        QJsonDocument toJson() const
+        {
+            QJsonArray results;
+            for (const BenchResult &r : m_results)
+            {
+                QJsonObject o;
+                o[QStringLiteral("name")] = r.name;
+                if (r.param >= 0)
+                    o[QStringLiteral("param")] = r.param;
+                o[QStringLiteral("iterations")] = double(r.iterations);
+                o[QStringLiteral("ns_per_op")] = r.nsPerOp;
+                o[QStringLiteral("ops_per_sec")] = r.nsPerOp > 0 ? 1e9 / r.nsPerOp : 0.0;
+                if (r.bytesPerOp > 0)
+                    o[QStringLiteral("mb_per_sec")] = double(r.bytesPerOp) * 1e3 / r.nsPerOp;
+                results.append(o);
+            }
+            QJsonObject meta;
+            meta[QStringLiteral("timestamp")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+            meta[QStringLiteral("qt")] = QString::fromLatin1(qVersion());
+            meta[QStringLiteral("cpu")] = QSysInfo::currentCpuArchitecture();
+            meta[QStringLiteral("os")] = QSysInfo::prettyProductName();
+            meta[QStringLiteral("sum16_kernel")] = QString::fromLatin1(Checksum::sum16KernelName());
+            meta[QStringLiteral("threat_kernel")] = QString::fromLatin1(ThreatScorer::kernelName());
+            meta[QStringLiteral("min_ms")] = double(m_minMs);
+            for (auto it = m_notes.begin(); it != m_notes.end(); ++it)
+                meta[it.key()] = it.value();
+#if defined(QT_NO_DEBUG)
+            meta[QStringLiteral("build")] = QStringLiteral("release");
+#else
+            meta[QStringLiteral("build")] = QStringLiteral("debug");
+#endif
+            QJsonObject root;
+            root[QStringLiteral("meta")] = meta;
+            root[QStringLiteral("results")] = results;
+            return QJsonDocument(root);
+        }
+
+    private:
+        static QString fullName(const QString &name, qint64 param)
+        {
+            return param >= 0 ? QStringLiteral("%1/%2").arg(name).arg(param) : name;
+        }
+
+        qint64 m_minMs;
+        QString m_filter;
+        std::vector<BenchResult> m_results;
+        QJsonObject m_notes;
+    };
+
+    Protocol::HeaderConfig reportHeader()
+    {
+        Protocol::HeaderConfig hc;
+        hc.checkMethod = 1;
+        return hc;
+    }
+
+    // 以雷达为圆心、量程内均匀分布的一条航迹
+    TrackMessage makeTrack(quint16 id, std::mt19937 &rng, float maxRange)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        TrackMessage m;
+        m.insValid = true;
+        m.radarLon = 116.3975;
+        m.radarLat = 39.9087;
+        m.radarAlt = 50.0f;
+        TrackInfo &ti = m.info;
+        ti.trackId = id;
+        ti.distance = 0.95f * maxRange * unit(rng);
+        ti.azimuth = 359.0f * unit(rng);
+        ti.elevation = 3.0f;
+        ti.speed = 30.0f * unit(rng);
+        ti.course = 359.0f * unit(rng);
+        ti.tgtLon = m.radarLon + 0.01 * unit(rng);
+        ti.tgtLat = m.radarLat + 0.01 * unit(rng);
+        ti.targetType = quint8(rng() % 6);
+        ti.targetSize = quint8(rng() % 4);
+        ti.trackType = 2;
+        ti.quality = 90;
+        ti.rawDistance = ti.distance;
+        ti.rawAzimuth = ti.azimuth;
+        ti.rawElevation = ti.elevation;
+        return m;
+    }
+
+    void benchParsers(BenchRunner &bench)
+    {
+        std::mt19937 rng(1);
+        const Protocol::HeaderConfig hc = reportHeader();
+        const QByteArray track = Protocol::buildTrackPacket(hc, makeTrack(1, rng, 5000.0f), 0, 1);
+        TrackMessage msg;
+        bench.run(QStringLiteral("parse/track"), -1, track.size(), [&]
+                  { g_sink = g_sink + quint64(TrackParser::parseLittleEndian(track, msg)) + msg.info.trackId; });
+
+        RadarStatus st;
+        st.detectRange = 5000;
+        st.longitude = 116.3975;
+        st.latitude = 39.9087;
+        const QByteArray status = Protocol::buildStatusPacket(hc, st, 0, 1);
+        RadarStatus out;
+        bench.run(QStringLiteral("parse/status"), -1, status.size(), [&]
+                  { g_sink = g_sink + quint64(RadarStatusParser::parseLittleEndian(status, out)) + out.detectRange; });
+
+        // 批量航迹整帧解码 + 整批范围校验（参数为每帧航迹数）
+        for (int n : {1, 20})
+        {
+            TrackBatch src;
+            for (int i = 0; i < n; ++i)
+                src.append(makeTrack(quint16(i + 1), rng, 5000.0f).info);
+            const QByteArray frame = Protocol::buildTrackBatchPacket(hc, src, 0, n, 0, 1);
+            TrackBatch batch;
+            bench.run(QStringLiteral("parse/track_batch"), n, frame.size(), [&]
+                      {
+                TrackBatchView view;
+                TrackBatchView::fromBytes(frame, view);
+                batch.clear();
+                view.appendTo(batch);
+                g_sink = g_sink + quint64(batch.removeInvalid()) + quint64(batch.size()); });
+        }
+    }
+
+    void benchChecksums(BenchRunner &bench)
+    {
+        // 命令帧、航迹帧、状态帧、以太网MTU、大块
+        std::mt19937 rng(2);
+        for (int n : {49, 142, 200, 1472, 65536})
+        {
+            QByteArray buf(n, Qt::Uninitialized);
+            for (char &c : buf)
+                c = char(rng());
+            bench.run(QStringLiteral("checksum/sum16"), n, n, [&]
+                      { g_sink = g_sink + Protocol::checksumSum16(buf); });
+            bench.run(QStringLiteral("checksum/crc16"), n, n, [&]
+                      { g_sink = g_sink + Protocol::checksumCrc16IBM(buf); });
+        }
+    }
+
+    void benchBuilders(BenchRunner &bench)
+    {
+        Protocol::HeaderConfig hc;
+        hc.checkMethod = 1;
+        hc.msgIdRadar = ProtocolIds::CmdSearch;
+        bench.run(QStringLiteral("build/search"), -1, 51, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildSearchTaskPacket(hc).size()); });
+        hc.msgIdRadar = ProtocolIds::CmdStandby;
+        bench.run(QStringLiteral("build/standby"), -1, 51, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildStandbyTaskPacket(hc).size()); });
+        hc.msgIdRadar = ProtocolIds::CmdDeploy;
+        bench.run(QStringLiteral("build/deploy"), -1, 51, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildDeployTaskPacket(hc, 0x01).size()); });
+        hc.msgIdRadar = ProtocolIds::HitReport;
+        bench.run(QStringLiteral("build/hit"), -1, 51, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildHitPacket(hc, 7).size()); });
+
+        std::mt19937 rng(3);
+        const Protocol::HeaderConfig rc = reportHeader();
+        const TrackMessage track = makeTrack(1, rng, 5000.0f);
+        quint32 count = 0;
+        bench.run(QStringLiteral("build/track"), -1, TrackMessageView::Size, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildTrackPacket(rc, track, 0, ++count, 1).size()); });
+        RadarStatus st;
+        bench.run(QStringLiteral("build/status"), -1, RadarStatusView::Size, [&]
+                  { g_sink = g_sink + quint64(Protocol::buildStatusPacket(rc, st, 0, ++count, 1).size()); });
+        TrackBatch batch;
+        for (int i = 0; i < 20; ++i)
+            batch.append(makeTrack(quint16(i + 1), rng, 5000.0f).info);
+        bench.run(QStringLiteral("build/track_batch"), 20, TrackBatchView::frameSize(20), [&]
+                  {
+            const QByteArray p = Protocol::buildTrackBatchPacket(rc, batch, 0, 20, 0, ++count, 1);
+            g_sink = g_sink + quint64(p.size()); });
+    }
+
+    // 航迹表：N 条活动航迹下的查找，以及“一条消失 + 一条新出现”的删除/插入，耗时应与 N 无关
+    void benchTrackTable(BenchRunner &bench)
+    {
+        struct Entry
+        {
+            float distance{};
+            qint64 ms{};
+        };
+        for (int n : {10, 100, 1000, 10000})
+        {
+            TrackTable<Entry> table;
+            for (int i = 0; i < n; ++i)
+                table.insert(quint16(i + 1)).distance = float(i);
+            quint16 next = 0;
+            bench.run(QStringLiteral("table/update"), n, 0, [&]
+                      {
+                next = next >= n ? quint16(1) : quint16(next + 1);
+                Entry *e = table.find(next);
+                e->ms += 1;
+                g_sink = g_sink + quint64(e->ms); });
+            // 批号 [oldest, oldest+n) 为活动航迹，删除最旧的、插入新的一条
+            quint16 oldest = 1;
+            bench.run(QStringLiteral("table/insert_remove"), n, 0, [&]
+                      {
+                table.remove(oldest);
+                table.insert(quint16(oldest + n)).ms = 1;
+                ++oldest; // quint16 回绕，活动批号区间随之平移
+                g_sink = g_sink + quint64(table.size()); });
+        }
+    }
+
+    // 航迹模型（无界面）：每次操作把 N 条航迹整批应用一次并发布一次变化；以及空闲时的过期处理
+    void benchTrackModel(BenchRunner &bench)
+    {
+        std::mt19937 rng(5);
+        for (int n : {100, 1000, 10000})
+        {
+            TrackBatch batch;
+            for (int i = 0; i < n; ++i)
+                batch.append(makeTrack(quint16(i + 1), rng, 5000.0f).info);
+            TrackModel model;
+            model.applyBatch(batch);
+            bench.run(QStringLiteral("model/apply_batch"), n, 0, [&]
+                      {
+                model.applyBatch(batch);
+                g_sink = g_sink + quint64(model.size()); });
+            // 无到期航迹时的过期处理：时间轮只推进经过的 tick，与 N 无关（原先每秒遍历全部航迹）
+            bench.run(QStringLiteral("model/expire_idle"), n, 0, [&]
+                      {
+                model.expire(QDateTime::currentMSecsSinceEpoch());
+                g_sink = g_sink + quint64(model.size()); });
+        }
+    }
+
+    // 威胁评分：改权重后整表重算，以及一帧内只有少量航迹（N/16）输入变化时的增量重算
+    void benchThreatScorer(BenchRunner &bench)
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> dist(0.0f, 5000.0f), speed(0.0f, 150.0f);
+        for (int n : {100, 1000, 10000})
+        {
+            ThreatScorer scorer;
+            for (int i = 0; i < n; ++i)
+                scorer.set(quint16(i + 1), dist(rng), speed(rng), quint8(i % 6));
+            scorer.rescore();
+            ThreatWeights w;
+            bench.run(QStringLiteral("threat/rescore_all"), n, 0, [&]
+                      {
+                w.distance = w.distance == 0.3f ? 0.31f : 0.3f;
+                scorer.setWeights(w);
+                g_sink = g_sink + quint64(scorer.rescore()); });
+            const int moved = qMax(1, n / 16);
+            quint16 next = 1;
+            bench.run(QStringLiteral("threat/rescore_dirty"), n, 0, [&]
+                      {
+                for (int i = 0; i < moved; ++i)
+                {
+                    scorer.set(next, dist(rng), speed(rng), quint8(next % 6));
+                    next = next >= n ? quint16(1) : quint16(next + 1);
+                }
+                g_sink = g_sink + quint64(scorer.rescore()); });
+        }
+    }
+
+    // 网格索引：点选（10px 容差，约 100m）、离雷达最近 10 条、1km 范围查询，一条航迹移动后的重新归档，
+    // 以及模型按预测位置的点选
+    void benchTrackGrid(BenchRunner &bench)
+    {
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<float> coord(-3500.0f, 3500.0f);
+        for (int n : {1000, 10000})
+        {
+            TrackGrid grid;
+            for (int i = 0; i < n; ++i)
+                grid.update(quint16(i + 1), QPointF(coord(rng), coord(rng)));
+            std::vector<QPointF> probes(1024);
+            for (QPointF &q : probes)
+                q = QPointF(coord(rng), coord(rng));
+            std::size_t k = 0;
+            bench.run(QStringLiteral("grid/pick"), n, 0, [&]
+                      {
+                k = (k + 1) & (probes.size() - 1);
+                g_sink = g_sink + quint64(grid.nearest(probes[k], 100.0f) + 1); });
+            QVector<quint16> out;
+            bench.run(QStringLiteral("grid/knn_radar"), n, 0, [&]
+                      {
+                out.clear();
+                g_sink = g_sink + quint64(grid.nearestK(QPointF(0, 0), 10, &out)); });
+            bench.run(QStringLiteral("grid/radius"), n, 0, [&]
+                      {
+                k = (k + 1) & (probes.size() - 1);
+                out.clear();
+                g_sink = g_sink + quint64(grid.withinRadius(probes[k], 1000.0f, &out)); });
+            quint16 next = 1;
+            bench.run(QStringLiteral("grid/update"), n, 0, [&]
+                      {
+                k = (k + 1) & (probes.size() - 1);
+                grid.update(next, probes[k]);
+                next = next >= n ? quint16(1) : quint16(next + 1);
+                g_sink = g_sink + quint64(grid.size()); });
+
+            // 模型点选：按显示时刻（上次更新后 1s）的预测位置比较，查询半径放宽各航迹的最大外推距离
+            TrackModel model;
+            const qint64 t0 = QDateTime::currentMSecsSinceEpoch();
+            for (qint64 ms : {t0, t0 + 1000})
+                for (int i = 0; i < n; ++i)
+                    model.applyTrackAt(makeTrack(quint16(i + 1), rng, 5000.0f), ms);
+            bench.run(QStringLiteral("grid/pick_predicted"), n, 0, [&]
+                      {
+                k = (k + 1) & (probes.size() - 1);
+                g_sink = g_sink + quint64(model.pick(probes[k], 100.0f, t0 + 2000) + 1); });
+        }
+    }
+
+    // 轨迹抽稀：1000 条航迹（一半直线、一半缓慢转弯，带 ±1.5m 量测噪声）每操作整批更新一次，
+    // 比较逐点保存、5m 容差抽稀、逐点保存但限 8MB 预算（超出即缩减轨迹）的单批耗时，
+    // 并记录 600 批后的压缩比、每航迹内存与缓冲池占用
+    void benchTrails(BenchRunner &bench)
+    {
+        constexpr int n = 1000;
+        struct Mover
+        {
+            float x, y, heading, speed, turn;
+        };
+        struct Config
+        {
+            float tolerance;
+            qint64 budget;
+            const char *tag;
+        };
+        for (const Config &cfg : {Config{0.0f, 0, "raw"}, Config{5.0f, 0, "simplified"}, Config{0.0f, 8ll << 20, "budget"}})
+        {
+            const float tolerance = cfg.tolerance;
+            std::mt19937 rng(17);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            std::vector<Mover> movers(n);
+            for (int i = 0; i < n; ++i)
+            {
+                const float bearing = 6.2832f * unit(rng), r = 500.0f + 1500.0f * unit(rng);
+                movers[std::size_t(i)] = {r * std::sin(bearing), r * std::cos(bearing), 6.2832f * unit(rng),
+                                          30.0f + 50.0f * unit(rng), i % 2 ? 0.0f : 0.02f};
+            }
+            TrackModel model;
+            model.setTrailTolerance(tolerance);
+            model.setTrailMemoryBudget(cfg.budget);
+            TrackBatch batch;
+            auto step = [&]
+            {
+                batch.clear();
+                for (int i = 0; i < n; ++i)
+                {
+                    Mover &m = movers[std::size_t(i)];
+                    m.heading += m.turn;
+                    m.x += m.speed * std::sin(m.heading);
+                    m.y += m.speed * std::cos(m.heading);
+                    if (std::hypot(m.x, m.y) > 4500.0f)
+                        m.heading += 3.1416f; // 掉头留在量程内
+                    TrackInfo ti;
+                    ti.trackId = quint16(i + 1);
+                    const float x = m.x + 3.0f * (unit(rng) - 0.5f), y = m.y + 3.0f * (unit(rng) - 0.5f);
+                    ti.distance = std::hypot(x, y);
+                    ti.azimuth = qRadiansToDegrees(std::atan2(x, y));
+                    if (ti.azimuth < 0.0f)
+                        ti.azimuth += 360.0f;
+                    ti.speed = m.speed;
+                    batch.append(ti);
+                }
+                model.applyBatch(batch);
+            };
+            for (int i = 0; i < 600; ++i)
+                step();
+            const TrailStats s = model.trailStats();
+            const QString tag = QLatin1String(cfg.tag);
+            bench.note(QStringLiteral("trail_%1_compression").arg(tag), s.compression());
+            bench.note(QStringLiteral("trail_%1_bytes_per_track").arg(tag), double(s.bytesPerTrack()));
+            bench.note(QStringLiteral("trail_%1_pool_peak_bytes").arg(tag), double(s.poolPeakBytes));
+            bench.note(QStringLiteral("trail_%1_shed_points").arg(tag), double(s.shedPoints));
+            bench.run(QStringLiteral("trail/append_%1").arg(tag), n, 0, [&]
+                      {
+                step();
+                g_sink = g_sink + quint64(model.size()); });
+        }
+    }
+
+    // 航迹滤波：每操作把 N 条航迹各更新一次（相当于一个雷达周期），整表按显示时刻预测一次（每帧），以及单次拦截解算
+    void benchTrackFilter(BenchRunner &bench)
+    {
+        std::mt19937 rng(19);
+        std::uniform_real_distribution<float> coord(-4000.0f, 4000.0f), noise(-5.0f, 5.0f);
+        for (int n : {1000, 10000})
+        {
+            TrackFilter filter;
+            std::vector<QPointF> pos(std::size_t(n)), vel(std::size_t(n));
+            for (int i = 0; i < n; ++i)
+            {
+                pos[std::size_t(i)] = QPointF(coord(rng), coord(rng));
+                vel[std::size_t(i)] = QPointF(noise(rng) * 10.0f, noise(rng) * 10.0f);
+                filter.update(quint16(i + 1), pos[std::size_t(i)], 0, false);
+            }
+            qint64 ms = 0;
+            bench.run(QStringLiteral("filter/update"), n, 0, [&]
+                      {
+                ms += 1000;
+                for (int i = 0; i < n; ++i)
+                {
+                    QPointF &p = pos[std::size_t(i)];
+                    p += vel[std::size_t(i)];
+                    filter.update(quint16(i + 1), QPointF(p.x() + noise(rng), p.y() + noise(rng)), ms, false);
+                }
+                g_sink = g_sink + quint64(filter.size()); });
+            std::vector<float> x, y;
+            bench.run(QStringLiteral("filter/predict_all"), n, 0, [&]
+                      {
+                filter.predictAll(ms + 500, &x, &y);
+                g_sink = g_sink + quint64(x.size()); });
+            quint16 next = 1;
+            bench.run(QStringLiteral("filter/intercept"), n, 0, [&]
+                      {
+                QPointF aim;
+                g_sink = g_sink + quint64(filter.intercept(next, ms, QPointF(0, 0), 1500.0f, &aim));
+                next = next >= n ? quint16(1) : quint16(next + 1); });
+        }
+    }
+
+    // 每条航迹一个航迹报文，批号 1..tracks
+    std::vector<QByteArray> makeScopeFrames(int tracks, std::mt19937 &rng)
+    {
+        const Protocol::HeaderConfig hc = reportHeader();
+        std::vector<QByteArray> frames;
+        frames.reserve(std::size_t(tracks));
+        for (int i = 0; i < tracks; ++i)
+            frames.push_back(Protocol::buildTrackPacket(hc, makeTrack(quint16(i + 1), rng, 5000.0f), 0, quint32(i)));
+        return frames;
+    }
+
+    // 各航迹先各报告 warmPoints 次，使显示器处于 N 条活动航迹、每条若干轨迹点的稳定状态
+    std::unique_ptr<RadarScopeWidget> makeScope(const std::vector<QByteArray> &frames, int warmPoints)
+    {
+        std::unique_ptr<RadarScopeWidget> scope(new RadarScopeWidget);
+        scope->resize(800, 800);
+        scope->setMaxRangeMeters(5000.0f);
+        scope->setShowNotices(false);
+        for (int k = 0; k < warmPoints; ++k)
+            for (const QByteArray &f : frames)
+                scope->onTrackDatagram(f);
+        return scope;
+    }
+
+    void benchScope(BenchRunner &bench)
+    {
+        std::mt19937 rng(4);
+        for (int n : {10, 100, 1000, 10000})
+        {
+            const std::vector<QByteArray> frames = makeScopeFrames(n, rng);
+            std::unique_ptr<RadarScopeWidget> scope = makeScope(frames, 1);
+            // 轮流报告各航迹：每次都是对已有航迹的更新（查找 + 追加轨迹点）
+            std::size_t next = 0;
+            bench.run(QStringLiteral("scope/track_datagram"), n, TrackMessageView::Size, [&]
+                      {
+                scope->onTrackDatagram(frames[next]);
+                next = next + 1 == frames.size() ? 0 : next + 1; });
+        }
+
+        // 离屏绘制：N 条航迹、每条 50 个轨迹点，渲染到 800x800 的 QImage
+        for (int n : {10, 100, 1000, 10000})
+        {
+            const std::vector<QByteArray> frames = makeScopeFrames(n, rng);
+            std::unique_ptr<RadarScopeWidget> scope = makeScope(frames, 50);
+            QImage image(scope->size(), QImage::Format_ARGB32_Premultiplied);
+            bench.run(QStringLiteral("scope/paint"), n, 0, [&]
+                      {
+                scope->render(&image);
+                g_sink = g_sink + image.constBits()[0]; });
+        }
+
+        // 轨迹分档绘制：1000 条航迹（每轮随机位置），每条 10/50/200 点 × 1/8/32 档；
+        // 轨迹点用合成时刻均匀铺满1小时的保留期（各档都有线段，不依赖真实时钟），绘制时刻的推移相对一档的宽度可忽略；
+        // 绘制调用数为档数，与线段数无关（参数为每帧线段数）
+        for (int points : {10, 50, 200})
+        {
+            bool wanted = false;
+            for (int buckets : {1, 8, 32})
+                wanted = wanted || bench.enabled(QStringLiteral("scope/paint_trails_b%1").arg(buckets), 1000 * points);
+            if (!wanted)
+                continue; // 构造 1000×points 个点较慢，被 --filter 排除时跳过
+            constexpr qint64 KeepMs = 3600 * 1000;
+            std::unique_ptr<RadarScopeWidget> scope = makeScope({}, 0);
+            TrackModel *model = scope->trackModel();
+            model->setTrailRetentionMs(KeepMs);
+            model->setTrackTimeoutMs(2 * KeepMs);
+            model->setCoastTimeoutMs(2 * KeepMs);
+            model->setTrailTolerance(0.0f); // 逐点保留，线段数确定
+            const qint64 end = QDateTime::currentMSecsSinceEpoch();
+            for (int k = 0; k < points; ++k)
+            {
+                const qint64 ms = end - KeepMs * (points - 1 - k) / points;
+                for (int i = 0; i < 1000; ++i)
+                    model->applyTrackAt(makeTrack(quint16(i + 1), rng, 5000.0f), ms);
+            }
+            QImage image(scope->size(), QImage::Format_ARGB32_Premultiplied);
+            for (int buckets : {1, 8, 32})
+            {
+                scope->setTrailAlphaBuckets(buckets);
+                bench.run(QStringLiteral("scope/paint_trails_b%1").arg(buckets), 1000 * points, 0, [&]
+                          {
+                    scope->render(&image);
+                    g_sink = g_sink + image.constBits()[0]; });
+            }
+        }
+
+        // 后台绘制：GUI 线程每帧只贴图（scope/frame_threaded_gui，应与航迹数无关）；
+        // 先跑1s事件循环让绘制时钟出帧，其间每轮送入约 1/50 航迹的报文（持续有航迹变化），
+        // tick 里的镜像同步（snapshot）、绘制线程的生成（build）与光栅化（raster）耗时按 renderStats 记入 meta
+        for (int n : {100, 10000})
+        {
+            const std::vector<QByteArray> frames = makeScopeFrames(n, rng);
+            std::unique_ptr<RadarScopeWidget> scope = makeScope(frames, 20);
+            scope->resize(1920, 1080);
+            scope->setSearchActive(true);
+            scope->setThreadedRendering(true);
+            const std::size_t perRound = std::size_t(qMax(1, n / 50));
+            std::size_t next = 0;
+            QElapsedTimer warm;
+            warm.start();
+            while (warm.elapsed() < 1000)
+            {
+                for (std::size_t k = 0; k < perRound; ++k)
+                {
+                    scope->onTrackDatagram(frames[next]);
+                    next = next + 1 == frames.size() ? 0 : next + 1;
+                }
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+            }
+            const ScopeRenderStats rs = scope->renderStats();
+            bench.note(QStringLiteral("scope_tick_snapshot_ms_%1").arg(n), rs.snapshot.avgNs / 1e6);
+            bench.note(QStringLiteral("scope_tick_snapshot_max_ms_%1").arg(n), rs.snapshot.maxNs / 1e6);
+            bench.note(QStringLiteral("scope_build_ms_%1").arg(n), rs.build.avgNs / 1e6);
+            bench.note(QStringLiteral("scope_raster_ms_%1").arg(n), rs.raster.avgNs / 1e6);
+            bench.note(QStringLiteral("scope_threaded_frames_%1").arg(n), double(rs.frames));
+            QImage image(scope->size(), QImage::Format_ARGB32_Premultiplied);
+            bench.run(QStringLiteral("scope/frame_threaded_gui"), n, 0, [&]
+                      {
+                scope->render(&image);
+                g_sink = g_sink + image.constBits()[0]; });
+        }
+
+        // 整帧耗时（扫描线开、100 条航迹）：1080p 与 4K，静态底图每帧重画 vs 缓存位图
+        {
+            const std::vector<QByteArray> frames = makeScopeFrames(100, rng);
+            std::unique_ptr<RadarScopeWidget> scope = makeScope(frames, 50);
+            scope->setSearchActive(true);
+            for (const QSize &sz : {QSize(1920, 1080), QSize(3840, 2160)})
+            {
+                scope->resize(sz);
+                QImage image(sz, QImage::Format_ARGB32_Premultiplied);
+                const QString res = sz.height() == 1080 ? QStringLiteral("1080p") : QStringLiteral("4k");
+                for (bool cached : {false, true})
+                {
+                    scope->setBackgroundCached(cached);
+                    bench.run(QStringLiteral("scope/frame_%1_%2").arg(res, cached ? QStringLiteral("cached") : QStringLiteral("redraw")), 100, 0, [&]
+                              {
+                        scope->render(&image);
+                        g_sink = g_sink + image.constBits()[0]; });
+                }
+            }
+        }
+
+        // 扫描余辉：每个 tick 盖新扫过的楔形（参数为楔形角度），累计衰减够一档时整盘压暗一次（均摊在各 tick 里），
+        // 以及整块贴到整帧（scope/phosphor_draw，每帧一次）；盘面取 1080p/4K 窗口下的大小
+        for (const QSize &sz : {QSize(1920, 1080), QSize(3840, 2160)})
+        {
+            const QString res = sz.height() == 1080 ? QStringLiteral("1080p") : QStringLiteral("4k");
+            const qreal d = 0.96 * sz.height();
+            const QRectF circle((sz.width() - d) / 2, (sz.height() - d) / 2, d, d);
+            PhosphorLayer phosphor;
+            phosphor.setGeometry(circle, 1.0);
+            std::uniform_real_distribution<float> az(0.0f, 360.0f), rr(0.0f, float(d / 2));
+            for (int wedgeDeg : {1, 4, 16})
+            {
+                float angle = 0.0f;
+                bench.run(QStringLiteral("scope/phosphor_stamp_%1").arg(res), wedgeDeg, 0, [&]
+                          {
+                    // 楔形里平均约 100 个目标/圈 × 楔形占比
+                    QVector<QPointF> blips;
+                    for (int k = 0; k < qMax(1, 100 * wedgeDeg / 360); ++k)
+                    {
+                        const float a = qDegreesToRadians(angle + az(rng) * float(wedgeDeg) / 360.0f);
+                        const float r = rr(rng);
+                        blips.append(circle.center() + QPointF(r * qSin(a), -r * qCos(a)));
+                    }
+                    phosphor.stamp(angle, angle + float(wedgeDeg), blips, 60.0f);
+                    angle = std::fmod(angle + float(wedgeDeg), 360.0f); });
+            }
+            QImage image(sz, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::black);
+            bench.run(QStringLiteral("scope/phosphor_draw_%1").arg(res), 1, 0, [&]
+                      {
+                QPainter p(&image);
+                phosphor.draw(p);
+                g_sink = g_sink + image.constBits()[0]; });
+
+            // 每帧余辉的全部开销（60 度/秒、60 帧/秒即每帧 1 度，每 3 帧亮起一个目标）：盖楔形、均摊的压暗，
+            // 再加上底图与余辉的贴图——参数 0 为贴底图后把余辉整盘半透明叠加（此前每帧的做法，不缓存底图时仍是这样），
+            // 1 为贴底图与余辉的合成图（只重算本帧楔形与目标的区域，压暗那帧在同一遍里重算整盘）
+            QImage background(sz, QImage::Format_ARGB32_Premultiplied);
+            {
+                QPainter bp(&background);
+                bp.setRenderHint(QPainter::Antialiasing, true);
+                ScopeRenderer::drawStaticLayer(bp, QSizeF(sz), 5000.0f, QColor(30, 30, 30));
+            }
+            for (int composited : {0, 1})
+            {
+                phosphor.clear();
+                float angle = 0.0f;
+                int tick = 0;
+                bench.run(QStringLiteral("scope/phosphor_frame_%1").arg(res), composited, 0, [&]
+                          {
+                    QVector<QPointF> blips;
+                    if (++tick % 3 == 0)
+                    {
+                        const float a = qDegreesToRadians(angle + 0.5f);
+                        const float r = rr(rng);
+                        blips.append(circle.center() + QPointF(r * qSin(a), -r * qCos(a)));
+                    }
+                    phosphor.stamp(angle, angle + 1.0f, blips, 60.0f);
+                    angle = std::fmod(angle + 1.0f, 360.0f);
+                    QPainter p(&image);
+                    p.setCompositionMode(QPainter::CompositionMode_Source);
+                    if (composited)
+                    {
+                        phosphor.drawComposited(p, background);
+                    }
+                    else
+                    {
+                        p.drawImage(QPointF(0, 0), background);
+                        p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+                        phosphor.draw(p);
+                    }
+                    g_sink = g_sink + image.constBits()[0]; });
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // 无显示环境下也能运行（离屏绘制）
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("radar_bench"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Hot-path benchmarks, results as JSON"));
+    parser.addHelpOption();
+    const QCommandLineOption minMsOpt(QStringLiteral("min-ms"), QStringLiteral("Minimum timed duration per case."),
+                                      QStringLiteral("ms"), QStringLiteral("200"));
+    const QCommandLineOption filterOpt(QStringLiteral("filter"), QStringLiteral("Only run cases containing text."),
+                                       QStringLiteral("text"));
+    const QCommandLineOption outOpt(QStringLiteral("out"), QStringLiteral("Write JSON to file instead of stdout."),
+                                    QStringLiteral("file"));
+    parser.addOptions({minMsOpt, filterOpt, outOpt});
+    parser.process(app);
+
+    BenchRunner bench(qMax<qint64>(1, parser.value(minMsOpt).toLongLong()), parser.value(filterOpt));
+    benchParsers(bench);
+    benchChecksums(bench);
+    benchBuilders(bench);
+    benchTrackTable(bench);
+    benchTrackModel(bench);
+    benchThreatScorer(bench);
+    benchTrackGrid(bench);
+    benchTrails(bench);
+    benchTrackFilter(bench);
+    benchScope(bench);
+
+    const QByteArray json = bench.toJson().toJson(QJsonDocument::Indented);
+    if (parser.isSet(outOpt))
+    {
+        QFile f(parser.value(outOpt));
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            std::fprintf(stderr, "cannot write %s\n", qPrintable(parser.value(outOpt)));
+            return 1;
+        }
+        f.write(json);
+    }
+    else
+    {
+        std::fwrite(json.constData(), 1, std::size_t(json.size()), stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,410 @@
+// RadarSim.cpp
+// 雷达模拟器 / 负载发生器：
+// - 按场景发送雷达状态报文（0x3002）与航迹报文（0x3001；--batch N>1 时为批量航迹报文 0x3003），
+//   字节布局与本机解析器一致；
+// - 发送速率 1 ~ 100k+ 条航迹/秒，按时间均匀发出（1ms 节拍，落后时不补发突发）；
+// - 响应本机发来的待机/搜索/展开撤收/命中（0x4444）命令，并立即回报一次状态。
+// 用法示例：
+//   radar_sim --targets 50 --path swarm
+//   radar_sim --scenario load.scn --rate 100000 --batch 20
+// 场景脚本格式见 SimScenario.h。
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QDebug>
+#include "SimScenario.h"
+#include "Protocol.h"
+#include "Checksum.h"
+#include "MessageIds.h"
+#include "RadarStatus.h"
+#include "TrackBatch.h"
+
+namespace
+{
+    struct SimOptions
+    {
+        QHostAddress host{QHostAddress::LocalHost};
+        quint16 port = 6553;       // 本机采集端口
+        quint16 listenPort = 6280; // 本机发送命令的目标端口
+        double rate = 100.0;       // 航迹条数/秒
+        int batch = 1;             // 每帧航迹数，1 为单航迹报文
+        double statusHz = 1.0;
+        quint8 checkMethod = 1;
+        bool startSearching = true;
+    };
+
+    class RadarSim
+    {
+    public:
+        RadarSim(SimScenario &scenario, const SimOptions &opt)
+            : m_scenario(scenario),
+              m_opt(opt)
+        {
+            m_header.deviceModel = 6000;
+            m_header.checkMethod = opt.checkMethod;
+            m_searching = opt.startSearching;
+        }
+
+        bool start()
+        {
+            if (!m_socket.bind(QHostAddress::AnyIPv4, m_opt.listenPort,
+                               QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+            {
+                qWarning() << "Failed to bind UDP on" << m_opt.listenPort << m_socket.errorString();
+                return false;
+            }
+            m_socket.setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, 4 << 20);
+            QObject::connect(&m_socket, &QUdpSocket::readyRead, [this]()
+                             { readCommands(); });
+
+            m_clock.start();
+            restartRate();
+            m_tick.setTimerType(Qt::PreciseTimer);
+            m_tick.setInterval(1);
+            QObject::connect(&m_tick, &QTimer::timeout, [this]()
+                             { tick(); });
+            m_tick.start();
+
+            m_statusTimer.setInterval(int(1000.0 / qMax(0.01, m_opt.statusHz)));
+            QObject::connect(&m_statusTimer, &QTimer::timeout, [this]()
+                             { sendStatus(); });
+            m_statusTimer.start();
+            sendStatus();
+
+            m_reportTimer.setInterval(1000);
+            QObject::connect(&m_reportTimer, &QTimer::timeout, [this]()
+                             { report(); });
+            m_reportTimer.start();
+            return true;
+        }
+
+        void printTotals() const
+        {
+            const double secs = m_clock.elapsed() / 1000.0;
+            qInfo().nospace() << "Sent " << m_totalTracks << " tracks in " << m_totalFrames << " frames ("
+                              << m_totalBytes << " bytes) over " << secs << " s, send errors " << m_sendErrors;
+        }
+
+    private:
+        qint64 nowMs() const { return m_clock.elapsed(); }
+
+        // 速率基准重新从当前时刻开始（开始搜索时），避免把待机期间“欠下”的航迹一次补发
+        void restartRate()
+        {
+            m_rateOriginNs = m_clock.nsecsElapsed();
+            m_rateSent = 0;
+        }
+
+        void send(const QByteArray &packet, int tracks)
+        {
+            if (m_socket.writeDatagram(packet, m_opt.host, m_opt.port) < 0)
+            {
+                ++m_sendErrors;
+                return;
+            }
+            m_totalTracks += quint64(tracks);
+            ++m_totalFrames;
+            m_totalBytes += quint64(packet.size());
+        }
+
+        void tick()
+        {
+            if (!m_searching || m_scenario.targetCount() == 0)
+                return;
+            const qint64 elapsedNs = m_clock.nsecsElapsed() - m_rateOriginNs;
+            qint64 due = qint64(m_opt.rate * double(elapsedNs) / 1e9) - m_rateSent;
+            // 进程被调度延迟时最多补 100ms 的量，其余直接跳过
+            const qint64 maxBurst = qMax<qint64>(1, qint64(m_opt.rate / 10.0));
+            if (due > maxBurst)
+            {
+                m_rateSent += due - maxBurst;
+                due = maxBurst;
+            }
+            if (due <= 0)
+                return;
+
+            const qint64 simMs = nowMs();
+            const quint64 utcMs = quint64(QDateTime::currentMSecsSinceEpoch());
+            const int n = m_scenario.targetCount();
+            TrackMessage msg;
+            msg.insValid = true;
+            msg.radarLon = m_scenario.radarLon();
+            msg.radarLat = m_scenario.radarLat();
+            msg.radarAlt = m_scenario.radarAlt();
+            m_batch.clear();
+            m_batch.insValid = true;
+            m_batch.radarLon = msg.radarLon;
+            m_batch.radarLat = msg.radarLat;
+            m_batch.radarAlt = msg.radarAlt;
+
+            // 按目标表轮转报告；被命中未重生的目标跳过
+            int misses = 0; // 连续跳过的目标数，全部被命中时不空转
+            for (qint64 k = 0; k < due && misses < n;)
+            {
+                const int idx = m_cursor;
+                m_cursor = (m_cursor + 1) % n;
+                if (!m_scenario.report(idx, simMs, msg.info))
+                {
+                    ++misses;
+                    continue;
+                }
+                misses = 0;
+                ++k;
+                ++m_rateSent;
+                if (m_opt.batch <= 1)
+                {
+                    send(Protocol::buildTrackPacket(m_header, msg, m_seq++, ++m_count, utcMs), 1);
+                    continue;
+                }
+                m_batch.append(msg.info);
+                if (m_batch.size() >= m_opt.batch)
+                    flushBatch(utcMs);
+            }
+            if (!m_batch.isEmpty())
+                flushBatch(utcMs);
+        }
+
+        void flushBatch(quint64 utcMs)
+        {
+            send(Protocol::buildTrackBatchPacket(m_header, m_batch, 0, m_batch.size(), m_seq++, ++m_count, utcMs),
+                 m_batch.size());
+            m_batch.clear();
+        }
+
+        void sendStatus()
+        {
+            RadarStatus st;
+            st.workState = m_searching ? 1 : 0; // 0 待机，1 搜索
+            st.detectRange = quint16(qMin(65535.0f, m_scenario.maxRange()));
+            st.insValid = true;
+            st.simOn = true;
+            st.retracted = m_retracted;
+            st.longitude = m_scenario.radarLon();
+            st.latitude = m_scenario.radarLat();
+            st.altitude = m_scenario.radarAlt();
+            st.freqGHz = 15.80f;
+            st.antPowerMode = m_retracted ? 0 : 3;
+            send(Protocol::buildStatusPacket(m_header, st, m_seq++, ++m_count), 0);
+        }
+
+        void readCommands()
+        {
+            while (m_socket.hasPendingDatagrams())
+            {
+                QByteArray d;
+                d.resize(int(qMax<qint64>(0, m_socket.pendingDatagramSize())));
+                const qint64 n = m_socket.readDatagram(d.data(), d.size());
+                if (n < 0)
+                    continue;
+                d.resize(int(n));
+                handleCommand(d);
+            }
+        }
+
+        void handleCommand(const QByteArray &d)
+        {
+            // 配置面板同时发出JSON预览，模拟器只认二进制命令
+            if (d.startsWith('{'))
+                return;
+            Protocol::FrameHeader h;
+            if (!Protocol::parseFrameHeader(d, h) || !h.hasMagic())
+            {
+                qWarning() << "Ignoring" << d.size() << "byte datagram without HRGK header";
+                return;
+            }
+            if (!Checksum::verifyFrame(reinterpret_cast<const uchar *>(d.constData()), std::size_t(d.size()),
+                                       h.checkMethod))
+            {
+                qWarning().noquote() << QStringLiteral("Ignoring command 0x%1 with bad checksum").arg(h.msgIdRadar, 0, 16);
+                return;
+            }
+            const quint8 arg = d.size() > Protocol::FrameHeader::Size ? quint8(d[Protocol::FrameHeader::Size]) : 0;
+            switch (h.msgIdRadar)
+            {
+            case ProtocolIds::CmdStandby:
+                m_searching = false;
+                qInfo() << "Standby";
+                break;
+            case ProtocolIds::CmdSearch:
+                if (m_retracted)
+                {
+                    qInfo() << "Search ignored: radar is retracted";
+                    break;
+                }
+                if (!m_searching)
+                    restartRate();
+                m_searching = true;
+                qInfo() << "Search";
+                break;
+            case ProtocolIds::CmdDeploy:
+                // 0x01 展开，0x00 撤收；撤收后停止搜索
+                m_retracted = arg != 0x01;
+                if (m_retracted)
+                    m_searching = false;
+                qInfo() << (m_retracted ? "Retract" : "Deploy");
+                break;
+            case ProtocolIds::HitReport:
+                // 命中报文只带批号低8位：超过255个目标时低8位相同的目标一起消失
+                qInfo() << "Hit target" << arg << (m_scenario.hit(arg, nowMs()) ? "" : "(no such target)");
+                break;
+            default:
+                qInfo().noquote() << QStringLiteral("Unhandled command 0x%1").arg(h.msgIdRadar, 0, 16);
+                return;
+            }
+            sendStatus(); // 状态变化立即回报
+        }
+
+        void report()
+        {
+            const quint64 tracks = m_totalTracks - m_lastTracks;
+            const quint64 frames = m_totalFrames - m_lastFrames;
+            const quint64 bytes = m_totalBytes - m_lastBytes;
+            m_lastTracks = m_totalTracks;
+            m_lastFrames = m_totalFrames;
+            m_lastBytes = m_totalBytes;
+            qInfo().nospace() << (m_retracted ? "retracted" : m_searching ? "search" : "standby") << ": " << tracks
+                              << " tracks/s, " << frames << " frames/s, " << double(bytes) / 1e6 << " MB/s, send errors "
+                              << m_sendErrors;
+        }
+
+        SimScenario &m_scenario;
+        SimOptions m_opt;
+        Protocol::HeaderConfig m_header;
+        QUdpSocket m_socket;
+        QTimer m_tick;        // 1ms 发送节拍
+        QTimer m_statusTimer; // 周期状态报文
+        QTimer m_reportTimer; // 每秒打印发送速率
+        QElapsedTimer m_clock;
+        TrackBatch m_batch; // 批量模式下本节拍待发的航迹
+
+        bool m_searching{true};
+        bool m_retracted{false};
+        quint8 m_seq{0};
+        quint32 m_count{0};
+        int m_cursor{0};
+        qint64 m_rateOriginNs{0};
+        qint64 m_rateSent{0};
+
+        quint64 m_totalTracks{0};
+        quint64 m_totalFrames{0};
+        quint64 m_totalBytes{0};
+        quint64 m_sendErrors{0};
+        quint64 m_lastTracks{0};
+        quint64 m_lastFrames{0};
+        quint64 m_lastBytes{0};
+    };
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("radar_sim"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Radar simulator / load generator for the radar display"));
+    parser.addHelpOption();
+    const QCommandLineOption hostOpt(QStringLiteral("host"), QStringLiteral("Destination address."),
+                                     QStringLiteral("addr"), QStringLiteral("127.0.0.1"));
+    const QCommandLineOption portOpt(QStringLiteral("port"), QStringLiteral("Destination (display ingest) port."),
+                                     QStringLiteral("port"), QStringLiteral("6553"));
+    const QCommandLineOption listenOpt(QStringLiteral("listen"), QStringLiteral("Port receiving commands."),
+                                       QStringLiteral("port"), QStringLiteral("6280"));
+    const QCommandLineOption scenarioOpt(QStringLiteral("scenario"), QStringLiteral("Scenario script."),
+                                         QStringLiteral("file"));
+    const QCommandLineOption targetsOpt(QStringLiteral("targets"),
+                                        QStringLiteral("Add a group of N targets (default 20 without a scenario)."),
+                                        QStringLiteral("n"));
+    const QCommandLineOption pathOpt(QStringLiteral("path"), QStringLiteral("Path of --targets: straight|turn|swarm."),
+                                     QStringLiteral("path"), QStringLiteral("straight"));
+    const QCommandLineOption speedOpt(QStringLiteral("speed"), QStringLiteral("Speed of --targets (m/s)."),
+                                      QStringLiteral("mps"), QStringLiteral("20"));
+    const QCommandLineOption rangeOpt(QStringLiteral("range"), QStringLiteral("Detection range (m)."),
+                                      QStringLiteral("m"), QStringLiteral("5000"));
+    const QCommandLineOption rateOpt(QStringLiteral("rate"),
+                                     QStringLiteral("Track reports per second (default targets x update-hz)."),
+                                     QStringLiteral("n"));
+    const QCommandLineOption updateOpt(QStringLiteral("update-hz"), QStringLiteral("Reports per target per second."),
+                                       QStringLiteral("hz"), QStringLiteral("10"));
+    const QCommandLineOption batchOpt(QStringLiteral("batch"),
+                                      QStringLiteral("Tracks per frame; > 1 sends 0x3003 batch frames (max 921)."),
+                                      QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption statusOpt(QStringLiteral("status-hz"), QStringLiteral("Status report rate."),
+                                       QStringLiteral("hz"), QStringLiteral("1"));
+    const QCommandLineOption checkOpt(QStringLiteral("check"),
+                                      QStringLiteral("Checksum method: 0 none, 1 sum16, 2 CRC16."),
+                                      QStringLiteral("m"), QStringLiteral("1"));
+    const QCommandLineOption radarOpt(QStringLiteral("radar"), QStringLiteral("Radar position lon,lat,alt."),
+                                      QStringLiteral("pos"), QStringLiteral("116.3975,39.9087,50"));
+    const QCommandLineOption respawnOpt(QStringLiteral("respawn-ms"),
+                                        QStringLiteral("Respawn delay of hit targets, < 0 never."),
+                                        QStringLiteral("ms"), QStringLiteral("5000"));
+    const QCommandLineOption seedOpt(QStringLiteral("seed"), QStringLiteral("Random seed."), QStringLiteral("n"),
+                                     QStringLiteral("1"));
+    const QCommandLineOption durationOpt(QStringLiteral("duration"), QStringLiteral("Exit after N seconds."),
+                                         QStringLiteral("s"));
+    const QCommandLineOption standbyOpt(QStringLiteral("standby"),
+                                        QStringLiteral("Start in standby; wait for a search command."));
+    parser.addOptions({hostOpt, portOpt, listenOpt, scenarioOpt, targetsOpt, pathOpt, speedOpt, rangeOpt, rateOpt,
+                       updateOpt, batchOpt, statusOpt, checkOpt, radarOpt, respawnOpt, seedOpt, durationOpt,
+                       standbyOpt});
+    parser.process(app);
+
+    SimScenario scenario(parser.value(seedOpt).toUInt());
+    const QStringList pos = parser.value(radarOpt).split(QLatin1Char(','));
+    if (pos.size() == 3)
+        scenario.setRadarPosition(pos[0].toDouble(), pos[1].toDouble(), pos[2].toFloat());
+    scenario.setMaxRange(parser.value(rangeOpt).toFloat());
+    scenario.setRespawnMs(parser.value(respawnOpt).toLongLong());
+
+    QString error;
+    if (parser.isSet(scenarioOpt) && !scenario.load(parser.value(scenarioOpt), &error))
+    {
+        qCritical().noquote() << error;
+        return 1;
+    }
+    if (parser.isSet(targetsOpt) || !parser.isSet(scenarioOpt))
+    {
+        const QString count = parser.isSet(targetsOpt) ? parser.value(targetsOpt) : QStringLiteral("20");
+        const QString line = QStringLiteral("%1 %2 speed=%3").arg(parser.value(pathOpt), count, parser.value(speedOpt));
+        if (!scenario.addGroupLine(line, &error))
+        {
+            qCritical().noquote() << error;
+            return 1;
+        }
+    }
+
+    SimOptions opt;
+    opt.host = QHostAddress(parser.value(hostOpt));
+    opt.port = quint16(parser.value(portOpt).toUInt());
+    opt.listenPort = quint16(parser.value(listenOpt).toUInt());
+    opt.rate = parser.isSet(rateOpt) ? parser.value(rateOpt).toDouble()
+                                     : scenario.targetCount() * parser.value(updateOpt).toDouble();
+    opt.rate = qMax(1.0, opt.rate);
+    opt.batch = qMax(1, parser.value(batchOpt).toInt());
+    opt.statusHz = parser.value(statusOpt).toDouble();
+    opt.checkMethod = quint8(parser.value(checkOpt).toUInt());
+    opt.startSearching = !parser.isSet(standbyOpt);
+    // 一帧须放得进一个 UDP 数据报（显示端的接收缓冲槽也按此大小）
+    if (opt.batch > TrackBatchView::MaxCount)
+    {
+        qWarning() << "--batch" << opt.batch << "does not fit one UDP datagram; clamped to" << TrackBatchView::MaxCount
+                   << "(" << TrackBatchView::frameSize(TrackBatchView::MaxCount) << "bytes)";
+        opt.batch = TrackBatchView::MaxCount;
+    }
+
+    qInfo().nospace() << "Simulating " << scenario.targetCount() << " targets, " << opt.rate << " tracks/s"
+                      << (opt.batch > 1 ? QStringLiteral(" in batches of %1").arg(opt.batch) : QString()) << " -> "
+                      << opt.host.toString() << ":" << opt.port << ", commands on " << opt.listenPort;
+
+    RadarSim sim(scenario, opt);
+    if (!sim.start())
+        return 1;
+    if (parser.isSet(durationOpt))
+        QTimer::singleShot(int(parser.value(durationOpt).toDouble() * 1000), &app, &QCoreApplication::quit);
+    const int rc = app.exec();
+    sim.printTotals();
+    return rc;
+}
@@ -0,0 +1,276 @@
+// SimScenario.cpp
+#include "SimScenario.h"
+#include <QFile>
+#include <QStringList>
+#include <cmath>
+
+namespace
+{
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double MetersPerDegLat = 111320.0;
+    constexpr float SwarmWeaveDeg = 15.0f;      // 集群成员蛇形摆动幅度
+    constexpr double SwarmWeavePeriodMs = 8000; // 摆动周期
+
+    inline double deg2rad(double d) { return d * Pi / 180.0; }
+    inline double rad2deg(double r) { return r * 180.0 / Pi; }
+    inline float wrap360(double d)
+    {
+        d = std::fmod(d, 360.0);
+        return float(d < 0 ? d + 360.0 : d);
+    }
+} // namespace
+
+SimScenario::SimScenario(quint32 seed)
+    : m_rng(seed)
+{
+    setRadarPosition(m_radarLon, m_radarLat, m_radarAlt);
+}
+
+void SimScenario::setRadarPosition(double lon, double lat, float alt)
+{
+    m_radarLon = lon;
+    m_radarLat = lat;
+    m_radarAlt = alt;
+    // 量程只有数公里，局部平面近似足够
+    m_metersPerDegLon = MetersPerDegLat * std::cos(deg2rad(lat));
+}
+
+bool SimScenario::load(const QString &path, QString *error)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        if (error)
+            *error = QStringLiteral("cannot open %1").arg(path);
+        return false;
+    }
+    int lineNo = 0;
+    while (!f.atEnd())
+    {
+        ++lineNo;
+        QString line = QString::fromUtf8(f.readLine());
+        const int hash = line.indexOf(QLatin1Char('#'));
+        if (hash >= 0)
+            line.truncate(hash);
+        if (line.trimmed().isEmpty())
+            continue;
+        QString err;
+        if (!addGroupLine(line, &err))
+        {
+            if (error)
+                *error = QStringLiteral("%1:%2: %3").arg(path).arg(lineNo).arg(err);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SimScenario::addGroupLine(const QString &line, QString *error)
+{
+    const QStringList tok = line.simplified().split(QLatin1Char(' '));
+    if (tok.size() < 2)
+    {
+        if (error)
+            *error = QStringLiteral("expected \"<straight|turn|swarm> <count> [key=value ...]\"");
+        return false;
+    }
+    Group g;
+    const QString kind = tok[0].toLower();
+    if (kind == QLatin1String("straight"))
+        g.path = Path::Straight;
+    else if (kind == QLatin1String("turn"))
+        g.path = Path::Turn;
+    else if (kind == QLatin1String("swarm"))
+        g.path = Path::Swarm;
+    else
+    {
+        if (error)
+            *error = QStringLiteral("unknown path \"%1\"").arg(tok[0]);
+        return false;
+    }
+    bool ok = false;
+    g.count = tok[1].toInt(&ok);
+    if (!ok || g.count < 0)
+    {
+        if (error)
+            *error = QStringLiteral("bad count \"%1\"").arg(tok[1]);
+        return false;
+    }
+    for (int i = 2; i < tok.size(); ++i)
+    {
+        const int eq = tok[i].indexOf(QLatin1Char('='));
+        const QString key = tok[i].left(eq).toLower();
+        bool valid = eq > 0;
+        const float v = valid ? tok[i].mid(eq + 1).toFloat(&valid) : 0.0f;
+        if (!valid)
+        {
+            if (error)
+                *error = QStringLiteral("bad option \"%1\"").arg(tok[i]);
+            return false;
+        }
+        if (key == QLatin1String("speed"))
+            g.speed = v;
+        else if (key == QLatin1String("alt"))
+            g.altitude = v;
+        else if (key == QLatin1String("turn"))
+            g.turnRate = v;
+        else if (key == QLatin1String("spread"))
+            g.spread = v;
+        else if (key == QLatin1String("heading"))
+            g.heading = v;
+        else if (key == QLatin1String("minrange"))
+            g.minRange = qBound(0.0f, v, 1.0f);
+        else if (key == QLatin1String("type"))
+            g.targetType = quint8(v);
+        else if (key == QLatin1String("size"))
+            g.targetSize = quint8(v);
+        else
+        {
+            if (error)
+                *error = QStringLiteral("unknown option \"%1\"").arg(key);
+            return false;
+        }
+    }
+    addGroup(g);
+    return true;
+}
+
+void SimScenario::addGroup(const Group &group)
+{
+    const int groupIndex = int(m_groups.size());
+    m_groups.push_back(group);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // 集群共用一个中心与航向（默认大致朝向雷达）
+    const double swarmAz = deg2rad(360.0 * unit(m_rng));
+    const double swarmR = m_maxRange * (group.minRange + (1.0 - group.minRange) * unit(m_rng));
+    const float swarmCourse = group.heading >= 0 ? wrap360(group.heading)
+                                                 : wrap360(rad2deg(swarmAz) + 180.0 + 40.0 * (unit(m_rng) - 0.5));
+
+    m_targets.reserve(m_targets.size() + std::size_t(group.count));
+    for (int i = 0; i < group.count; ++i)
+    {
+        Target t;
+        t.id = m_nextId++;
+        if (m_nextId == 0)
+            m_nextId = 1; // 批号0保留给“无目标”
+        t.group = groupIndex;
+        if (group.path == Path::Swarm)
+        {
+            const double a = 2.0 * Pi * unit(m_rng);
+            const double r = group.spread * std::sqrt(unit(m_rng));
+            t.x = swarmR * std::sin(swarmAz) + r * std::sin(a);
+            t.y = swarmR * std::cos(swarmAz) + r * std::cos(a);
+            t.baseCourse = swarmCourse;
+            t.phase = float(2.0 * Pi * unit(m_rng));
+        }
+        else
+        {
+            const double az = deg2rad(360.0 * unit(m_rng));
+            const double r = m_maxRange * (group.minRange + (1.0 - group.minRange) * unit(m_rng));
+            t.x = r * std::sin(az);
+            t.y = r * std::cos(az);
+            t.baseCourse = group.heading >= 0 ? wrap360(group.heading) : wrap360(360.0 * unit(m_rng));
+        }
+        t.course = t.baseCourse;
+        m_targets.push_back(t);
+    }
+}
+
+void SimScenario::spawnAtEdge(Target &t)
+{
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double az = 360.0 * unit(m_rng);
+    const double r = m_maxRange * 0.98;
+    t.x = r * std::sin(deg2rad(az));
+    t.y = r * std::cos(deg2rad(az));
+    // 朝雷达方向 ±30° 飞入
+    t.baseCourse = wrap360(az + 180.0 + 60.0 * (unit(m_rng) - 0.5));
+    t.course = t.baseCourse;
+}
+
+void SimScenario::advance(Target &t, qint64 nowMs)
+{
+    if (t.lastMs < 0 || nowMs <= t.lastMs)
+    {
+        t.lastMs = qMax(t.lastMs, nowMs);
+        return;
+    }
+    const Group &g = m_groups[std::size_t(t.group)];
+    const double dt = double(nowMs - t.lastMs) / 1000.0;
+    t.lastMs = nowMs;
+
+    double heading = t.course; // 本段位移使用的航向（转弯取中点）
+    switch (g.path)
+    {
+    case Path::Straight:
+        break;
+    case Path::Turn:
+        heading = t.course + 0.5 * g.turnRate * dt;
+        t.course = wrap360(t.course + g.turnRate * dt);
+        break;
+    case Path::Swarm:
+        t.course = wrap360(t.baseCourse + SwarmWeaveDeg * std::sin(2.0 * Pi * nowMs / SwarmWeavePeriodMs + t.phase));
+        heading = t.course;
+        break;
+    }
+    const double h = deg2rad(heading);
+    t.x += g.speed * std::sin(h) * dt;
+    t.y += g.speed * std::cos(h) * dt;
+    if (t.x * t.x + t.y * t.y > double(m_maxRange) * m_maxRange * 1.04)
+        spawnAtEdge(t);
+}
+
+bool SimScenario::report(int i, qint64 nowMs, TrackInfo &out)
+{
+    Target &t = m_targets[std::size_t(i)];
+    if (!t.alive)
+    {
+        if (t.deadUntil < 0 || nowMs < t.deadUntil)
+            return false;
+        t.alive = true;
+        spawnAtEdge(t);
+        t.lastMs = nowMs;
+    }
+    advance(t, nowMs);
+
+    const Group &g = m_groups[std::size_t(t.group)];
+    const double horiz = std::sqrt(t.x * t.x + t.y * t.y);
+    const double distance = std::sqrt(horiz * horiz + double(g.altitude) * g.altitude);
+
+    out = TrackInfo();
+    out.trackId = t.id;
+    out.tgtLon = m_radarLon + t.x / m_metersPerDegLon;
+    out.tgtLat = m_radarLat + t.y / MetersPerDegLat;
+    out.tgtAlt = m_radarAlt + g.altitude;
+    out.distance = float(distance);
+    out.azimuth = wrap360(rad2deg(std::atan2(t.x, t.y)));
+    out.elevation = float(rad2deg(std::atan2(double(g.altitude), horiz)));
+    out.speed = g.speed;
+    out.course = t.course;
+    out.strength = float(60.0 - 20.0 * std::log10(qMax(distance, 1.0)));
+    out.targetType = g.targetType;
+    out.targetSize = g.targetSize;
+    out.pointType = 0; // 检测点
+    out.trackType = 2; // 跟踪
+    out.lostCount = 0;
+    out.quality = 90;
+    out.rawDistance = out.distance;
+    out.rawAzimuth = out.azimuth;
+    out.rawElevation = out.elevation;
+    return true;
+}
+
+bool SimScenario::hit(quint8 idLow, qint64 nowMs)
+{
+    bool found = false;
+    for (Target &t : m_targets)
+    {
+        if ((t.id & 0xFF) != idLow || !t.alive)
+            continue;
+        t.alive = false;
+        t.deadUntil = m_respawnMs < 0 ? -1 : nowMs + m_respawnMs;
+        found = true;
+    }
+    return found;
+}
@@ -0,0 +1,89 @@
+// SimScenario.h
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <random>
+#include <vector>
+#include "TrackMessage.h"
+
+// radar_sim 的目标场景：若干目标组，每组若干目标按同一种航路运动。
+// - straight 直线，turn 恒定角速度盘旋，swarm 集群（共同航向，各自蛇形摆动）；
+// - 目标只在被报告时才积分到当前时刻，目标数很大时开销只与发送速率成正比；
+// - 飞出量程的目标从量程边缘重新飞入，被命中的目标在 respawnMs 后重新出现（新航迹，同批号）。
+// 坐标为以雷达为原点的东-北-天（米）。
+class SimScenario
+{
+public:
+    enum class Path
+    {
+        Straight,
+        Turn,
+        Swarm
+    };
+
+    struct Group
+    {
+        Path path = Path::Straight;
+        int count = 10;
+        float speed = 20.0f;     // m/s
+        float altitude = 100.0f; // m（相对雷达）
+        float turnRate = 6.0f;   // deg/s，turn 航路
+        float spread = 300.0f;   // m，swarm 初始散布半径
+        float heading = -1.0f;   // deg，<0 随机；swarm 为集群共同航向
+        float minRange = 0.3f;   // 初始距离下限（量程的比例）
+        quint8 targetType = 1;   // 同 TrackInfo::targetType
+        quint8 targetSize = 0;
+    };
+
+    explicit SimScenario(quint32 seed = 1);
+
+    // 场景脚本，每行：<straight|turn|swarm> <数量> [key=value ...]，# 之后为注释
+    // key：speed alt turn spread heading minrange type size
+    bool load(const QString &path, QString *error);
+    bool addGroupLine(const QString &line, QString *error);
+    void addGroup(const Group &group);
+
+    void setRadarPosition(double lon, double lat, float alt);
+    double radarLon() const { return m_radarLon; }
+    double radarLat() const { return m_radarLat; }
+    float radarAlt() const { return m_radarAlt; }
+    void setMaxRange(float meters) { m_maxRange = qMax(100.0f, meters); }
+    float maxRange() const { return m_maxRange; }
+    void setRespawnMs(qint64 ms) { m_respawnMs = ms; }
+
+    int targetCount() const { return int(m_targets.size()); }
+    // 把第 i 个目标推进到 nowMs 并填写航迹记录；目标已被命中尚未重生时返回 false
+    bool report(int i, qint64 nowMs, TrackInfo &out);
+    // 命中：批号低8位匹配的目标全部消失（命中报文只带低8位，按接收方能分辨的程度处理），
+    // respawnMs 后重新飞入；< 0 表示不再出现
+    bool hit(quint8 idLow, qint64 nowMs);
+
+private:
+    struct Target
+    {
+        quint16 id{};
+        int group{};
+        double x{}, y{}; // 东、北 (m)
+        float course{};  // deg
+        float baseCourse{};
+        float phase{};       // swarm 摆动相位 (rad)
+        qint64 lastMs{-1};   // 上次积分到的时刻，<0 表示尚未开始
+        qint64 deadUntil{0}; // 被命中后重生时刻；-1 不再重生
+        bool alive{true};
+    };
+
+    void spawnAtEdge(Target &t);
+    void advance(Target &t, qint64 nowMs);
+
+    std::vector<Group> m_groups;
+    std::vector<Target> m_targets;
+    std::mt19937 m_rng;
+    quint16 m_nextId{1};
+    double m_radarLon{116.3975};
+    double m_radarLat{39.9087};
+    float m_radarAlt{50.0f};
+    double m_metersPerDegLon{0.0};
+    float m_maxRange{5000.0f};
+    qint64 m_respawnMs{5000};
+};
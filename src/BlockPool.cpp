@@ -0,0 +1,80 @@
+// BlockPool.cpp
+#include "BlockPool.h"
+#include <new>
+
+BlockPool::~BlockPool()
+{
+    trimTo(0);
+}
+
+int BlockPool::classOf(std::size_t bytes)
+{
+    int c = 0;
+    while ((std::size_t(1) << (c + MinShift)) < bytes)
+        ++c;
+    return c;
+}
+
+std::size_t BlockPool::blockSize(std::size_t bytes)
+{
+    return std::size_t(1) << (classOf(bytes) + MinShift);
+}
+
+void *BlockPool::acquire(std::size_t bytes)
+{
+    const int c = classOf(bytes);
+    const qint64 size = qint64(1) << (c + MinShift);
+    void *block;
+    if (FreeBlock *f = m_free[c])
+    {
+        m_free[c] = f->next;
+        m_cachedBytes -= size;
+        ++m_reuses;
+        block = f;
+    }
+    else
+    {
+        block = ::operator new(std::size_t(size));
+        ++m_allocations;
+    }
+    m_liveBytes += size;
+    m_peakLiveBytes = qMax(m_peakLiveBytes, m_liveBytes);
+    return block;
+}
+
+void BlockPool::release(void *block, std::size_t bytes)
+{
+    if (!block)
+        return;
+    const int c = classOf(bytes);
+    const qint64 size = qint64(1) << (c + MinShift);
+    FreeBlock *f = static_cast<FreeBlock *>(block);
+    f->next = m_free[c];
+    m_free[c] = f;
+    m_liveBytes -= size;
+    m_cachedBytes += size;
+    if (m_cachedBytes > m_cacheLimit)
+        trimTo(m_cacheLimit);
+}
+
+void BlockPool::setCacheLimit(qint64 bytes)
+{
+    m_cacheLimit = qMax<qint64>(0, bytes);
+    trimTo(m_cacheLimit);
+}
+
+void BlockPool::trimTo(qint64 limit)
+{
+    // 大块先还：同样的字节数释放次数最少，小块留着给新航迹复用
+    for (int c = Classes - 1; c >= 0 && m_cachedBytes > limit; --c)
+    {
+        const qint64 size = qint64(1) << (c + MinShift);
+        while (m_free[c] && m_cachedBytes > limit)
+        {
+            FreeBlock *f = m_free[c];
+            m_free[c] = f->next;
+            ::operator delete(f);
+            m_cachedBytes -= size;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+// BlockPool.h
+#pragma once
+
+#include <QtGlobal>
+#include <cstddef>
+
+// 按2的幂分级的内存块池（单线程，轨迹缓冲用）：
+// - acquire 向上取整到2的幂，优先复用同级空闲块，空闲链表侵入式存放在块内，不另外分配；
+// - release 的块挂回空闲链表，缓存（空闲块总字节）超过 cacheLimit 时从大块开始还给系统，
+//   因此池占用（在用 + 缓存）不会长期超过 max(cacheLimit, 在用)；
+// - 在用字节、峰值、复用次数可随时读取，供内存预算与统计使用。
+// 池的生命周期必须长于所有从池中取得的块。
+class BlockPool
+{
+public:
+    BlockPool() = default;
+    ~BlockPool();
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+
+    // bytes 为请求大小；返回块的实际大小为 blockSize(bytes)，release 时传同一个 bytes
+    void *acquire(std::size_t bytes);
+    void release(void *block, std::size_t bytes);
+    static std::size_t blockSize(std::size_t bytes);
+
+    void setCacheLimit(qint64 bytes);
+    qint64 cacheLimit() const { return m_cacheLimit; }
+    // 把缓存的空闲块全部还给系统
+    void trim() { trimTo(0); }
+
+    qint64 liveBytes() const { return m_liveBytes; }     // 在用
+    qint64 cachedBytes() const { return m_cachedBytes; } // 空闲待复用
+    qint64 peakLiveBytes() const { return m_peakLiveBytes; }
+    quint64 allocations() const { return m_allocations; } // 向系统申请的次数
+    quint64 reuses() const { return m_reuses; }           // 从空闲链表复用的次数
+
+private:
+    static constexpr int MinShift = 4; // 最小块16字节（放得下链表指针）
+    static constexpr int Classes = 32;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    static int classOf(std::size_t bytes);
+    void trimTo(qint64 limit);
+
+    FreeBlock *m_free[Classes] = {};
+    qint64 m_cacheLimit = 4ll << 20;
+    qint64 m_liveBytes{0};
+    qint64 m_cachedBytes{0};
+    qint64 m_peakLiveBytes{0};
+    quint64 m_allocations{0};
+    quint64 m_reuses{0};
+};
@@ -0,0 +1,259 @@
+// Checksum.cpp
+#include "Checksum.h"
+#include <QtEndian>
+#include <cstring>
+
+// x86-64 上 SSE2 是基线指令集，32位 x86 走标量
+#if defined(__x86_64__) || defined(_M_X64)
+#define RADAR_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define RADAR_CHECKSUM_NEON 1
+#include <arm_neon.h>
+#endif
+// AVX2 内核依赖函数级 target 属性，仅 GCC/Clang 编译
+#if defined(RADAR_CHECKSUM_X86) && (defined(__GNUC__) || defined(__clang__))
+#define RADAR_CHECKSUM_AVX2 1
+#endif
+
+namespace Checksum
+{
+    // ---------------- 和校验 ----------------
+
+    quint16 sum16Scalar(const uchar *data, std::size_t n)
+    {
+        // 累加到32位后统一取低16位，与逐字节取模结果相同
+        quint32 sum = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            sum += data[i];
+        return quint16(sum);
+    }
+
+#if defined(RADAR_CHECKSUM_X86)
+    static quint16 sum16Sse2(const uchar *data, std::size_t n)
+    {
+        // _mm_sad_epu8 与全零求绝对差和 = 每8字节求和到64位通道，不会溢出
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+        }
+        quint64 lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        quint64 sum = lanes[0] + lanes[1];
+        for (; i < n; ++i)
+            sum += data[i];
+        return quint16(sum);
+    }
+#endif
+
+#if defined(RADAR_CHECKSUM_AVX2)
+    __attribute__((target("avx2"))) static quint16 sum16Avx2(const uchar *data, std::size_t n)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        std::size_t i = 0;
+        // 两路累加器隐藏 vpsadbw 延迟
+        for (; i + 64 <= n; i += 64)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 32));
+            acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(a, zero));
+            acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(b, zero));
+        }
+        for (; i + 32 <= n; i += 32)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(a, zero));
+        }
+        quint64 lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), _mm256_add_epi64(acc0, acc1));
+        quint64 sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        // 16字节尾块：短命令帧大部分落在这里
+        if (i + 16 <= n)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_sad_epu8(v, _mm_setzero_si128()));
+            sum += lanes[0] + lanes[1];
+            i += 16;
+        }
+        for (; i < n; ++i)
+            sum += data[i];
+        return quint16(sum);
+    }
+#endif
+
+#if defined(RADAR_CHECKSUM_NEON)
+    static quint16 sum16Neon(const uchar *data, std::size_t n)
+    {
+        // 每16字节横向求和（最大4080，16位足够），再累加到64位
+        quint64 sum = 0;
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+            sum += vaddlvq_u8(vld1q_u8(data + i));
+        for (; i < n; ++i)
+            sum += data[i];
+        return quint16(sum);
+    }
+#endif
+
+    Kernel sum16Sse2Kernel()
+    {
+#if defined(RADAR_CHECKSUM_X86)
+        return &sum16Sse2;
+#else
+        return nullptr;
+#endif
+    }
+
+    Kernel sum16Avx2Kernel()
+    {
+#if defined(RADAR_CHECKSUM_AVX2)
+        return __builtin_cpu_supports("avx2") ? &sum16Avx2 : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    Kernel sum16NeonKernel()
+    {
+#if defined(RADAR_CHECKSUM_NEON)
+        return &sum16Neon;
+#else
+        return nullptr;
+#endif
+    }
+
+    namespace
+    {
+        struct Sum16Dispatch
+        {
+            Kernel kernel = &sum16Scalar;
+            const char *name = "scalar";
+
+            Sum16Dispatch()
+            {
+                if (Kernel k = sum16Avx2Kernel())
+                {
+                    kernel = k;
+                    name = "avx2";
+                }
+                else if (Kernel k = sum16Sse2Kernel())
+                {
+                    kernel = k;
+                    name = "sse2";
+                }
+                else if (Kernel k = sum16NeonKernel())
+                {
+                    kernel = k;
+                    name = "neon";
+                }
+            }
+        };
+
+        const Sum16Dispatch &sum16Dispatch()
+        {
+            static const Sum16Dispatch d; // 首次使用时探测一次CPU
+            return d;
+        }
+    } // namespace
+
+    quint16 sum16(const uchar *data, std::size_t n)
+    {
+        return sum16Dispatch().kernel(data, n);
+    }
+
+    const char *sum16KernelName()
+    {
+        return sum16Dispatch().name;
+    }
+
+    // ---------------- CRC-16/IBM ----------------
+
+    quint16 crc16IbmBitwise(const uchar *data, std::size_t n)
+    {
+        quint16 crc = 0xFFFF;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            crc ^= data[k];
+            for (int i = 0; i < 8; ++i)
+            {
+                if (crc & 1)
+                    crc = (crc >> 1) ^ 0xA001; // 0xA001 = reverse(0x8005)
+                else
+                    crc >>= 1;
+            }
+        }
+        return crc;
+    }
+
+    namespace
+    {
+        // T[0] 为单字节表；T[k][b] 表示字节 b 后再跟 k 个零字节的CRC贡献
+        struct Crc16Tables
+        {
+            quint16 t[8][256];
+
+            Crc16Tables()
+            {
+                for (int b = 0; b < 256; ++b)
+                {
+                    quint16 crc = quint16(b);
+                    for (int i = 0; i < 8; ++i)
+                        crc = (crc & 1) ? quint16((crc >> 1) ^ 0xA001) : quint16(crc >> 1);
+                    t[0][b] = crc;
+                }
+                for (int k = 1; k < 8; ++k)
+                    for (int b = 0; b < 256; ++b)
+                        t[k][b] = quint16((t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xFF]);
+            }
+        };
+
+        const Crc16Tables &crcTables()
+        {
+            static const Crc16Tables tables;
+            return tables;
+        }
+    } // namespace
+
+    quint16 crc16IbmSlice8(const uchar *data, std::size_t n)
+    {
+        const auto &t = crcTables().t;
+        quint32 crc = 0xFFFF;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            // 反射CRC：当前crc异或进前两个字节，8个字节各查一张表
+            const quint64 w = qFromLittleEndian<quint64>(data + i) ^ quint64(crc);
+            crc = t[7][w & 0xFF] ^ t[6][(w >> 8) & 0xFF] ^ t[5][(w >> 16) & 0xFF] ^ t[4][(w >> 24) & 0xFF] ^
+                  t[3][(w >> 32) & 0xFF] ^ t[2][(w >> 40) & 0xFF] ^ t[1][(w >> 48) & 0xFF] ^ t[0][w >> 56];
+        }
+        for (; i < n; ++i)
+            crc = (crc >> 8) ^ t[0][(crc ^ data[i]) & 0xFF];
+        return quint16(crc);
+    }
+
+    quint16 crc16Ibm(const uchar *data, std::size_t n)
+    {
+        return crc16IbmSlice8(data, n);
+    }
+
+    // ---------------- 整帧校验 ----------------
+
+    bool verifyFrame(const uchar *frame, std::size_t n, quint8 method)
+    {
+        if (method != Sum16 && method != Crc16)
+            return true;
+        if (n < 2)
+            return false;
+        const std::size_t body = n - 2;
+        const quint16 expected = qFromLittleEndian<quint16>(frame + body);
+        const quint16 actual = (method == Sum16) ? sum16(frame, body) : crc16Ibm(frame, body);
+        return actual == expected;
+    }
+} // namespace Checksum
@@ -0,0 +1,39 @@
+// Checksum.h
+#pragma once
+
+#include <QtGlobal>
+#include <cstddef>
+
+// 协议校验计算（帧头“校验方式”：0无校验，1和校验，2 CRC16）。
+// - 和校验：全部字节求和取低16位，按CPU能力在运行时选择 AVX2/SSE2/NEON 向量实现，否则走标量；
+// - CRC-16/IBM（poly 0xA001 反射，初值0xFFFF）：slice-by-8 查表，每次处理8字节。
+// 各内核单独导出，供基准程序对比吞吐。
+namespace Checksum
+{
+    enum Method : quint8
+    {
+        None = 0,
+        Sum16 = 1,
+        Crc16 = 2
+    };
+
+    // 自动选择的最快实现
+    quint16 sum16(const uchar *data, std::size_t n);
+    quint16 crc16Ibm(const uchar *data, std::size_t n);
+
+    // 校验整帧：末尾2字节（小端）为校验位，覆盖其前全部字节。
+    // 未知校验方式按协议“其他值忽略”视为通过。
+    bool verifyFrame(const uchar *frame, std::size_t n, quint8 method);
+
+    // 当前选中的和校验内核名称（"avx2"/"sse2"/"neon"/"scalar"）
+    const char *sum16KernelName();
+
+    // 单独的内核（基准/对照用）；不支持的内核返回 nullptr
+    using Kernel = quint16 (*)(const uchar *, std::size_t);
+    quint16 sum16Scalar(const uchar *data, std::size_t n);
+    Kernel sum16Sse2Kernel();
+    Kernel sum16Avx2Kernel();
+    Kernel sum16NeonKernel();
+    quint16 crc16IbmBitwise(const uchar *data, std::size_t n);
+    quint16 crc16IbmSlice8(const uchar *data, std::size_t n);
+} // namespace Checksum
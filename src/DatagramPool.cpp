@@ -0,0 +1,103 @@
+// DatagramPool.cpp
+#include "DatagramPool.h"
+
+DatagramRef::DatagramRef(const DatagramRef &other)
+    : m_pool(other.m_pool), m_slot(other.m_slot), m_size(other.m_size)
+{
+    if (m_pool)
+        m_pool->addRef(m_slot);
+}
+
+DatagramRef::DatagramRef(DatagramRef &&other) noexcept
+    : m_pool(other.m_pool), m_slot(other.m_slot), m_size(other.m_size)
+{
+    other.m_pool = nullptr;
+    other.m_slot = -1;
+    other.m_size = 0;
+}
+
+DatagramRef &DatagramRef::operator=(const DatagramRef &other)
+{
+    if (this != &other)
+    {
+        if (other.m_pool)
+            other.m_pool->addRef(other.m_slot);
+        reset();
+        m_pool = other.m_pool;
+        m_slot = other.m_slot;
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+DatagramRef &DatagramRef::operator=(DatagramRef &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        m_pool = other.m_pool;
+        m_slot = other.m_slot;
+        m_size = other.m_size;
+        other.m_pool = nullptr;
+        other.m_slot = -1;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+const char *DatagramRef::data() const
+{
+    return m_pool ? m_pool->slotData(m_slot) : nullptr;
+}
+
+char *DatagramRef::writableData()
+{
+    return m_pool ? m_pool->slotData(m_slot) : nullptr;
+}
+
+int DatagramRef::capacity() const
+{
+    return m_pool ? m_pool->slotBytes() : 0;
+}
+
+void DatagramRef::reset()
+{
+    if (m_pool)
+        m_pool->release(m_slot);
+    m_pool = nullptr;
+    m_slot = -1;
+    m_size = 0;
+}
+
+DatagramPool::DatagramPool(int slotCount, int slotBytes)
+    : m_slotCount(qMax(1, slotCount)),
+      m_slotBytes(qMax(64, slotBytes)),
+      m_storage(new char[std::size_t(m_slotCount) * std::size_t(m_slotBytes)]),
+      m_refs(new std::atomic<int>[std::size_t(m_slotCount)])
+{
+    for (int i = 0; i < m_slotCount; ++i)
+        m_refs[i].store(0, std::memory_order_relaxed);
+}
+
+DatagramRef DatagramPool::acquire()
+{
+    // 槽按环形顺序复用：正常情况下游标处的槽早已被消费者释放，扫描是O(1)摊还
+    for (int n = 0; n < m_slotCount; ++n)
+    {
+        const int slot = m_cursor;
+        m_cursor = (m_cursor + 1 == m_slotCount) ? 0 : m_cursor + 1;
+        if (m_refs[slot].load(std::memory_order_acquire) == 0)
+        {
+            m_refs[slot].store(1, std::memory_order_relaxed);
+            m_inUse.fetch_add(1, std::memory_order_relaxed);
+            return DatagramRef(this, slot);
+        }
+    }
+    return {};
+}
+
+void DatagramPool::release(int slot)
+{
+    if (m_refs[slot].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_inUse.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,73 @@
+// DatagramPool.h
+#pragma once
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+class DatagramPool;
+
+// 指向池内一个缓冲槽的引用计数视图：
+// - 拷贝只增加引用计数，不拷贝数据；最后一个引用析构时槽归还给池；
+// - 可在线程间传递（采集线程取得，GUI线程释放）。
+class DatagramRef
+{
+public:
+    DatagramRef() = default;
+    DatagramRef(const DatagramRef &other);
+    DatagramRef(DatagramRef &&other) noexcept;
+    DatagramRef &operator=(const DatagramRef &other);
+    DatagramRef &operator=(DatagramRef &&other) noexcept;
+    ~DatagramRef() { reset(); }
+
+    bool isNull() const { return m_pool == nullptr; }
+    const char *data() const;
+    char *writableData(); // 仅在交出引用前由接收方填充
+    int size() const { return m_size; }
+    void setSize(int n) { m_size = n; }
+    int capacity() const;
+    // 不拷贝的 QByteArray 视图；只在本引用存活期间有效，需要长期保存时请深拷贝
+    QByteArray bytes() const { return QByteArray::fromRawData(data(), m_size); }
+    void reset();
+
+private:
+    friend class DatagramPool;
+    DatagramRef(DatagramPool *pool, int slot) : m_pool(pool), m_slot(slot) {}
+
+    DatagramPool *m_pool{nullptr};
+    int m_slot{-1};
+    int m_size{0};
+};
+
+// 预分配的定长数据报缓冲池：
+// - 启动时一次性分配 slotCount * slotBytes，运行中不再分配；
+// - acquire 只允许在单一生产者线程调用；引用释放可在任意线程。
+// 池的生命周期必须长于所有 DatagramRef。
+class DatagramPool
+{
+public:
+    DatagramPool(int slotCount, int slotBytes);
+    DatagramPool(const DatagramPool &) = delete;
+    DatagramPool &operator=(const DatagramPool &) = delete;
+
+    // 取一个空闲槽（引用计数为1）；池耗尽时返回空引用
+    DatagramRef acquire();
+
+    int slotCount() const { return m_slotCount; }
+    int slotBytes() const { return m_slotBytes; }
+    int inUse() const { return m_inUse.load(std::memory_order_relaxed); }
+
+private:
+    friend class DatagramRef;
+    char *slotData(int slot) const { return m_storage.get() + std::size_t(slot) * std::size_t(m_slotBytes); }
+    void addRef(int slot) { m_refs[slot].fetch_add(1, std::memory_order_relaxed); }
+    void release(int slot);
+
+    int m_slotCount;
+    int m_slotBytes;
+    std::unique_ptr<char[]> m_storage;
+    std::unique_ptr<std::atomic<int>[]> m_refs;
+    int m_cursor{0}; // 生产者扫描起点
+    std::atomic<int> m_inUse{0};
+};
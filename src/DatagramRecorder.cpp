@@ -0,0 +1,252 @@
+// DatagramRecorder.cpp
+#include "DatagramRecorder.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#endif
+
+using namespace RecordFormat;
+
+struct DatagramRecorder::Segment
+{
+    QFile file;
+    uchar *map{nullptr};
+    quint64 capacity{0};
+    quint64 used{0};        // 下一条记录的文件偏移
+    quint64 nextIndexAt{0}; // 写到该偏移之后再记一条索引
+
+    SegmentHeader *header() const { return reinterpret_cast<SegmentHeader *>(map); }
+    IndexEntry *index() const { return reinterpret_cast<IndexEntry *>(map + HeaderBytes); }
+};
+
+DatagramRecorder::DatagramRecorder(const RecorderConfig &config)
+    : m_config(config),
+      m_retired(64)
+{
+    m_config.segmentBytes = qMax<qint64>(m_config.segmentBytes, DataOffset + (1 << 20));
+    m_config.maxSegments = qMax(2, m_config.maxSegments);
+    m_maxRecordBytes = quint64(m_config.segmentBytes - DataOffset);
+    m_segmentNs = qMax<qint64>(1000, m_config.segmentMs) * 1000000;
+    m_monoAnchorNs = monotonicNs();
+    m_wallAnchorMs = QDateTime::currentMSecsSinceEpoch();
+
+    QDir dir(m_config.directory);
+    if (!dir.mkpath(QStringLiteral(".")))
+        qWarning() << "Recorder: cannot create" << m_config.directory;
+    // 之前运行留下的段也计入保留数量
+    const QStringList existing = dir.entryList({QStringLiteral("radar-*.rec")}, QDir::Files, QDir::Name);
+    for (const QString &name : existing)
+        m_files.append(dir.absoluteFilePath(name));
+    enforceRetention();
+
+    // 第一段同步建好，首批数据报不因等待后台线程而丢失
+    m_ready.store(createSegment(), std::memory_order_release);
+    m_thread = QThread::create([this]()
+                               { prepareLoop(); });
+    m_thread->setObjectName(QStringLiteral("radar-recorder"));
+    m_thread->start(QThread::LowPriority);
+}
+
+DatagramRecorder::~DatagramRecorder()
+{
+    m_stop.store(true, std::memory_order_release);
+    m_wake.wakeAll();
+    if (m_thread)
+    {
+        m_thread->wait();
+        delete m_thread;
+    }
+    // 后台线程已退出，剩余的段在这里收尾
+    Segment *seg = nullptr;
+    while (m_retired.tryPop(seg))
+        finalizeSegment(seg);
+    if (m_current)
+        finalizeSegment(m_current);
+    if (Segment *ready = m_ready.exchange(nullptr, std::memory_order_acq_rel))
+        discardSegment(ready);
+}
+
+qint64 DatagramRecorder::monotonicNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool DatagramRecorder::append(Direction dir, const char *data, int size, qint64 monoNs)
+{
+    const quint64 need = recordBytes(size);
+    if (size < 0 || need > m_maxRecordBytes)
+    {
+        m_drops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Segment *seg = m_current;
+    if (!seg || seg->used + need > seg->capacity || monoNs - seg->header()->monoStartNs >= m_segmentNs)
+    {
+        seg = rotate();
+        if (!seg)
+        {
+            m_drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    SegmentHeader *h = seg->header();
+    uchar *p = seg->map + seg->used;
+    RecordHeader rh{};
+    rh.length = quint32(size);
+    rh.direction = dir;
+    memcpy(p, &rh, sizeof(rh)); // monoNs 仍为0
+    memcpy(p + sizeof(rh), data, size_t(size));
+    // 时间戳最后写：另一进程边写边读时，monoNs 非零即表示整条记录已写完
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(p + offsetof(RecordHeader, monoNs), &monoNs, sizeof(monoNs));
+
+    if (seg->used >= seg->nextIndexAt && h->indexCount < quint32(IndexEntries))
+    {
+        IndexEntry &e = seg->index()[h->indexCount];
+        e.monoNs = monoNs;
+        e.offset = seg->used;
+        ++h->indexCount;
+        seg->nextIndexAt = seg->used + h->indexStride;
+    }
+    if (h->records == 0)
+        h->firstNs = monoNs;
+    h->lastNs = monoNs;
+    ++h->records;
+    seg->used += need;
+    h->usedBytes = seg->used;
+
+    m_records.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(quint64(size), std::memory_order_relaxed);
+    return true;
+}
+
+DatagramRecorder::Segment *DatagramRecorder::rotate()
+{
+    if (m_current)
+    {
+        Segment *old = m_current;
+        if (!m_retired.tryPush(std::move(old)))
+            return nullptr; // 收尾队列满：先继续用当前段判断，本条丢弃
+        m_current = nullptr;
+        m_wake.wakeOne();
+    }
+    Segment *next = m_ready.exchange(nullptr, std::memory_order_acq_rel);
+    if (!next)
+        return nullptr; // 下一段还没建好
+    SegmentHeader *h = next->header();
+    // 同一次运行的各段共用一个时钟对齐点（段起点取整到毫秒），回放时跨段的UTC换算没有毫秒级跳变
+    const qint64 elapsedMs = (monotonicNs() - m_monoAnchorNs) / 1000000;
+    h->wallStartMs = m_wallAnchorMs + elapsedMs;
+    h->monoStartNs = m_monoAnchorNs + elapsedMs * 1000000;
+    m_current = next;
+    m_segments.fetch_add(1, std::memory_order_relaxed);
+    m_wake.wakeOne(); // 让后台线程准备再下一段
+    return next;
+}
+
+void DatagramRecorder::prepareLoop()
+{
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        Segment *seg = nullptr;
+        while (m_retired.tryPop(seg))
+            finalizeSegment(seg);
+        if (!m_ready.load(std::memory_order_acquire))
+        {
+            if (Segment *s = createSegment())
+                m_ready.store(s, std::memory_order_release);
+        }
+        // 唤醒可能丢失（采集线程不持锁），超时兜底
+        QMutexLocker lock(&m_wakeMutex);
+        m_wake.wait(&m_wakeMutex, 50);
+    }
+}
+
+DatagramRecorder::Segment *DatagramRecorder::createSegment()
+{
+    const QString name = QStringLiteral("radar-%1-%2.rec")
+                             .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss")))
+                             .arg(m_nextIndex, 6, 10, QChar('0'));
+    std::unique_ptr<Segment> seg(new Segment);
+    seg->file.setFileName(QDir(m_config.directory).filePath(name));
+    const qint64 cap = m_config.segmentBytes;
+
+    bool ok = seg->file.open(QIODevice::ReadWrite | QIODevice::Truncate);
+#if defined(Q_OS_LINUX)
+    // 真正分配磁盘块：写映射内存时不会因磁盘满触发 SIGBUS，也不产生碎片
+    ok = ok && ::posix_fallocate(seg->file.handle(), 0, cap) == 0;
+#else
+    ok = ok && seg->file.resize(cap);
+#endif
+    if (ok)
+        seg->map = seg->file.map(0, cap);
+    if (!seg->map)
+    {
+        if (!m_reportedError)
+        {
+            qWarning() << "Recorder: cannot allocate segment" << seg->file.fileName() << seg->file.errorString();
+            m_reportedError = true;
+        }
+        seg->file.close();
+        seg->file.remove();
+        return nullptr;
+    }
+    m_reportedError = false;
+
+    seg->capacity = quint64(cap);
+    seg->used = DataOffset;
+    seg->nextIndexAt = DataOffset;
+    SegmentHeader *h = seg->header();
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, Magic, sizeof(h->magic));
+    h->version = Version;
+    h->dataOffset = DataOffset;
+    h->capacity = quint64(cap);
+    h->segmentIndex = m_nextIndex++;
+    h->indexStride = quint32(qMax<quint64>(4096, (quint64(cap) - DataOffset) / IndexEntries));
+    h->usedBytes = DataOffset;
+    return seg.release();
+}
+
+void DatagramRecorder::finalizeSegment(Segment *seg)
+{
+    SegmentHeader *h = seg->header();
+    if (h->records == 0)
+    {
+        discardSegment(seg);
+        return;
+    }
+    h->closed = 1;
+    const qint64 used = qint64(seg->used);
+    const QString path = QFileInfo(seg->file).absoluteFilePath();
+    seg->file.unmap(seg->map);
+    seg->file.resize(used); // 去掉未用的预分配部分
+    seg->file.close();
+    delete seg;
+    m_files.append(path);
+    enforceRetention();
+}
+
+void DatagramRecorder::discardSegment(Segment *seg)
+{
+    seg->file.unmap(seg->map);
+    seg->file.close();
+    seg->file.remove();
+    delete seg;
+}
+
+void DatagramRecorder::enforceRetention()
+{
+    while (m_files.size() > m_config.maxSegments)
+        QFile::remove(m_files.takeFirst());
+}
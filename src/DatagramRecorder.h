@@ -0,0 +1,144 @@
+// DatagramRecorder.h
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <atomic>
+#include "SpscQueue.h"
+
+class QThread;
+
+// 原始数据报记录文件格式（小端，主机序直接写入映射内存）：
+// [段头 4KiB][时间索引 4096×16B][记录...]，每条记录：
+//   RecordHeader(16B) + 载荷 + 填充到8字节对齐；
+//   数据在 usedBytes 处结束，异常退出未关闭的段读到 monoNs==0 为止（预分配区全零）。
+// 段按大小或时长轮转，文件名 radar-<创建时间>-<序号>.rec，按文件名排序即时间顺序。
+namespace RecordFormat
+{
+    static_assert(Q_BYTE_ORDER == Q_LITTLE_ENDIAN, "record files are written in host byte order");
+
+    static constexpr char Magic[8] = {'R', 'D', 'R', 'R', 'E', 'C', '0', '1'};
+    static constexpr quint32 Version = 1;
+    static constexpr int HeaderBytes = 4096;
+    static constexpr int IndexEntries = 4096;
+    static constexpr int IndexBytes = IndexEntries * 16;
+    static constexpr int DataOffset = HeaderBytes + IndexBytes;
+
+    enum Direction : quint8
+    {
+        Rx = 0, // 雷达 -> 本机
+        Tx = 1  // 本机 -> 雷达
+    };
+
+    struct SegmentHeader
+    {
+        char magic[8];
+        quint32 version;
+        quint32 dataOffset;   // 第一条记录的文件偏移
+        quint64 capacity;     // 预分配的文件字节数
+        quint32 segmentIndex; // 本次运行内的段序号
+        quint32 indexStride;  // 相邻索引项至少间隔的数据字节数
+        qint64 wallStartMs;   // 段启用时的UTC毫秒
+        qint64 monoStartNs;   // 与 wallStartMs 对应的单调时钟（同一次运行各段换算一致）
+        qint64 firstNs;       // 首条记录时间（单调时钟）
+        qint64 lastNs;        // 末条记录时间
+        quint64 usedBytes;    // 数据结束的文件偏移
+        quint64 records;      // 记录条数
+        quint32 indexCount;   // 有效索引项数
+        quint32 closed;       // 1 = 已正常关闭（文件已截断到 usedBytes）
+    };
+    static_assert(sizeof(SegmentHeader) == 88, "segment header layout");
+
+    // 稀疏时间索引：记录时间单调递增，二分查找后最多顺序扫描 indexStride 字节
+    struct IndexEntry
+    {
+        qint64 monoNs;
+        quint64 offset;
+    };
+    static_assert(sizeof(IndexEntry) == 16, "index entry layout");
+
+    struct RecordHeader
+    {
+        quint32 length;     // 载荷字节数
+        quint8 direction;   // Direction
+        quint8 reserved[3]; // 0
+        qint64 monoNs;      // 接收/发送时的单调时钟（纳秒），最后写入；为0表示此处尚无记录
+    };
+    static_assert(sizeof(RecordHeader) == 16, "record header layout");
+
+    inline quint64 recordBytes(int payload) { return (sizeof(RecordHeader) + quint64(payload) + 7) & ~quint64(7); }
+} // namespace RecordFormat
+
+// 记录参数
+struct RecorderConfig
+{
+    QString directory;                   // 记录目录，空表示关闭
+    qint64 segmentBytes = 64ll << 20;    // 单段预分配大小
+    qint64 segmentMs = 10ll * 60 * 1000; // 单段最长时长，超过即轮转
+    int maxSegments = 64;                // 目录中最多保留的段文件，超出删除最旧的
+};
+
+// 始终开启的原始数据报记录器：
+// - append 只在采集线程调用（收、发都在该线程），写入预分配并映射好的段，只有 memcpy，不做文件操作；
+// - 后台线程提前建好下一段（预分配 + 映射），并负责旧段的收尾（写段头、解除映射、截断、按数量淘汰）；
+// - 轮转时下一段还没准备好则丢弃该条并计数，绝不阻塞采集。
+class DatagramRecorder
+{
+public:
+    explicit DatagramRecorder(const RecorderConfig &config);
+    ~DatagramRecorder();
+
+    DatagramRecorder(const DatagramRecorder &) = delete;
+    DatagramRecorder &operator=(const DatagramRecorder &) = delete;
+
+    // 采集线程调用；失败（无可用段/超长）返回 false
+    bool append(RecordFormat::Direction dir, const char *data, int size, qint64 monoNs);
+
+    // 记录用的单调时钟（纳秒），与回放使用同一时钟
+    static qint64 monotonicNs();
+
+    quint64 records() const { return m_records.load(std::memory_order_relaxed); }
+    quint64 bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+    quint64 drops() const { return m_drops.load(std::memory_order_relaxed); }
+    quint64 segments() const { return m_segments.load(std::memory_order_relaxed); }
+
+private:
+    struct Segment;
+
+    Segment *rotate();
+    void prepareLoop();
+    Segment *createSegment();
+    void finalizeSegment(Segment *seg);
+    void discardSegment(Segment *seg);
+    void enforceRetention();
+
+    RecorderConfig m_config;
+    quint64 m_maxRecordBytes{0};
+    qint64 m_segmentNs{0};
+    qint64 m_monoAnchorNs{0}; // 与 m_wallAnchorMs 同时取得
+    qint64 m_wallAnchorMs{0};
+
+    // 采集线程独占
+    Segment *m_current{nullptr};
+
+    // 采集线程 <-> 后台线程交接
+    std::atomic<Segment *> m_ready{nullptr}; // 后台预备好的下一段
+    SpscQueue<Segment *> m_retired;          // 写满/超时待收尾的段
+    std::atomic<bool> m_stop{false};
+    QMutex m_wakeMutex;
+    QWaitCondition m_wake;
+    QThread *m_thread{nullptr};
+
+    // 后台线程独占
+    quint32 m_nextIndex{0};
+    QStringList m_files; // 目录中已完成的段，按时间顺序
+    bool m_reportedError{false};
+
+    std::atomic<quint64> m_records{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_drops{0};
+    std::atomic<quint64> m_segments{0};
+};
@@ -0,0 +1,88 @@
+// DenseIdIndex.h
+#pragma once
+
+#include <QtGlobal>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// 批号（quint16）-> 稠密行号的索引，供按列存放（SoA）的各航迹表共用：
+// - 65536 项直接下标，查找/追加/删除均为 O(1)；索引在第一次追加时才分配（256KB）；
+// - 行连续编号 0..size()-1，删除时末行移入空位（行号因此会变），调用方用 eraseRow 同步各列：
+//     const int row = index.rowOf(id);
+//     index.removeRow(row);
+//     DenseIdIndex::eraseRow(row, m_x, m_y, ...);
+class DenseIdIndex
+{
+public:
+    DenseIdIndex() = default;
+    DenseIdIndex(const DenseIdIndex &) = delete;
+    DenseIdIndex &operator=(const DenseIdIndex &) = delete;
+
+    int size() const { return int(m_ids.size()); }
+    bool isEmpty() const { return m_ids.empty(); }
+    void reserve(int n) { m_ids.reserve(std::size_t(n)); }
+
+    // 不在表中返回 -1
+    int rowOf(quint16 id) const { return m_rows ? m_rows[id] : -1; }
+    bool contains(quint16 id) const { return rowOf(id) >= 0; }
+    quint16 idAt(int row) const { return m_ids[std::size_t(row)]; }
+    // 第 i 行的批号
+    const std::vector<quint16> &ids() const { return m_ids; }
+
+    // 为不在表中的 id 追加一行，返回行号（调用方随后给各列 push_back）
+    int append(quint16 id)
+    {
+        if (!m_rows)
+        {
+            m_rows.reset(new qint32[IndexSize]);
+            std::fill(m_rows.get(), m_rows.get() + IndexSize, -1);
+        }
+        const int row = size();
+        m_rows[id] = row;
+        m_ids.push_back(id);
+        return row;
+    }
+
+    // 删除第 row 行：末行的批号改指 row；各列随后用 eraseRow(row, ...) 同样处理
+    void removeRow(int row)
+    {
+        const std::size_t r = std::size_t(row);
+        m_rows[m_ids[r]] = -1;
+        if (r + 1 != m_ids.size())
+        {
+            m_ids[r] = m_ids.back();
+            m_rows[m_ids[r]] = row;
+        }
+        m_ids.pop_back();
+    }
+
+    void clear()
+    {
+        for (quint16 id : m_ids)
+            m_rows[id] = -1;
+        m_ids.clear();
+    }
+
+    // 各列删除第 row 行：末行移入空位后弹出末行（与 removeRow 的移动一致）
+    template <typename... Columns>
+    static void eraseRow(int row, Columns &...columns)
+    {
+        (eraseOne(std::size_t(row), columns), ...);
+    }
+
+private:
+    static constexpr std::size_t IndexSize = 65536;
+
+    template <typename Column>
+    static void eraseOne(std::size_t row, Column &c)
+    {
+        if (row + 1 != c.size())
+            c[row] = std::move(c.back());
+        c.pop_back();
+    }
+
+    std::unique_ptr<qint32[]> m_rows; // 批号 -> 行，-1 为无
+    std::vector<quint16> m_ids;       // 行 -> 批号
+};
@@ -0,0 +1,53 @@
+// FrameView.h
+#pragma once
+
+#include <QtGlobal>
+#include <QtEndian>
+#include <cstring>
+#include "Protocol.h"
+
+// 非拥有的报文视图基类：只保存指向接收缓冲的指针和长度，
+// 字段访问直接按小端从缓冲读取，不拷贝、不分配内存。
+// 视图不延长缓冲生命周期，需要保存数据时转为对应的拥有型结构体。
+class FrameView
+{
+public:
+    FrameView() = default;
+    FrameView(const uchar *data, int size) : m_data(data), m_size(size) {}
+
+    const uchar *data() const { return m_data; }
+    int size() const { return m_size; }
+    bool isNull() const { return m_data == nullptr; }
+
+    Protocol::FrameHeader header() const
+    {
+        Protocol::FrameHeader h;
+        Protocol::parseFrameHeader(m_data, m_size, h);
+        return h;
+    }
+    quint16 msgId() const { return u16(16); }
+    quint8 checkMethod() const { return u8(26); }
+
+protected:
+    quint8 u8(int off) const { return m_data[off]; }
+    quint16 u16(int off) const { return qFromLittleEndian<quint16>(m_data + off); }
+    quint32 u32(int off) const { return qFromLittleEndian<quint32>(m_data + off); }
+    float f32(int off) const
+    {
+        const quint32 bits = u32(off);
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+    double f64(int off) const
+    {
+        const quint64 bits = qFromLittleEndian<quint64>(m_data + off);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        return d;
+    }
+    void copyTo(void *dst, int off, int n) const { memcpy(dst, m_data + off, std::size_t(n)); }
+
+    const uchar *m_data{nullptr};
+    int m_size{0};
+};
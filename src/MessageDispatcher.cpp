@@ -0,0 +1,63 @@
+// MessageDispatcher.cpp
+#include "MessageDispatcher.h"
+#include "MessageIds.h"
+#include "Checksum.h"
+
+MessageDispatcher::Result MessageDispatcher::dispatch(const QByteArray &payload)
+{
+    Protocol::FrameHeader head;
+    if (!Protocol::parseFrameHeader(payload, head) || !head.hasMagic())
+        return Result::Malformed;
+
+    if (m_verifyChecksums && head.checkMethod != Checksum::None)
+    {
+        // 帧总字节数可信时按其截取（数据报尾部可能有填充），否则按数据报长度
+        int frameBytes = int(payload.size());
+        if (head.totalBytes >= Protocol::FrameHeader::Size + 2 && head.totalBytes <= frameBytes)
+            frameBytes = head.totalBytes;
+        if (!Checksum::verifyFrame(reinterpret_cast<const uchar *>(payload.constData()), std::size_t(frameBytes),
+                                   head.checkMethod))
+            return Result::BadChecksum;
+    }
+
+    switch (head.msgIdRadar)
+    {
+    case ProtocolIds::TrackReport:
+    {
+        TrackMessageView view;
+        if (!TrackMessageView::fromBytes(payload, view) || !view.isValid())
+            return Result::Malformed;
+        for (const auto &h : m_trackHandlers)
+            h(head, view);
+        return Result::Track;
+    }
+    case ProtocolIds::TrackBatchReport:
+    {
+        // 逐条记录的范围校验由订阅者在列式批上整批完成
+        TrackBatchView view;
+        if (!TrackBatchView::fromBytes(payload, view) || !view.isValid())
+            return Result::Malformed;
+        for (const auto &h : m_trackBatchHandlers)
+            h(head, view);
+        return Result::TrackBatch;
+    }
+    case ProtocolIds::RadarStatusReport:
+    {
+        RadarStatusView view;
+        if (!RadarStatusView::fromBytes(payload, view))
+            return Result::Malformed;
+        for (const auto &h : m_statusHandlers)
+            h(head, view);
+        return Result::Status;
+    }
+    default:
+        break;
+    }
+
+    const auto it = m_rawHandlers.constFind(head.msgIdRadar);
+    if (it == m_rawHandlers.constEnd())
+        return Result::UnknownId;
+    for (const auto &h : it.value())
+        h(head, payload);
+    return Result::Raw;
+}
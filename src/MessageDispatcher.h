@@ -0,0 +1,58 @@
+// MessageDispatcher.h
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <functional>
+#include "Protocol.h"
+#include "TrackMessage.h"
+#include "TrackBatch.h"
+#include "RadarStatus.h"
+
+// 单次解析的报文分发器：
+// - 每个数据报只解一次32字节帧头，按帧头中的 报文ID（雷达） 路由（见 MessageIds.h）；
+// - 每种报文只调用一个解码器，以非拥有视图（TrackMessageView/RadarStatusView）分发给所有订阅者，
+//   视图直接引用接收缓冲，分发过程不分配内存；订阅者需要保存时自行转为拥有型结构体；
+// - 不再靠逐个解析器试解析来猜报文类型（状态报文不会再被当成航迹）；
+// - 解码前按帧头“校验方式”验证帧尾校验（见 Checksum.h），校验失败的帧不进入解码。
+// 非线程安全：订阅在启动前完成，dispatch 只在采集线程调用。
+class MessageDispatcher
+{
+public:
+    enum class Result
+    {
+        Track,       // 航迹报文，已解码并分发
+        Status,      // 状态报文，已解码并分发
+        TrackBatch,  // 批量航迹报文，已分发
+        Raw,         // 其它已订阅的报文ID，按原始字节分发
+        UnknownId,   // 帧头合法但报文ID无人订阅
+        Malformed,   // 帧头缺失/魔数错误，或解码失败
+        BadChecksum  // 帧头声明了和校验/CRC16，但帧尾校验不符
+    };
+    static constexpr int ResultCount = 7;
+
+    using TrackHandler = std::function<void(const Protocol::FrameHeader &, const TrackMessageView &)>;
+    using TrackBatchHandler = std::function<void(const Protocol::FrameHeader &, const TrackBatchView &)>;
+    using StatusHandler = std::function<void(const Protocol::FrameHeader &, const RadarStatusView &)>;
+    using RawHandler = std::function<void(const Protocol::FrameHeader &, const QByteArray &)>;
+
+    void subscribeTrack(TrackHandler handler) { m_trackHandlers.append(std::move(handler)); }
+    void subscribeTrackBatch(TrackBatchHandler handler) { m_trackBatchHandlers.append(std::move(handler)); }
+    void subscribeStatus(StatusHandler handler) { m_statusHandlers.append(std::move(handler)); }
+    // 其它报文ID（如命令应答 0xF000）按原始字节订阅
+    void subscribeRaw(quint16 msgId, RawHandler handler) { m_rawHandlers[msgId].append(std::move(handler)); }
+
+    // 默认开启；关闭后忽略帧头校验方式（联调不规范设备时使用）
+    void setVerifyChecksums(bool on) { m_verifyChecksums = on; }
+    bool verifyChecksums() const { return m_verifyChecksums; }
+
+    Result dispatch(const QByteArray &payload);
+
+private:
+    bool m_verifyChecksums{true};
+    QVector<TrackHandler> m_trackHandlers;
+    QVector<TrackBatchHandler> m_trackBatchHandlers;
+    QVector<StatusHandler> m_statusHandlers;
+    QHash<quint16, QVector<RawHandler>> m_rawHandlers;
+};
@@ -40,6 +40,13 @@ namespace ProtocolIds
     static constexpr quint16 CfgReservedBegin = 0x2093;    // ~0x2FFF 系统保留
     static constexpr quint16 CfgReservedEnd = 0x2FFF;
 
+    // 表6 雷达上报报文（雷达->指挥中心）
+    static constexpr quint16 TrackReport = 0x3001;         // 雷达航迹报文，检测到航迹立即上传
+    static constexpr quint16 RadarStatusReport = 0x3002;   // 雷达状态报文，周期上传
+    static constexpr quint16 TrackBatchReport = 0x3003;    // 多航迹批量报文（本系统扩展，占用保留段首个ID）
+    static constexpr quint16 ReportReservedBegin = 0x3004; // ~0x3FFF 系统保留
+    static constexpr quint16 ReportReservedEnd = 0x3FFF;
+
     // 命中/击中目标报文（雷达->指挥中心或上层）
     static constexpr quint16 HitReport = 0x4444; // 0x4444 击中目标报文
 
@@ -1,92 +1,173 @@
 #include "NetworkManager.h"
 #include <QHostAddress>
 #include <QDebug>
-
-namespace
-{
-    QString hexDump(const QByteArray &data, int bytesPerLine = 16)
-    {
-        QString out;
-        const int n = data.size();
-        for (int i = 0; i < n; i += bytesPerLine)
-        {
-            // 偏移
-            out += QString("%1: ").arg(i, 6, 16, QLatin1Char('0')).toUpper();
-            // HEX
-            for (int j = 0; j < bytesPerLine; ++j)
-            {
-                if (i + j < n)
-                    out += QString("%1 ").arg(quint8(data[i + j]), 2, 16, QLatin1Char('0')).toUpper();
-                else
-                    out += "   ";
-                if (j == bytesPerLine / 2 - 1)
-                    out += " "; // 中间再加一个空格
-            }
-            // ASCII
-            out += " |";
-            for (int j = 0; j < bytesPerLine && i + j < n; ++j)
-            {
-                uchar c = uchar(data[i + j]);
-                out += (c >= 32 && c <= 126) ? QChar(c) : QChar('.');
-            }
-            out += "|\n";
-        }
-        return out;
-    }
-} // namespace
+#include <QtEndian>
 
 static constexpr quint16 LOCAL_UDP_PORT = 6553; // bind here for recv/send
+// 单次取队列的上限，防止突发流量长时间占用GUI事件循环
+static constexpr int MAX_FRAMES_PER_DRAIN = 1024;
 
 NetworkManager::NetworkManager(QObject *parent)
     : QObject(parent)
 {
     connect(&m_reconnectTimer, &QTimer::timeout, this, [&]() {});
     m_reconnectTimer.setInterval(3000);
+
+    m_statsTimer.setInterval(1000);
+    connect(&m_statsTimer, &QTimer::timeout, this, [this]()
+            {
+        IngestStats s = ingestStats();
+        // 每秒批次与平均批填充率（批量接收后端下 datagrams 全部来自 recvmmsg）
+        const quint64 batches = s.recvBatches - m_lastBatches;
+        const quint64 datagrams = s.datagrams - m_lastBatchedDatagrams;
+        const double secs = m_statsTimer.interval() / 1000.0;
+        m_batchesPerSec = batches / secs;
+        m_avgBatchFill = (batches > 0 && s.batchSize > 0) ? double(datagrams) / double(batches) / s.batchSize : 0.0;
+        m_lastBatches = s.recvBatches;
+        m_lastBatchedDatagrams = s.datagrams;
+        s.batchesPerSec = m_batchesPerSec;
+        s.avgBatchFill = m_avgBatchFill;
+        if (s.queueDrops > m_lastReportedDrops)
+        {
+            qWarning() << "Ingest queue dropped" << (s.queueDrops - m_lastReportedDrops) << "frames, depth=" << s.queueDepth
+                       << "highWater=" << s.queueHighWater << "/" << s.queueCapacity;
+            m_lastReportedDrops = s.queueDrops;
+        }
+        const quint64 rejected = s.badSum16 + s.badCrc16;
+        if (rejected > m_lastReportedRejects)
+        {
+            qWarning() << "Checksum rejected" << (rejected - m_lastReportedRejects) << "frames, total sum16=" << s.badSum16
+                       << "crc16=" << s.badCrc16;
+            m_lastReportedRejects = rejected;
+        }
+        emit ingestStatsUpdated(s); });
+}
+
+NetworkManager::~NetworkManager()
+{
+    m_ingestThread.quit();
+    m_ingestThread.wait();
 }
 
 void NetworkManager::start()
 {
-    if (!m_udpSocket)
-    {
-        m_udpSocket = new QUdpSocket(this);
-        if (!m_udpSocket->bind(QHostAddress::AnyIPv4, LOCAL_UDP_PORT, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
-        {
-            qWarning() << "Failed to bind UDP on" << LOCAL_UDP_PORT;
-            return;
-        }
-        qDebug() << "Bound UDP recv on" << LOCAL_UDP_PORT;
-        connect(m_udpSocket, &QUdpSocket::readyRead, this, &NetworkManager::onRadarDatagram);
-    }
+    if (m_worker)
+        return;
+    // 接收与解析放到独立采集线程，GUI线程只负责取队列和分发
+    m_worker = new RadarIngestWorker(LOCAL_UDP_PORT, m_ingestConfig);
+    m_worker->moveToThread(&m_ingestThread);
+    connect(&m_ingestThread, &QThread::started, m_worker, &RadarIngestWorker::start);
+    connect(&m_ingestThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &RadarIngestWorker::framesReady, this, &NetworkManager::drainIngestQueue, Qt::QueuedConnection);
+    connect(m_worker, &RadarIngestWorker::replayPosition, this, &NetworkManager::replayPositionChanged,
+            Qt::QueuedConnection);
+    connect(m_worker, &RadarIngestWorker::replayFinished, this, &NetworkManager::replayFinished, Qt::QueuedConnection);
+    m_ingestThread.setObjectName(QStringLiteral("radar-ingest"));
+    m_ingestThread.start(QThread::HighPriority);
+    m_statsTimer.start();
 }
 
 void NetworkManager::sendToRadar(const QByteArray &data)
 {
-    if (!m_udpSocket)
+    if (!m_worker)
         return;
-    qint64 written = m_udpSocket->writeDatagram(data, m_targetAddr, m_targetPort);
-    if (written <= 0)
-        qWarning() << "Failed to send UDP to radar" << m_targetAddr.toString() << m_targetPort << "err=" << m_udpSocket->errorString();
-    else
-    {
-        qDebug() << "UDP sent to" << m_targetAddr << m_targetPort << "len=" << written;
-        qDebug().noquote() << hexDump(data);
-    }
+    // socket 属于采集线程，发送请求排队到该线程执行
+    RadarIngestWorker *worker = m_worker;
+    const QHostAddress addr = m_targetAddr;
+    const quint16 port = m_targetPort;
+    QMetaObject::invokeMethod(worker, [worker, data, addr, port]()
+                              { worker->sendDatagram(data, addr, port); }, Qt::QueuedConnection);
 }
 
-void NetworkManager::onRadarDatagram()
+void NetworkManager::startReplay(const QString &path, double speed, qint64 startUtcMs)
 {
-    while (m_udpSocket && m_udpSocket->hasPendingDatagrams())
+    if (!m_worker)
+        return;
+    // 回放对象与解析管线同在采集线程
+    RadarIngestWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, path, speed, startUtcMs]()
+                              { worker->startReplay(path, speed, startUtcMs); }, Qt::QueuedConnection);
+}
+
+void NetworkManager::stopReplay()
+{
+    if (m_worker)
+        QMetaObject::invokeMethod(m_worker, &RadarIngestWorker::stopReplay, Qt::QueuedConnection);
+}
+
+void NetworkManager::setReplaySpeed(double speed)
+{
+    if (!m_worker)
+        return;
+    RadarIngestWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, speed]()
+                              { worker->setReplaySpeed(speed); }, Qt::QueuedConnection);
+}
+
+void NetworkManager::seekReplay(qint64 utcMs)
+{
+    if (!m_worker)
+        return;
+    RadarIngestWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker, utcMs]()
+                              { worker->seekReplay(utcMs); }, Qt::QueuedConnection);
+}
+
+void NetworkManager::drainIngestQueue()
+{
+    if (!m_worker)
+        return;
+    // 先清除通知标志再取队列：之后入队的帧会再次触发通知，不会漏取
+    m_worker->acknowledgeFrames();
+    IngestFrame &frame = m_drainFrame;
+    int n = 0;
+    // 本轮取出的全部航迹（单航迹帧与批量帧）合并成一批，界面每轮只更新一次
+    m_drainBatch.clear();
+    // 交换出队：frame 先前的内容（缓冲槽已归还，batch 容量保留）留在队列槽里给采集线程复用
+    while (n < MAX_FRAMES_PER_DRAIN && m_worker->queue().tryPopSwap(frame))
     {
-        QByteArray buf;
-        buf.resize(int(m_udpSocket->pendingDatagramSize()));
-        QHostAddress sender;
-        quint16 senderPort;
-        m_udpSocket->readDatagram(buf.data(), buf.size(), &sender, &senderPort);
-        // For binary frames, avoid printing raw payload fully
-        qDebug() << "UDP recv from" << sender << senderPort << "len=" << buf.size();
-        emit radarDatagramReceived(buf);
-        emit clientMessageReceived(buf);
+        ++n;
+        // frame 持有缓冲槽引用到本轮结束的 release()，直连的槽函数在此期间读取 raw 是安全的
+        emit radarDatagramReceived(frame.raw);
+        emit clientMessageReceived(frame.raw);
+        if (frame.hasStatus)
+            emit radarStatusReceived(frame.status);
+        if (frame.hasTrack)
+        {
+            emit trackReceived(frame.track);
+            m_drainBatch.append(frame.track.info);
+            m_drainBatch.utcMs = qFromLittleEndian<quint64>(frame.track.frameHead + 8);
+            m_drainBatch.insValid = frame.track.insValid;
+            m_drainBatch.radarLon = frame.track.radarLon;
+            m_drainBatch.radarLat = frame.track.radarLat;
+            m_drainBatch.radarAlt = frame.track.radarAlt;
+        }
+        if (frame.hasBatch)
+        {
+            const TrackBatch &b = frame.batch;
+            m_drainBatch.utcMs = b.utcMs;
+            m_drainBatch.insValid = b.insValid;
+            m_drainBatch.radarLon = b.radarLon;
+            m_drainBatch.radarLat = b.radarLat;
+            m_drainBatch.radarAlt = b.radarAlt;
+            m_drainBatch.append(b);
+        }
+        frame.release();
     }
+    if (!m_drainBatch.isEmpty())
+        emit trackBatchReceived(m_drainBatch);
+    if (n == MAX_FRAMES_PER_DRAIN)
+        QMetaObject::invokeMethod(this, &NetworkManager::drainIngestQueue, Qt::QueuedConnection);
+}
+
+IngestStats NetworkManager::ingestStats() const
+{
+    if (!m_worker)
+        return {};
+    IngestStats s = m_worker->stats();
+    s.batchesPerSec = m_batchesPerSec;
+    s.avgBatchFill = m_avgBatchFill;
+    return s;
 }
 
 void NetworkManager::setTarget(const QHostAddress &addr, quint16 port)
@@ -4,28 +4,69 @@
 #include <QObject>
 #include <QUdpSocket>
 #include <QTimer>
+#include <QThread>
+#include "RadarIngest.h"
 
 class NetworkManager : public QObject
 {
     Q_OBJECT
 public:
     explicit NetworkManager(QObject *parent = nullptr);
+    ~NetworkManager() override;
+    // 采集参数（批大小、缓冲池大小等），须在 start 之前设置
+    void setIngestConfig(const IngestConfig &config) { m_ingestConfig = config; }
+    const IngestConfig &ingestConfig() const { return m_ingestConfig; }
     void start();
     bool isRadarConnected() const;
     void sendToRadar(const QByteArray &data);
     void setTarget(const QHostAddress &addr, quint16 port);
 
+    // 采集线程统计（队列深度、丢弃数、批量接收速率等）
+    IngestStats ingestStats() const;
+
+    // 回放记录文件/目录到同一条采集管线（须在 start 之后调用）
+    // speed: 1 实时，N 倍速，<= 0 最快；startUtcMs > 0 时从该时刻开始
+    void startReplay(const QString &path, double speed = 1.0, qint64 startUtcMs = 0);
+    void stopReplay();
+    void setReplaySpeed(double speed);
+    void seekReplay(qint64 utcMs);
+
 signals:
     void radarConnected(bool connected);
+    // 原始数据报：data 是采集缓冲槽的无拷贝视图（QByteArray::fromRawData），只在槽函数执行期间有效，
+    // 取下一帧时缓冲槽即被回收复用；连接须用 Qt::DirectConnection，要保留内容须深拷贝
+    // （QByteArray(data.constData(), data.size())，直接赋值仍指向缓冲槽）
     void clientMessageReceived(const QByteArray &data);
     void radarDatagramReceived(const QByteArray &data);
+    // 采集线程已解析好的报文（GUI线程发出）
+    void trackReceived(const TrackMessage &msg);
+    // 一轮取队列得到的全部航迹（单航迹帧与批量帧合并，列式存储），界面按批更新
+    void trackBatchReceived(const TrackBatch &batch);
+    void radarStatusReceived(const RadarStatus &status);
+    // 每秒一次的采集统计
+    void ingestStatsUpdated(const IngestStats &stats);
+    // 回放进度（UTC毫秒）与结束统计
+    void replayPositionChanged(qint64 utcMs);
+    void replayFinished(const ReplayStats &stats);
 
 private slots:
-    void onRadarDatagram();
+    void drainIngestQueue();
 
 private:
-    QUdpSocket *m_udpSocket{nullptr};
-    QTimer m_reconnectTimer; // kept for potential periodic tasks
+    QThread m_ingestThread;
+    RadarIngestWorker *m_worker{nullptr}; // 生存在 m_ingestThread 中
+    QTimer m_reconnectTimer;              // kept for potential periodic tasks
+    IngestConfig m_ingestConfig;
+    QTimer m_statsTimer;      // 周期上报采集统计
+    TrackBatch m_drainBatch;  // 每轮复用，保留各列容量
+    IngestFrame m_drainFrame; // 出队时与队列槽交换，内容在两个线程间循环复用
+    quint64 m_lastReportedDrops{0};
+    quint64 m_lastReportedRejects{0};
+    // 上一统计周期的累计值，用于计算每秒批次与平均批填充率
+    quint64 m_lastBatches{0};
+    quint64 m_lastBatchedDatagrams{0};
+    double m_batchesPerSec{0.0};
+    double m_avgBatchFill{0.0};
     QHostAddress m_targetAddr{QHostAddress::LocalHost};
     quint16 m_targetPort{6280};
 };
@@ -0,0 +1,254 @@
+// PhosphorLayer.cpp
+#include "PhosphorLayer.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QtMath>
+#include <cmath>
+
+namespace
+{
+    // 以圆心为顶点、从 fromDeg 顺时针到 toDeg 的扇形（北为0）；Qt 的弧以3点钟为0、逆时针为正
+    QPainterPath wedge(const QRectF &circle, float fromDeg, float toDeg)
+    {
+        QPainterPath path;
+        path.moveTo(circle.center());
+        path.arcTo(circle, 90.0 - qreal(toDeg), qreal(toDeg - fromDeg));
+        path.closeSubpath();
+        return path;
+    }
+
+    // 一段像素按 a/256 压暗：预乘 ARGB 四个通道同乘 a，两两打包在 16 位里一起算；
+    // 截断前加 [0,255] 的抖动（随 x 变化的 Weyl 序列，seed 每行每次不同），平均值即 v·a/256
+    void fadeSpan(quint32 *px, int n, quint32 a, quint32 seed)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const quint32 r = ((quint32(i) * 0x9E3779B1u + seed) >> 24) * 0x00010001u;
+            const quint32 v = px[i];
+            px[i] = ((((v & 0x00ff00ffu) * a + r) >> 8) & 0x00ff00ffu) | ((((v >> 8) & 0x00ff00ffu) * a + r) & 0xff00ff00u);
+        }
+    }
+
+    // 预乘 ARGB 的 src over dst：dst 四个通道同乘 (255-αs)/255（两两打包，按 x·k/255 ≈ (t + t>>8 + 128)>>8 取整）再加 src
+    void overSpan(quint32 *out, const quint32 *src, const quint32 *dst, int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const quint32 s = src[i], d = dst[i];
+            const quint32 k = 255u - (s >> 24);
+            quint32 rb = (d & 0x00ff00ffu) * k;
+            quint32 ag = ((d >> 8) & 0x00ff00ffu) * k;
+            rb = ((rb + ((rb >> 8) & 0x00ff00ffu) + 0x00800080u) >> 8) & 0x00ff00ffu;
+            ag = (ag + ((ag >> 8) & 0x00ff00ffu) + 0x00800080u) & 0xff00ff00u;
+            out[i] = s + (rb | ag);
+        }
+    }
+
+    // 扇环（半径 r0..r1，fromDeg..toDeg，北为0顺时针）的外接矩形：四个角点，加上角度范围内的正北/东/南/西外缘点
+    QRectF sectorBounds(const QPointF &c, qreal r0, qreal r1, float fromDeg, float toDeg)
+    {
+        auto at = [&](qreal r, qreal deg)
+        {
+            const qreal t = qDegreesToRadians(deg);
+            return QPointF(c.x() + r * std::sin(t), c.y() - r * std::cos(t));
+        };
+        const QPointF p0 = at(r0, fromDeg), p1 = at(r0, toDeg), p2 = at(r1, fromDeg), p3 = at(r1, toDeg);
+        qreal x0 = qMin(qMin(p0.x(), p1.x()), qMin(p2.x(), p3.x())), x1 = qMax(qMax(p0.x(), p1.x()), qMax(p2.x(), p3.x()));
+        qreal y0 = qMin(qMin(p0.y(), p1.y()), qMin(p2.y(), p3.y())), y1 = qMax(qMax(p0.y(), p1.y()), qMax(p2.y(), p3.y()));
+        for (int k = int(std::ceil(fromDeg / 90.0f)); k * 90.0f <= toDeg; ++k)
+        {
+            const QPointF q = at(r1, k * 90.0);
+            x0 = qMin(x0, q.x());
+            x1 = qMax(x1, q.x());
+            y0 = qMin(y0, q.y());
+            y1 = qMax(y1, q.y());
+        }
+        return QRectF(QPointF(x0, y0), QPointF(x1, y1));
+    }
+} // namespace
+
+void PhosphorLayer::setGeometry(const QRectF &circle, qreal dpr)
+{
+    if (circle == m_circle && dpr == m_dpr && !m_image.isNull())
+        return;
+    m_circle = circle;
+    m_dpr = dpr;
+    m_pendingMs = 0.0;
+    m_origin = (circle.topLeft() * dpr).toPoint();
+    m_compositeValid = false;
+    m_dirty.clear();
+    const QSize px = (circle.size() * dpr).toSize();
+    if (px.isEmpty())
+    {
+        m_image = QImage();
+        return;
+    }
+    m_image = QImage(px, QImage::Format_ARGB32_Premultiplied);
+    m_image.setDevicePixelRatio(dpr);
+    m_image.fill(Qt::transparent);
+}
+
+void PhosphorLayer::clear()
+{
+    m_pendingMs = 0.0;
+    if (!m_image.isNull())
+    {
+        m_image.fill(Qt::transparent);
+        markDirty(m_image.rect());
+    }
+}
+
+void PhosphorLayer::markDirty(const QRect &r)
+{
+    // 块数有上限：只叠加不合成（没有缓存底图）时不会无限增长
+    if (m_dirty.size() >= MaxDirtyRects)
+        m_compositeValid = false;
+    if (!m_compositeValid)
+    {
+        m_dirty.clear();
+        return;
+    }
+    const QRect clipped = r & m_image.rect();
+    if (!clipped.isEmpty())
+        m_dirty.append(clipped);
+}
+
+void PhosphorLayer::compositeSpan(int y, int x0, int x1)
+{
+    // m_image 的第 y 行 [x0, x1) 叠到底图上，写进合成图；越出底图的部分不管
+    const int fy = m_origin.y() + y;
+    const int fx0 = qMax(0, m_origin.x() + x0), fx1 = qMin(m_composite.width(), m_origin.x() + x1);
+    if (fy < 0 || fy >= m_composite.height() || fx1 <= fx0)
+        return;
+    overSpan(reinterpret_cast<quint32 *>(m_composite.scanLine(fy)) + fx0,
+             reinterpret_cast<const quint32 *>(m_image.constScanLine(y)) + (fx0 - m_origin.x()),
+             reinterpret_cast<const quint32 *>(m_background.constScanLine(fy)) + fx0, fx1 - fx0);
+}
+
+void PhosphorLayer::compositeRect(const QRect &r)
+{
+    for (int y = r.top(); y <= r.bottom(); ++y)
+        compositeSpan(y, r.left(), r.right() + 1);
+}
+
+void PhosphorLayer::fade(quint32 a)
+{
+    // 只处理圆盘（含越出边缘的亮点）覆盖的行段，外接正方形的四角始终透明；
+    // 合成图在同一遍里逐行重算（行还在缓存里），之前记下的脏区随之作废
+    const int w = m_image.width(), h = m_image.height();
+    const qreal c = 0.5 * qreal(w);
+    const qreal r = c + (BlipRadius + 1.0) * m_dpr;
+    m_fadeSeed += 0x632BE5ABu;
+    m_dirty.clear();
+    for (int y = 0; y < h; ++y)
+    {
+        const qreal dy = qreal(y) + 0.5 - 0.5 * qreal(h);
+        const qreal half = std::sqrt(qMax<qreal>(0.0, r * r - dy * dy));
+        const int x0 = qMax(0, int(c - half));
+        const int x1 = qMin(w, int(std::ceil(c + half)));
+        if (x1 <= x0)
+            continue;
+        fadeSpan(reinterpret_cast<quint32 *>(m_image.scanLine(y)) + x0, x1 - x0, a, quint32(y) * 0x85EBCA77u + m_fadeSeed);
+        if (m_compositeValid)
+            compositeSpan(y, x0, x1);
+    }
+}
+
+void PhosphorLayer::stamp(float fromDeg, float toDeg, const QVector<QPointF> &blips, float sweepDegPerSec)
+{
+    const float span = qMin(toDeg - fromDeg, 360.0f);
+    if (m_image.isNull() || span <= 0.0f)
+        return;
+    fromDeg = toDeg - span;
+
+    // 衰减：按扫过这段的时间累计，够一档才整盘压暗；实际压暗量对应的时间从累计中扣除，取整不影响长期衰减率
+    m_pendingMs += double(span) * 1000.0 / double(qMax(1.0f, sweepDegPerSec));
+    const int a = int(256.0 * std::exp(-m_pendingMs / double(m_decayMs)));
+    if (a <= 0)
+    {
+        m_image.fill(Qt::transparent);
+        m_pendingMs = 0.0;
+        markDirty(m_image.rect());
+    }
+    else if (a <= 256 - FadeStep)
+    {
+        fade(quint32(a));
+        m_pendingMs = qMax(0.0, m_pendingMs + double(m_decayMs) * std::log(double(a) / 256.0));
+    }
+
+    QPainter p(&m_image);
+    p.translate(-m_circle.topLeft());
+    // 新扫过的楔形：淡淡的底辉（不抗锯齿，相邻楔形恰好拼满、边界不重复叠加），加上扫描线经过的目标
+    p.fillPath(wedge(m_circle, fromDeg, toDeg), QColor(60, 200, 100, 60));
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(170, 255, 190, 230));
+    for (const QPointF &b : blips)
+        p.drawEllipse(b, BlipRadius, BlipRadius);
+
+    // 脏区（设备像素，各放宽1像素）：宽楔形直接取整盘，窄楔形按半径分段取外接矩形，比一个外接矩形小得多
+    if (!m_compositeValid)
+        return;
+    if (span > 45.0f)
+    {
+        markDirty(m_image.rect());
+    }
+    else
+    {
+        const QPointF c(0.5 * m_image.width(), 0.5 * m_image.height());
+        const qreal R = c.x();
+        for (int i = 0; i < WedgeBands; ++i)
+        {
+            const QRectF b = sectorBounds(c, R * i / WedgeBands, R * (i + 1) / WedgeBands, fromDeg, toDeg);
+            markDirty(b.toAlignedRect().adjusted(-1, -1, 1, 1));
+        }
+    }
+    const qreal br = (BlipRadius + 1.0) * m_dpr;
+    for (const QPointF &b : blips)
+    {
+        const QPointF d = (b - m_circle.topLeft()) * m_dpr;
+        markDirty(QRectF(d.x() - br, d.y() - br, 2 * br, 2 * br).toAlignedRect());
+    }
+}
+
+void PhosphorLayer::drawComposited(QPainter &p, const QImage &background)
+{
+    if (background.format() != QImage::Format_ARGB32_Premultiplied && background.format() != QImage::Format_RGB32)
+    {
+        // 合成按预乘 ARGB 逐像素算；其它格式的底图先转一份（每帧都转，调用方应直接给这两种格式）
+        drawComposited(p, background.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        return;
+    }
+    if (m_image.isNull())
+    {
+        p.drawImage(QPointF(0, 0), background);
+        return;
+    }
+
+    // 换了底图（尺寸、量程、调色板……）：整帧重合成；否则只重算脏区
+    if (!m_compositeValid || background.cacheKey() != m_background.cacheKey())
+    {
+        m_background = background;
+        m_composite = background.copy();
+        m_compositeValid = true;
+        m_dirty.clear();
+        compositeRect(m_image.rect());
+    }
+    else
+    {
+        for (const QRect &r : m_dirty)
+            compositeRect(r);
+        m_dirty.clear();
+    }
+
+    const QPainter::CompositionMode mode = p.compositionMode();
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.drawImage(QPointF(0, 0), m_composite);
+    p.setCompositionMode(mode);
+}
+
+void PhosphorLayer::draw(QPainter &p) const
+{
+    if (!m_image.isNull())
+        p.drawImage(m_circle, m_image);
+}
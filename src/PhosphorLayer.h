@@ -0,0 +1,61 @@
+// PhosphorLayer.h
+#pragma once
+
+#include <QImage>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+class QPainter;
+
+// PPI 余辉（荧光屏）缓冲：
+// - 缓冲里就是当前显示的亮度；有缓存底图时与底图合成为一整帧不透明图，每帧直接贴（不再整盘半透明叠加），
+//   合成图只重算变过的区域：本帧楔形（按半径分段的外接矩形）与目标，压暗那帧在压暗的同一遍里逐行重算；
+// - 每个 tick 在新扫过的楔形里盖上底辉与扫描线经过的目标；衰减按扫过的时间累计，
+//   够一档（1/16）才整盘压暗一次，所以压暗是唯一的衰减来源，不会与其它衰减叠加；
+// - 压暗逐像素按 a/256 缩放并加抖动后截断：低亮度不会卡在某个值上留下残影，平均衰减量准确；
+// - 角度与扫描线一致：北为0，顺时针为正（度）。
+class PhosphorLayer
+{
+public:
+    // 衰减时间常数（毫秒，默认1500）：扫过 decayMs 后亮度降到 1/e
+    void setDecayMs(qint64 ms) { m_decayMs = qMax<qint64>(50, ms); }
+    qint64 decayMs() const { return m_decayMs; }
+
+    // 圆盘位置（逻辑像素）与像素比；变化时重新分配并清空
+    void setGeometry(const QRectF &circle, qreal dpr);
+    void clear();
+
+    // 扫描线从 fromDeg 转到 toDeg（toDeg >= fromDeg，最多一整圈），blips 为这段楔形里的目标（逻辑像素）
+    void stamp(float fromDeg, float toDeg, const QVector<QPointF> &blips, float sweepDegPerSec);
+    // 贴底图与余辉的合成（代替贴底图）：background 为不透明的静态底图，与 p 的设备同尺寸同像素比，
+    // 按 cacheKey 识别是否换了底图（换了才整帧重合成）；用 Source 模式贴，不做混合
+    void drawComposited(QPainter &p, const QImage &background);
+    // 没有缓存底图时：把缓冲半透明叠加到 p 上
+    void draw(QPainter &p) const;
+
+private:
+    static constexpr int FadeStep = 16;      // 累计衰减到 (256-FadeStep)/256 以下才压暗一次
+    static constexpr qreal BlipRadius = 4.0; // 目标亮点半径（逻辑像素）
+    static constexpr int WedgeBands = 8;     // 楔形的脏区按半径分几段取外接矩形
+    static constexpr int MaxDirtyRects = 64; // 脏区超过这么多块就整盘重合成
+
+    void fade(quint32 a);
+    void markDirty(const QRect &r);
+    void compositeSpan(int y, int x0, int x1);
+    void compositeRect(const QRect &r);
+
+    qint64 m_decayMs = 1500;
+    QRectF m_circle;
+    qreal m_dpr{1.0};
+    QImage m_image;       // 覆盖圆盘外接正方形，设备像素
+    double m_pendingMs{}; // 尚未压暗的扫描时间
+    quint32 m_fadeSeed{}; // 抖动图样，每次压暗换一个
+
+    QImage m_background;     // 合成用的底图（与调用方共享数据）
+    QImage m_composite;      // 底图 + 余辉，整帧设备像素
+    QPoint m_origin;         // m_image 左上角在整帧里的设备像素位置
+    bool m_compositeValid{}; // 为 false 时下次整帧重合成
+    QVector<QRect> m_dirty;  // 合成图待重算的区域（m_image 坐标）
+};
@@ -1,6 +1,12 @@
 #include "Protocol.h"
+#include "Checksum.h"
+#include "MessageIds.h"
+#include "TrackMessage.h"
+#include "TrackBatch.h"
+#include "RadarStatus.h"
 #include <QDateTime>
 #include <QtEndian>
+#include <cstring>
 
 namespace Protocol
 {
@@ -21,32 +27,46 @@ namespace Protocol
         ba.append(reinterpret_cast<const char *>(&le), sizeof(le));
     }
 
+    static quint16 rd_u16(const uchar *p) { return qFromLittleEndian<quint16>(p); }
+    static quint32 rd_u32(const uchar *p) { return qFromLittleEndian<quint32>(p); }
+    static quint64 rd_u64(const uchar *p) { return qFromLittleEndian<quint64>(p); }
+
+    bool parseFrameHeader(const uchar *p, int size, FrameHeader &out)
+    {
+        if (!p || size < FrameHeader::Size)
+            return false;
+        memcpy(out.magic, p, 4);
+        out.totalBytes = rd_u16(p + 4);
+        out.deviceModel = rd_u16(p + 6);
+        out.utcMs = rd_u64(p + 8);
+        out.msgIdRadar = rd_u16(p + 16);
+        out.msgIdExternal = rd_u16(p + 18);
+        out.deviceIdRadar = rd_u16(p + 20);
+        out.deviceIdExternal = rd_u16(p + 22);
+        out.reserved = rd_u16(p + 24);
+        out.checkMethod = p[26];
+        out.seq = p[27];
+        out.count = rd_u32(p + 28);
+        return true;
+    }
+
+    bool parseFrameHeader(const QByteArray &payload, FrameHeader &out)
+    {
+        return parseFrameHeader(reinterpret_cast<const uchar *>(payload.constData()), int(payload.size()), out);
+    }
+
     quint16 checksumSum16(const QByteArray &data)
     {
-        quint32 sum = 0;
-        for (unsigned char c : data)
-            sum = (sum + c) & 0xFFFFu;
-        return quint16(sum);
+        return Checksum::sum16(reinterpret_cast<const uchar *>(data.constData()), std::size_t(data.size()));
     }
 
     quint16 checksumCrc16IBM(const QByteArray &data)
     {
-        quint16 crc = 0xFFFF;
-        for (unsigned char b : data)
-        {
-            crc ^= b;
-            for (int i = 0; i < 8; ++i)
-            {
-                if (crc & 1)
-                    crc = (crc >> 1) ^ 0xA001; // 0xA001 = reverse(0x8005)
-                else
-                    crc >>= 1;
-            }
-        }
-        return crc;
+        return Checksum::crc16Ibm(reinterpret_cast<const uchar *>(data.constData()), std::size_t(data.size()));
     }
 
-    static QByteArray buildFrameHead(const HeaderConfig &cfg, quint16 totalBytes, quint8 seq, quint32 count)
+    static QByteArray buildFrameHead(const HeaderConfig &cfg, quint16 totalBytes, quint8 seq, quint32 count,
+                                     quint64 utcMs = 0)
     {
         QByteArray h;
         h.reserve(32);
@@ -60,7 +80,7 @@ namespace Protocol
         // 3. 设备型号（雷达） uint16
         wr_u16(h, cfg.deviceModel);
         // 4. UTC时戳 uint64 ms since epoch
-        const quint64 ms = quint64(QDateTime::currentMSecsSinceEpoch());
+        const quint64 ms = utcMs ? utcMs : quint64(QDateTime::currentMSecsSinceEpoch());
         wr_u64(h, ms);
         // 5. 报文ID（雷达） uint16
         wr_u16(h, cfg.msgIdRadar);
@@ -214,4 +234,143 @@ namespace Protocol
         return packet;
     }
 
+    // 以下为定长上报报文：先按总长分配（全0即预留字段），再按偏移直接写入小端字段
+    template <typename T>
+    static void put(QByteArray &ba, int off, T v)
+    {
+        qToLittleEndian(v, ba.data() + off);
+    }
+    static void putF32(QByteArray &ba, int off, float v)
+    {
+        quint32 bits;
+        memcpy(&bits, &v, sizeof(bits));
+        put(ba, off, bits);
+    }
+    static void putF64(QByteArray &ba, int off, double v)
+    {
+        quint64 bits;
+        memcpy(&bits, &v, sizeof(bits));
+        put(ba, off, bits);
+    }
+
+    static QByteArray beginReport(const HeaderConfig &cfg, quint16 msgId, int total, quint8 seq, quint32 count,
+                                  quint64 utcMs)
+    {
+        HeaderConfig hc = cfg;
+        hc.msgIdRadar = msgId;
+        QByteArray packet = buildFrameHead(hc, quint16(total), seq, count, utcMs);
+        packet.resize(total);
+        memset(packet.data() + 32, 0, size_t(total - 32));
+        return packet;
+    }
+
+    // 计算除末2字节外的校验写入末2字节
+    static void finishReport(QByteArray &packet, quint8 checkMethod)
+    {
+        const uchar *p = reinterpret_cast<const uchar *>(packet.constData());
+        const std::size_t n = std::size_t(packet.size()) - 2;
+        quint16 ck = 0;
+        if (checkMethod == 1)
+            ck = Checksum::sum16(p, n);
+        else if (checkMethod == 2)
+            ck = Checksum::crc16Ibm(p, n);
+        put(packet, int(n), ck);
+    }
+
+    // 6.1 航迹信息（71字节），偏移同 TrackInfoView
+    static void putTrackInfo(QByteArray &ba, int off, const TrackInfo &ti)
+    {
+        put(ba, off + 0, ti.trackId);
+        putF64(ba, off + 2, ti.tgtLon);
+        putF64(ba, off + 10, ti.tgtLat);
+        putF32(ba, off + 18, ti.tgtAlt);
+        putF32(ba, off + 22, ti.distance);
+        putF32(ba, off + 26, ti.azimuth);
+        putF32(ba, off + 30, ti.elevation);
+        putF32(ba, off + 34, ti.speed);
+        putF32(ba, off + 38, ti.course);
+        putF32(ba, off + 42, ti.strength);
+        memcpy(ba.data() + off + 46, ti.reserved4, 4);
+        ba[off + 50] = char(ti.targetType);
+        ba[off + 51] = char(ti.targetSize);
+        ba[off + 52] = char(ti.pointType);
+        ba[off + 53] = char(ti.trackType);
+        ba[off + 54] = char(ti.lostCount);
+        ba[off + 55] = char(ti.quality);
+        putF32(ba, off + 56, ti.rawDistance);
+        putF32(ba, off + 60, ti.rawAzimuth);
+        putF32(ba, off + 64, ti.rawElevation);
+        memcpy(ba.data() + off + 68, ti.reserved3, 3);
+    }
+
+    QByteArray buildTrackPacket(const HeaderConfig &cfg, const TrackMessage &msg, quint8 seq, quint32 count,
+                                quint64 utcMs)
+    {
+        QByteArray packet = beginReport(cfg, ProtocolIds::TrackReport, TrackMessageView::Size, seq, count, utcMs);
+        packet[32] = char(msg.insValid ? 0x01 : 0x00);
+        putF64(packet, 33, msg.radarLon);
+        putF64(packet, 41, msg.radarLat);
+        putF32(packet, 49, msg.radarAlt);
+        putTrackInfo(packet, TrackMessageView::InfoOffset, msg.info);
+        memcpy(packet.data() + 124, msg.reserved16, 16);
+        finishReport(packet, cfg.checkMethod);
+        return packet;
+    }
+
+    QByteArray buildStatusPacket(const HeaderConfig &cfg, const RadarStatus &st, quint8 seq, quint32 count,
+                                 quint64 utcMs)
+    {
+        // 表24 雷达状态报文，偏移同 RadarStatusView
+        QByteArray packet = beginReport(cfg, ProtocolIds::RadarStatusReport, RadarStatusView::Size, seq, count, utcMs);
+        packet[32] = char(st.hwFault);
+        packet[33] = char(st.swFault24 & 0xFF);
+        packet[34] = char((st.swFault24 >> 8) & 0xFF);
+        packet[35] = char((st.swFault24 >> 16) & 0xFF);
+        packet[36] = char(st.workState);
+        packet[37] = char(st.reserved1);
+        put(packet, 38, st.detectRange);
+        packet[40] = char(st.insValid ? 0x01 : 0x00);
+        packet[41] = char(st.simOn ? 0x01 : 0x00);
+        packet[42] = char(st.retracted ? 0x01 : 0x00);
+        packet[43] = char(st.driving ? 0x01 : 0x00);
+        putF64(packet, 44, st.longitude);
+        putF64(packet, 52, st.latitude);
+        putF32(packet, 60, st.altitude);
+        putF32(packet, 64, st.yaw);
+        putF32(packet, 68, st.pitch);
+        putF32(packet, 72, st.roll);
+        memcpy(packet.data() + 76, st.reserved2_8, 8);
+        memcpy(packet.data() + 84, st.verReserved_21, 21);
+        memcpy(packet.data() + 105, st.infoReserved_32, 32);
+        putF32(packet, 137, st.freqGHz);
+        packet[141] = char(st.antPowerMode);
+        memcpy(packet.data() + 142, st.antReserved_16, 16);
+        memcpy(packet.data() + 158, st.chanReserved_8, 8);
+        memcpy(packet.data() + 166, st.servoReserved_16, 16);
+        put(packet, 182, st.silentStart);
+        put(packet, 184, st.silentEnd);
+        memcpy(packet.data() + 186, st.reserved3_12, 12);
+        finishReport(packet, cfg.checkMethod);
+        return packet;
+    }
+
+    QByteArray buildTrackBatchPacket(const HeaderConfig &cfg, const TrackBatch &batch, int first, int n, quint8 seq,
+                                     quint32 count, quint64 utcMs)
+    {
+        first = qBound(0, first, batch.size());
+        // 整帧须放得进一个 UDP 数据报（也就小于16位总长字段的上限）
+        n = qBound(0, n, qMin(batch.size() - first, TrackBatchView::MaxCount));
+        QByteArray packet = beginReport(cfg, ProtocolIds::TrackBatchReport, TrackBatchView::frameSize(n), seq, count,
+                                        utcMs);
+        packet[32] = char(batch.insValid ? 0x01 : 0x00);
+        putF64(packet, 33, batch.radarLon);
+        putF64(packet, 41, batch.radarLat);
+        putF32(packet, 49, batch.radarAlt);
+        put(packet, TrackBatchView::CountOffset, quint16(n));
+        for (int i = 0; i < n; ++i)
+            putTrackInfo(packet, TrackBatchView::RecordsOffset + i * TrackInfoView::Size, batch.row(first + i));
+        finishReport(packet, cfg.checkMethod);
+        return packet;
+    }
+
 } // namespace Protocol
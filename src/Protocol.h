@@ -3,8 +3,15 @@
 #include <QByteArray>
 #include <QtGlobal>
 
+struct TrackMessage;
+struct TrackBatch;
+struct RadarStatus;
+
 namespace Protocol
 {
+    // 单个 UDP 数据报的最大载荷（IPv4：65535 - 20B IP头 - 8B UDP头），接收缓冲槽不小于此值
+    constexpr int MaxDatagramBytes = 65507;
+
     // 帧头配置（除时间戳、总长、序号/计数外其余从UI给定）
     struct HeaderConfig
     {
@@ -16,6 +23,31 @@ namespace Protocol
         quint8 checkMethod = 1;       // 校验方式：0无校验，1和校验，2 CRC16
     };
 
+    // 标准协议帧头 frame_head_t（32字节，小端）
+    struct FrameHeader
+    {
+        static constexpr int Size = 32;
+
+        char magic[4]{};            // "HRGK"
+        quint16 totalBytes{};       // 字节总数
+        quint16 deviceModel{};      // 设备型号
+        quint64 utcMs{};            // UTC时戳 ms
+        quint16 msgIdRadar{};       // 报文ID（雷达），即报文类型标识
+        quint16 msgIdExternal{};    // 报文ID（外部）
+        quint16 deviceIdRadar{};    // 设备ID（雷达）
+        quint16 deviceIdExternal{}; // 设备ID（外部）
+        quint16 reserved{};         // 保留
+        quint8 checkMethod{};       // 0无校验，1和校验，2 CRC16
+        quint8 seq{};               // 报文序号
+        quint32 count{};            // 报文计数
+
+        bool hasMagic() const { return magic[0] == 'H' && magic[1] == 'R' && magic[2] == 'G' && magic[3] == 'K'; }
+    };
+
+    // 解析帧头；长度不足32字节返回false。不校验魔数，由调用方按需判断。
+    bool parseFrameHeader(const uchar *data, int size, FrameHeader &out);
+    bool parseFrameHeader(const QByteArray &payload, FrameHeader &out);
+
     // 构造“雷达搜索任务”完整数据包：
     // 包含32B帧头 + 1B任务类型 + 16B保留(全0) + 2B校验
     QByteArray buildSearchTaskPacket(const HeaderConfig &cfg, quint8 taskType = 0x01);
@@ -32,6 +64,17 @@ namespace Protocol
     // 结构：32B帧头 + 1B目标编号 + 16B保留 + 2B校验
     QByteArray buildHitPacket(const HeaderConfig &cfg, quint8 targetId);
 
+    // 上报报文构造（雷达->本机方向，供 radar_sim 模拟器与基准使用）：
+    // 字节布局与 TrackMessageView / RadarStatusView / TrackBatchView 一致，报文ID固定为对应的上报ID（不用 cfg.msgIdRadar）；
+    // seq/count 由调用方维护，utcMs 为0时取当前时间。
+    QByteArray buildTrackPacket(const HeaderConfig &cfg, const TrackMessage &msg, quint8 seq, quint32 count,
+                                quint64 utcMs = 0);
+    QByteArray buildStatusPacket(const HeaderConfig &cfg, const RadarStatus &status, quint8 seq, quint32 count,
+                                 quint64 utcMs = 0);
+    // 批量航迹报文（0x3003）：取 batch 的第 first 行起 n 行，雷达位置取 batch 的公共信息
+    QByteArray buildTrackBatchPacket(const HeaderConfig &cfg, const TrackBatch &batch, int first, int n, quint8 seq,
+                                     quint32 count, quint64 utcMs = 0);
+
     // 计算和校验与CRC16（LE）
     quint16 checksumSum16(const QByteArray &data);    // 对data全体求和16位
     quint16 checksumCrc16IBM(const QByteArray &data); // CRC-16/IBM (poly 0xA001), 初值0xFFFF
@@ -30,6 +30,32 @@ static QGroupBox *wrapWithTitle(const QString &title, QWidget *inner)
     return box;
 }
 
+namespace
+{
+    // 分组内的顺序：威胁分降序，同分按批号升序（严格全序，可二分定位）；
+    // 键存在列表项上：列0 UserRole 为批号，列1 UserRole 为威胁分
+    bool sortsBefore(float scoreA, quint16 idA, float scoreB, quint16 idB)
+    {
+        return scoreA > scoreB || (scoreA == scoreB && idA < idB);
+    }
+
+    // 分组中第一个不排在 (score, id) 之前的位置
+    int lowerBound(const QTreeWidgetItem *group, float score, quint16 id)
+    {
+        int lo = 0, hi = group->childCount();
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            const QTreeWidgetItem *c = group->child(mid);
+            if (sortsBefore(c->data(1, Qt::UserRole).toFloat(), quint16(c->data(0, Qt::UserRole).toUInt()), score, id))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+} // namespace
+
 RadarConfigWidget::RadarConfigWidget(QWidget *parent)
     : QWidget(parent)
 {
@@ -111,35 +137,8 @@ RadarConfigWidget::RadarConfigWidget(QWidget *parent)
     // 点击选择信号
     connect(targetTree, &QTreeWidget::itemClicked, this, &RadarConfigWidget::onTargetTreeItemClicked);
 
-    // 清理过期目标（30s）
-    targetCleanupTimer.setInterval(30000);
-    connect(&targetCleanupTimer, &QTimer::timeout, this, [this]
-            {
-        const qint64 now = QDateTime::currentMSecsSinceEpoch();
-        const qint64 keepMs = 60000; // 1min
-        QList<quint16> toRemove;
-        for (auto it = m_targets.begin(); it != m_targets.end(); ++it) {
-            if (now - it.value().lastMs > keepMs) toRemove.append(it.key());
-        }
-        if (!toRemove.isEmpty()) {
-            // remove from tree
-            auto root = targetTree->invisibleRootItem();
-            for (quint16 id : toRemove) {
-                // search all children
-                for (int gi = 0; gi < root->childCount(); ++gi) {
-                    auto *g = root->child(gi);
-                    for (int i = 0; i < g->childCount(); ++i) {
-                        auto *it = g->child(i);
-                        if (it->data(0, Qt::UserRole).toUInt() == id) {
-                            g->removeChild(it);
-                            break;
-                        }
-                    }
-                }
-                m_targets.remove(id);
-            }
-        } });
-    targetCleanupTimer.start();
+    // 目标数据源：自带一个模型，可用 setTrackModel 换成与雷达盘共用的模型（过期清理由模型负责）
+    setTrackModel(new TrackModel(this));
 
     // Connections
     connect(clearLogBtn, &QPushButton::clicked, this, [this]()
@@ -298,131 +297,71 @@ void RadarConfigWidget::onRadarDatagramReceived(const QByteArray &data)
         QString msg = QString("[RADAR->APP] %1 (len=%2 bytes)").arg(QDateTime::currentDateTime().toString(Qt::ISODate)).arg(data.size());
         appendLog(msg);
     }
+}
 
-    // Try parse track message and update target grouping
-    if (!TrackParser::hasReadableMagic(data))
-        return;
-    TrackMessage msg;
-    if (!TrackParser::parseLittleEndian(data, msg))
+void RadarConfigWidget::setTrackModel(TrackModel *model)
+{
+    if (!model || model == m_model)
         return;
-
-    // (不再在日志中记录轨迹解析摘要)
-
-    // Compute threat score using simplified logic from RadarScopeWidget
-    // distance normalization (closer => higher)
-    float maxRange = 5000.0f; // assume default if not known from status
-    float dnorm = 1.0f - qBound(0.0f, msg.info.distance / maxRange, 1.0f);
-    // speed normalization (higher => higher)
-    float maxSpeed = 100.0f;
-    float snorm = qBound(0.0f, qAbs(msg.info.speed) / maxSpeed, 1.0f);
-    // type factor mapping (unknown=1, rotor=0.3, fixed=0.3, heli=0.6, civil=0.7, vehicle=0.6)
-    float typeFactor = 1.0f;
-    switch (msg.info.targetType)
+    if (m_model)
     {
-    case 0:
-        typeFactor = 1.0f;
-        break;
-    case 1:
-        typeFactor = 0.3f;
-        break;
-    case 2:
-        typeFactor = 0.3f;
-        break;
-    case 3:
-        typeFactor = 0.6f;
-        break;
-    case 4:
-        typeFactor = 0.7f;
-        break;
-    case 5:
-        typeFactor = 0.6f;
-        break;
-    default:
-        typeFactor = 1.0f;
-        break;
+        disconnect(m_model, nullptr, this, nullptr);
+        if (m_model->parent() == this)
+            m_model->deleteLater();
     }
-    float tnorm = 1.0f - qBound(0.0f, typeFactor / 1.0f, 1.0f);
-    float idnorm = (msg.info.targetType != 0) ? 0.0f : 1.0f;
-    // weights: distance 0.3 speed 0.3 type 0.2 identity 0.2
-    float score = 0.3f * dnorm + 0.3f * snorm + 0.2f * tnorm + 0.2f * idnorm;
-    score = qBound(0.0f, score, 1.0f);
-
-    // update target store
-    const quint16 tid = msg.info.trackId;
-    const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    TargetInfo ti;
-    ti.id = tid;
-    ti.lastScore = score;
-    ti.lastDistance = msg.info.distance;
-    ti.lastMs = now;
-    // If out of current detect range, remove if exists and skip adding
-    if (msg.info.distance > m_currentDetectRange)
-    {
-        m_targets.remove(tid);
-        // remove from tree if present
-        auto root = targetTree->invisibleRootItem();
-        for (int gi = 0; gi < root->childCount(); ++gi)
-        {
-            auto *g = root->child(gi);
-            for (int i = g->childCount() - 1; i >= 0; --i)
-            {
-                auto *it = g->child(i);
-                if (it->data(0, Qt::UserRole).toUInt() == tid)
-                {
-                    g->removeChild(it);
-                }
-            }
-        }
-        // update counts
-        // (we'll update group labels below after insertion/removal)
-        return;
-    }
-    m_targets[tid] = ti;
+    m_model = model;
+    connect(m_model, &TrackModel::changed, this, &RadarConfigWidget::onModelChanged);
+    rebuildTargets();
+}
+
+void RadarConfigWidget::onModelChanged(const TrackChangeSet &changes)
+{
+    // 删除 -> 新增 -> 更新（各项在更新时二分插入到位）；分组计数整批只刷新一次
+    for (quint16 id : changes.removed)
+        eraseTarget(id);
+    for (quint16 id : changes.added)
+        updateTarget(*m_model->find(id));
+    for (quint16 id : changes.updated)
+        updateTarget(*m_model->find(id));
+    refreshTargetGroups();
+}
+
+void RadarConfigWidget::rebuildTargets()
+{
+    QVector<quint16> ids;
+    for (int i = 0; i < m_targets.size(); ++i)
+        ids.append(m_targets.idAt(i));
+    for (quint16 id : ids)
+        eraseTarget(id);
+    for (const TrackModel::Track &t : m_model->tracks())
+        updateTarget(t);
+    refreshTargetGroups();
+}
+
+void RadarConfigWidget::updateTarget(const TrackModel::Track &t)
+{
+    // 威胁分、分级、量程判定都由模型完成，这里只把列表项放到对应分组的排序位置
+    const quint16 tid = t.id;
+    const float score = t.score;
+    TargetItem &ti = m_targets.insert(tid);
 
-    // find and/or move tree item
-    auto root = targetTree->invisibleRootItem();
-    QTreeWidgetItem *foundItem = nullptr;
-    QTreeWidgetItem *foundGroup = nullptr;
-    for (int gi = 0; gi < root->childCount(); ++gi)
+    // target group = threat tier (0 first, 1 second, 2 third)
+    const int groupIndex = t.tier;
+    if (ti.item && ti.group == groupIndex && ti.score == score)
+        return; // 位置不变
+
+    if (ti.item)
     {
-        auto *g = root->child(gi);
-        for (int i = 0; i < g->childCount(); ++i)
-        {
-            auto *it = g->child(i);
-            if (it->data(0, Qt::UserRole).toUInt() == tid)
-            {
-                foundItem = it;
-                foundGroup = g;
-                break;
-            }
-        }
-        if (foundItem)
-            break;
+        detachTarget(tid, ti);
     }
-
-    // determine target group
-    int groupIndex = 0;
-    if (score >= 0.7f)
-        groupIndex = 2; // third
-    else if (score >= 0.3f)
-        groupIndex = 1; // second
     else
-        groupIndex = 0; // first
-    auto *targetGroup = root->child(groupIndex);
-
-    // if found and group changed, remove from old
-    if (foundItem && foundGroup && foundGroup != targetGroup)
     {
-        foundGroup->removeChild(foundItem);
-        foundItem = nullptr;
+        ti.item = new QTreeWidgetItem();
+        ti.item->setText(0, QString::number(tid));
+        ti.item->setData(0, Qt::UserRole, QVariant::fromValue<uint>(tid));
     }
-
-    if (!foundItem)
+    if (ti.group != groupIndex)
     {
-        auto *it = new QTreeWidgetItem();
-        it->setText(0, QString::number(tid));
-        it->setText(1, QString::number(score, 'f', 2));
-        it->setData(0, Qt::UserRole, QVariant::fromValue<uint>(tid));
         // set color by group
         QColor fg;
         if (groupIndex == 2)
@@ -431,93 +370,63 @@ void RadarConfigWidget::onRadarDatagramReceived(const QByteArray &data)
             fg = QColor(220, 180, 60); // orange-ish
         else
             fg = QColor(120, 200, 255); // blue-ish
-        it->setForeground(0, fg);
-        it->setForeground(1, fg);
-        targetGroup->addChild(it);
-    }
-    else
-    {
-        foundItem->setText(1, QString::number(score, 'f', 2));
+        ti.item->setForeground(0, fg);
+        ti.item->setForeground(1, fg);
+        ti.group = groupIndex;
     }
-    // after any change: sort children of each group by score desc and update group titles with counts
-    auto root2 = targetTree->invisibleRootItem();
+    ti.score = score;
+    ti.item->setText(1, QString::number(score, 'f', 2));
+    ti.item->setData(1, Qt::UserRole, score);
+    // 二分找到插入位置，只移动这一项
+    auto *targetGroup = targetTree->invisibleRootItem()->child(groupIndex);
+    targetGroup->insertChild(lowerBound(targetGroup, score, tid), ti.item);
+    m_dirtyGroups |= 1u << groupIndex;
+}
+
+void RadarConfigWidget::detachTarget(quint16 tid, const TargetItem &ti)
+{
+    auto *g = targetTree->invisibleRootItem()->child(ti.group);
+    int pos = lowerBound(g, ti.score, tid);
+    if (pos >= g->childCount() || g->child(pos) != ti.item)
+        pos = g->indexOfChild(ti.item); // 不应发生：键与列表项不一致时退回线性查找
+    g->takeChild(pos);
+    m_dirtyGroups |= 1u << ti.group;
+}
+
+void RadarConfigWidget::refreshTargetGroups()
+{
+    // 只刷新本批有项进出的分组的计数；分组由空变为有目标时展开（之后保留用户的折叠状态）
+    static const char *const baseLabels[] = {QT_TR_NOOP("一级 威胁 0.00-0.30"), QT_TR_NOOP("二级 威胁 0.30-0.70"),
+                                             QT_TR_NOOP("三级 威胁 0.70-1.00")};
+    auto *root2 = targetTree->invisibleRootItem();
     for (int gi = 0; gi < root2->childCount(); ++gi)
     {
+        if (!(m_dirtyGroups & (1u << gi)))
+            continue;
         auto *g = root2->child(gi);
-        // collect children with scores
-        QVector<QPair<float, QTreeWidgetItem *>> arr;
-        for (int i = 0; i < g->childCount(); ++i)
-        {
-            auto *c = g->child(i);
-            float sc = c->text(1).toFloat();
-            arr.append({sc, c});
-        }
-        std::sort(arr.begin(), arr.end(), [](const QPair<float, QTreeWidgetItem *> &a, const QPair<float, QTreeWidgetItem *> &b)
-                  { return a.first > b.first; });
-        g->takeChildren();
-        for (auto &p : arr)
-            g->addChild(p.second);
-        // update group label with count
-        int count = g->childCount();
-        QString baseLabel;
-        if (gi == 0)
-            baseLabel = tr("一级 威胁 0.00-0.30");
-        else if (gi == 1)
-            baseLabel = tr("二级 威胁 0.30-0.70");
-        else
-            baseLabel = tr("三级 威胁 0.70-1.00");
-        g->setText(0, QString("%1 (%2)").arg(baseLabel).arg(count));
+        const int count = g->childCount();
+        if (count > 0 && m_groupCounts[gi] == 0)
+            g->setExpanded(true);
+        m_groupCounts[gi] = count;
+        g->setText(0, QString("%1 (%2)").arg(tr(baseLabels[gi])).arg(count));
     }
-    targetTree->expandAll();
+    m_dirtyGroups = 0;
+}
+
+void RadarConfigWidget::eraseTarget(quint16 tid)
+{
+    const TargetItem *t = m_targets.find(tid);
+    if (!t)
+        return;
+    detachTarget(tid, *t);
+    delete t->item;
+    m_targets.remove(tid);
 }
 
 void RadarConfigWidget::onRadarStatusUpdated(const RadarStatus &s)
 {
     m_isRetracted = s.retracted;
-    // update current detect range and remove targets beyond it
-    if (s.detectRange > 0)
-        m_currentDetectRange = float(s.detectRange);
-    // remove any stored targets beyond new range
-    QList<quint16> toRemove;
-    for (auto it = m_targets.begin(); it != m_targets.end(); ++it)
-    {
-        if (it.value().lastDistance > m_currentDetectRange)
-            toRemove.append(it.key());
-    }
-    if (!toRemove.isEmpty())
-    {
-        auto root = targetTree->invisibleRootItem();
-        for (quint16 id : toRemove)
-        {
-            for (int gi = 0; gi < root->childCount(); ++gi)
-            {
-                auto *g = root->child(gi);
-                for (int i = g->childCount() - 1; i >= 0; --i)
-                {
-                    auto *it = g->child(i);
-                    if (it->data(0, Qt::UserRole).toUInt() == id)
-                    {
-                        g->removeChild(it);
-                    }
-                }
-            }
-            m_targets.remove(id);
-        }
-        // update group labels counts
-        for (int gi = 0; gi < targetTree->invisibleRootItem()->childCount(); ++gi)
-        {
-            auto *g = targetTree->invisibleRootItem()->child(gi);
-            int count = g->childCount();
-            QString baseLabel;
-            if (gi == 0)
-                baseLabel = tr("一级 威胁 0.00-0.30");
-            else if (gi == 1)
-                baseLabel = tr("二级 威胁 0.30-0.70");
-            else
-                baseLabel = tr("三级 威胁 0.70-1.00");
-            g->setText(0, QString("%1 (%2)").arg(baseLabel).arg(count));
-        }
-    }
+    // 探测量程之外的目标由模型删除（量程由主程序设置到共享模型）
 }
 
 // Per-section send handlers: build that section's JSON, emit signal and show in preview
@@ -612,15 +521,14 @@ void RadarConfigWidget::onTargetTreeItemClicked(QTreeWidgetItem *item, int colum
     if (id == 0)
         return; // groups stored with no id
     m_selectedTargetId = quint16(id);
-    // populate detail labels from m_targets if possible
-    if (m_targets.contains(m_selectedTargetId))
+    // populate detail labels from the track model if possible
+    if (const TrackModel::Track *t = m_model->find(m_selectedTargetId))
     {
-        auto t = m_targets.value(m_selectedTargetId);
-        detailIdLabel->setText(QString::number(t.id));
-        detailScoreLabel->setText(QString::number(t.lastScore, 'f', 2));
-        detailDistLabel->setText(QString::number(t.lastDistance, 'f', 1));
-        // type not stored here; leave as '-' or enhance to store
-        detailTypeLabel->setText("-");
+        detailIdLabel->setText(QString::number(t->id));
+        detailScoreLabel->setText(QString::number(t->score, 'f', 2));
+        detailDistLabel->setText(QString::number(t->distance, 'f', 1));
+        // 类型编码同 TrackInfo::targetType
+        detailTypeLabel->setText(QString::number(t->targetType));
     }
     else
     {
@@ -634,32 +542,18 @@ void RadarConfigWidget::onTargetTreeItemClicked(QTreeWidgetItem *item, int colum
 
 void RadarConfigWidget::removeTargetById(quint16 id)
 {
-    if (m_targets.contains(id))
-        m_targets.remove(id);
-    // remove from tree
-    auto root = targetTree->invisibleRootItem();
-    for (int gi = 0; gi < root->childCount(); ++gi)
-    {
-        auto *g = root->child(gi);
-        for (int i = g->childCount() - 1; i >= 0; --i)
-        {
-            auto *it = g->child(i);
-            if (it->data(0, Qt::UserRole).toUInt() == id)
-            {
-                g->removeChild(it);
-            }
-        }
-        // update group label counts
-        int count = g->childCount();
-        QString baseLabel;
-        if (gi == 0)
-            baseLabel = tr("一 级 威胁 0.00-0.30");
-        else if (gi == 1)
-            baseLabel = tr("二 级 威胁 0.30-0.70");
-        else
-            baseLabel = tr("三 级 威胁 0.70-1.00");
-        g->setText(0, QString("%1 (%2)").arg(baseLabel).arg(count));
-    }
+    // 模型发布删除后由 onModelChanged 移除列表项并刷新计数
+    m_model->remove(id);
+}
+
+void RadarConfigWidget::selectTarget(quint16 id)
+{
+    const TargetItem *ti = m_targets.find(id);
+    if (!ti || !ti->item)
+        return;
+    targetTree->setCurrentItem(ti->item);
+    targetTree->scrollToItem(ti->item);
+    onTargetTreeItemClicked(ti->item, 0);
 }
 
 void RadarConfigWidget::appendLog(const QString &msg)
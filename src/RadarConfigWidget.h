@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include "RadarStatus.h"
+#include "TrackModel.h"
 #include <QGroupBox>
 #include <QTreeWidget>
 #include <QTimer>
@@ -28,12 +29,19 @@ public:
     void setLogIncoming(bool on) { m_logIncoming = on; }
     bool logIncoming() const { return m_logIncoming; }
 
+    // 目标列表的数据源（默认自带一个模型；与雷达盘共用时传入共享模型，不转移所有权）
+    void setTrackModel(TrackModel *model);
+    TrackModel *trackModel() const { return m_model; }
+
 public slots:
+    // 原始报文：仅用于接收日志（航迹更新来自 TrackModel）
     void onRadarDatagramReceived(const QByteArray &data);
     // 从外部更新解析后的雷达状态（用于决定是否允许搜索）
     void onRadarStatusUpdated(const RadarStatus &s);
-    // 当雷达盘通知目标被击毁时，移除右侧面板中的目标显示
+    // 目标被击毁：从模型删除（列表随模型变化移除）
     void removeTargetById(quint16 id);
+    // 外部（如雷达盘点选）选中目标：选中列表项并显示详情
+    void selectTarget(quint16 id);
 
 private slots:
     void onApply();
@@ -46,6 +54,8 @@ private slots:
     // removed: onSendPower()
     void onSendDeploy();
     void onTargetTreeItemClicked(QTreeWidgetItem *item, int column);
+    // 模型发布的一批变化：增删改列表项，整批排序一次
+    void onModelChanged(const TrackChangeSet &changes);
 
 private:
     // UI builders
@@ -58,6 +68,17 @@ private:
     QGroupBox *buildDeploySection();
 
     void setDefaults();
+    // 按模型中的航迹更新列表项：分组或威胁分变了才移动，二分插入到分组内的排序位置（计数由调用方刷新）
+    void updateTarget(const TrackModel::Track &t);
+    // 刷新有变化分组的计数
+    void refreshTargetGroups();
+    // 删除目标的列表项（分组计数由调用方刷新）
+    void eraseTarget(quint16 tid);
+    // 把列表项从所在分组摘下（按旧键二分定位）
+    struct TargetItem;
+    void detachTarget(quint16 tid, const TargetItem &ti);
+    // 按模型全量重建列表
+    void rebuildTargets();
     QJsonObject gatherConfigJson() const;
 
     // Widgets per section
@@ -106,18 +127,18 @@ public:
 
     // 目标分组面板（右侧实时目标列表）
     QTreeWidget *targetTree{}; // 顶层有3个组：一级/二级/三级
-    QTimer targetCleanupTimer; // 清理过期目标
 
-    struct TargetInfo
+    // 目标状态（距离、威胁分、过期）都在模型中，这里只记每个目标的列表项
+    struct TargetItem
     {
-        quint16 id{0};
-        float lastScore{0.0f};
-        qint64 lastMs{0};
-        float lastDistance{0.0f};
+        QTreeWidgetItem *item{nullptr}; // 列表项，由所在分组持有
+        int group{-1};                  // 所在分组 0..2
+        float score{};                  // 排序用的威胁分（与列表项上的键一致）
     };
-    QHash<quint16, TargetInfo> m_targets; // keyed by track id
-    // 当前已知雷达探测量程（由状态报文更新）
-    float m_currentDetectRange = 5000.0f;
+    TrackTable<TargetItem> m_targets; // keyed by track id
+    quint32 m_dirtyGroups{0};         // 本批有项进出的分组（位）
+    int m_groupCounts[3]{};           // 上次刷新时各分组的目标数
+    TrackModel *m_model{nullptr};
     // 当前选中目标（0表示无）
     quint16 m_selectedTargetId = 0;
     // 打击操作区控件
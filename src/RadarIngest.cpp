@@ -0,0 +1,443 @@
+// RadarIngest.cpp
+#include "RadarIngest.h"
+#include "Checksum.h"
+#include <QUdpSocket>
+#include <QSocketNotifier>
+#include <QDebug>
+#include <QLoggingCategory>
+#include <cstring>
+
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// 发送明细（每条命令一行 + 十六进制转储），默认关闭；联调时用 QT_LOGGING_RULES="radar.tx.debug=true" 打开
+Q_LOGGING_CATEGORY(lcRadarTx, "radar.tx", QtInfoMsg)
+
+namespace
+{
+    QString hexDump(const QByteArray &data, int bytesPerLine = 16)
+    {
+        QString out;
+        const int n = data.size();
+        for (int i = 0; i < n; i += bytesPerLine)
+        {
+            // 偏移
+            out += QString("%1: ").arg(i, 6, 16, QLatin1Char('0')).toUpper();
+            // HEX
+            for (int j = 0; j < bytesPerLine; ++j)
+            {
+                if (i + j < n)
+                    out += QString("%1 ").arg(quint8(data[i + j]), 2, 16, QLatin1Char('0')).toUpper();
+                else
+                    out += "   ";
+                if (j == bytesPerLine / 2 - 1)
+                    out += " "; // 中间再加一个空格
+            }
+            // ASCII
+            out += " |";
+            for (int j = 0; j < bytesPerLine && i + j < n; ++j)
+            {
+                uchar c = uchar(data[i + j]);
+                out += (c >= 32 && c <= 126) ? QChar(c) : QChar('.');
+            }
+            out += "|\n";
+        }
+        return out;
+    }
+} // namespace
+
+struct RadarIngestWorker::BatchState
+{
+#if defined(Q_OS_LINUX)
+    QVector<mmsghdr> msgs;
+    QVector<iovec> iovs;
+#endif
+};
+
+RadarIngestWorker::RadarIngestWorker(quint16 localPort, const IngestConfig &config, QObject *parent)
+    : QObject(parent),
+      m_localPort(localPort),
+      m_config(config),
+      m_pool(config.poolSize, qMax(config.slotBytes, Protocol::MaxDatagramBytes)),
+      m_queue(std::size_t(qMax(2, config.queueCapacity)))
+{
+    m_config.batchSize = qBound(1, m_config.batchSize, 1024);
+    m_config.slotBytes = m_pool.slotBytes();
+    m_dispatcher.setVerifyChecksums(m_config.verifyChecksums);
+    // 记录器在构造时建好（stats() 会从GUI线程读取），之后只在采集线程写入
+    if (!m_config.recorder.directory.isEmpty())
+    {
+        m_recorder.reset(new DatagramRecorder(m_config.recorder));
+        qDebug() << "Recording datagrams to" << m_config.recorder.directory;
+    }
+    // 帧要跨线程交给GUI，这里把视图展开到帧内的定长结构体（不分配内存）
+    m_dispatcher.subscribeTrack([this](const Protocol::FrameHeader &, const TrackMessageView &view)
+                                {
+        view.toMessage(m_staging.track);
+        m_staging.hasTrack = true; });
+    m_dispatcher.subscribeStatus([this](const Protocol::FrameHeader &, const RadarStatusView &view)
+                                 {
+        view.toStatus(m_staging.status);
+        m_staging.hasStatus = true; });
+    // 批量航迹整帧解码为列式批，再整批做范围校验；批是从队列换回的旧帧里的，容量够时不分配
+    m_dispatcher.subscribeTrackBatch([this](const Protocol::FrameHeader &, const TrackBatchView &view)
+                                     {
+        TrackBatch &batch = m_staging.batch;
+        batch.reserve(view.count());
+        view.appendTo(batch);
+        m_invalidRecords.fetch_add(quint64(batch.removeInvalid()), std::memory_order_relaxed);
+        m_batchRecords.fetch_add(quint64(batch.size()), std::memory_order_relaxed);
+        m_staging.hasBatch = true; });
+}
+
+RadarIngestWorker::~RadarIngestWorker()
+{
+#if defined(Q_OS_LINUX)
+    if (m_fd >= 0)
+        ::close(m_fd);
+#endif
+    delete m_batchState;
+}
+
+void RadarIngestWorker::start()
+{
+    if (m_udpSocket || m_fd >= 0)
+        return;
+#if defined(Q_OS_LINUX)
+    if (m_config.batchedReceive)
+    {
+        const bool ok = openBatchedSocket();
+        emit bindFinished(ok);
+        return;
+    }
+#endif
+    // 在采集线程中创建，socket 的事件通知也在本线程处理
+    m_udpSocket = new QUdpSocket(this);
+    if (!m_udpSocket->bind(QHostAddress::AnyIPv4, m_localPort, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+    {
+        qWarning() << "Failed to bind UDP on" << m_localPort;
+        emit bindFinished(false);
+        return;
+    }
+    if (m_config.recvBufferBytes > 0)
+        m_udpSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, m_config.recvBufferBytes);
+    qDebug() << "Bound UDP recv on" << m_localPort << "(ingest thread)";
+    connect(m_udpSocket, &QUdpSocket::readyRead, this, &RadarIngestWorker::onReadyRead);
+    emit bindFinished(true);
+}
+
+bool RadarIngestWorker::openBatchedSocket()
+{
+#if defined(Q_OS_LINUX)
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        qWarning() << "Failed to create UDP socket:" << strerror(errno);
+        return false;
+    }
+    // 与 QUdpSocket::ShareAddress | ReuseAddressHint 一致
+    const int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (m_config.recvBufferBytes > 0)
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &m_config.recvBufferBytes, sizeof(m_config.recvBufferBytes));
+
+    sockaddr_in sa{};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(m_localPort);
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&sa), sizeof(sa)) != 0)
+    {
+        qWarning() << "Failed to bind UDP on" << m_localPort << strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;
+
+    // 批量接收用的结构体一次性分配，之后每批只改写长度
+    m_batchState = new BatchState;
+    m_batchState->msgs.resize(m_config.batchSize);
+    m_batchState->iovs.resize(m_config.batchSize);
+    m_batch.resize(m_config.batchSize);
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &RadarIngestWorker::onBatchReadable);
+    qDebug() << "Bound UDP recv on" << m_localPort << "(ingest thread, recvmmsg batch" << m_config.batchSize
+             << "pool" << m_pool.slotCount() << "x" << m_pool.slotBytes() << "B)";
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RadarIngestWorker::sendDatagram(const QByteArray &data, const QHostAddress &addr, quint16 port)
+{
+    if (!m_udpSocket && m_fd < 0)
+        return;
+    qint64 written = -1;
+    QString err;
+#if defined(Q_OS_LINUX)
+    if (m_fd >= 0)
+    {
+        sockaddr_in sa{};
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons(port);
+        sa.sin_addr.s_addr = htonl(addr.toIPv4Address());
+        written = ::sendto(m_fd, data.constData(), size_t(data.size()), 0, reinterpret_cast<const sockaddr *>(&sa), sizeof(sa));
+        if (written < 0)
+            err = QString::fromLocal8Bit(strerror(errno));
+    }
+#endif
+    if (m_udpSocket)
+    {
+        written = m_udpSocket->writeDatagram(data, addr, port);
+        if (written < 0)
+            err = m_udpSocket->errorString();
+    }
+    if (written <= 0)
+        qWarning() << "Failed to send UDP to radar" << addr.toString() << port << "err=" << err;
+    else
+    {
+        if (m_recorder)
+            m_recorder->append(RecordFormat::Tx, data.constData(), int(data.size()), DatagramRecorder::monotonicNs());
+        // qCDebug 在类别关闭时不求值参数，发送路径上不做转储
+        qCDebug(lcRadarTx) << "UDP sent to" << addr << port << "len=" << written;
+        qCDebug(lcRadarTx).noquote() << hexDump(data);
+    }
+}
+
+void RadarIngestWorker::onReadyRead()
+{
+    while (m_udpSocket && m_udpSocket->hasPendingDatagrams())
+    {
+        DatagramRef buf = m_pool.acquire();
+        if (buf.isNull())
+        {
+            // 池耗尽：读出并丢弃，避免内核缓冲积压
+            char scratch[1];
+            m_udpSocket->readDatagram(scratch, sizeof(scratch));
+            m_poolExhausted.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        const qint64 pending = m_udpSocket->pendingDatagramSize();
+        const qint64 n = m_udpSocket->readDatagram(buf.writableData(), buf.capacity());
+        if (n < 0)
+            continue;
+        if (pending > buf.capacity())
+        {
+            m_truncated.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        buf.setSize(int(n));
+        processDatagram(std::move(buf), DatagramRecorder::monotonicNs());
+    }
+}
+
+void RadarIngestWorker::onBatchReadable()
+{
+#if defined(Q_OS_LINUX)
+    auto &msgs = m_batchState->msgs;
+    auto &iovs = m_batchState->iovs;
+    const int batchSize = m_config.batchSize;
+    for (;;)
+    {
+        // 为本批取得缓冲槽
+        int n = 0;
+        while (n < batchSize)
+        {
+            m_batch[n] = m_pool.acquire();
+            if (m_batch[n].isNull())
+                break;
+            iovs[n].iov_base = m_batch[n].writableData();
+            iovs[n].iov_len = size_t(m_batch[n].capacity());
+            msgs[n] = mmsghdr{};
+            msgs[n].msg_hdr.msg_iov = &iovs[n];
+            msgs[n].msg_hdr.msg_iovlen = 1;
+            ++n;
+        }
+        if (n == 0)
+        {
+            // 池耗尽：读出并丢弃一个数据报，避免电平触发的读通知空转
+            char scratch[1];
+            if (::recv(m_fd, scratch, sizeof(scratch), MSG_DONTWAIT | MSG_TRUNC) < 0)
+                return;
+            m_poolExhausted.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        const int got = ::recvmmsg(m_fd, msgs.data(), unsigned(n), MSG_DONTWAIT, nullptr);
+        if (got <= 0)
+        {
+            for (int i = 0; i < n; ++i)
+                m_batch[i].reset();
+            if (got < 0 && errno == EINTR)
+                continue;
+            return; // EAGAIN：已读空
+        }
+        m_recvBatches.fetch_add(1, std::memory_order_relaxed);
+        const qint64 rxNs = DatagramRecorder::monotonicNs();
+
+        for (int i = 0; i < got; ++i)
+        {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                m_truncated.fetch_add(1, std::memory_order_relaxed);
+                m_batch[i].reset();
+                continue;
+            }
+            m_batch[i].setSize(int(msgs[i].msg_len));
+            processDatagram(std::move(m_batch[i]), rxNs);
+        }
+        // 未用上的槽直接归还
+        for (int i = got; i < n; ++i)
+            m_batch[i].reset();
+        if (got < n)
+            return; // 本次已读空，等待下一次读通知
+    }
+#endif
+}
+
+void RadarIngestWorker::processDatagram(DatagramRef &&buf, qint64 rxNs, bool record)
+{
+    m_datagrams.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(quint64(buf.size()), std::memory_order_relaxed);
+    // 先记录原始字节（只是拷贝进映射段），再解析
+    if (record && m_recorder)
+        m_recorder->append(RecordFormat::Rx, buf.data(), buf.size(), rxNs);
+
+    IngestFrame &frame = m_staging;
+    frame.buffer = std::move(buf);
+    frame.raw = frame.buffer.bytes();
+    frame.hasTrack = false;
+    frame.hasStatus = false;
+    frame.hasBatch = false;
+    frame.batch.clear(); // 保留各列容量
+    // 每个数据报只在采集线程按报文ID解码一次，GUI线程直接使用结果
+    frame.kind = m_dispatcher.dispatch(frame.raw);
+    m_resultCounts[int(frame.kind)].fetch_add(1, std::memory_order_relaxed);
+    if (frame.kind == MessageDispatcher::Result::BadChecksum)
+    {
+        // 帧头已通过解析，校验方式字节可直接读取
+        if (quint8(frame.buffer.data()[26]) == Checksum::Sum16)
+            m_badSum16.fetch_add(1, std::memory_order_relaxed);
+        else
+            m_badCrc16.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 与队列槽交换：frame 换回消费者用过的旧帧（缓冲槽已归还），下次解码复用
+    if (!m_queue.tryPushSwap(frame))
+    {
+        // GUI处理不过来：丢弃最新帧，保证接收不阻塞
+        frame.release();
+        m_queueDrops.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const int depth = int(m_queue.size());
+    if (depth > m_queueHighWater.load(std::memory_order_relaxed))
+        m_queueHighWater.store(depth, std::memory_order_relaxed);
+
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel))
+        emit framesReady();
+}
+
+void RadarIngestWorker::startReplay(const QString &path, double speed, qint64 startUtcMs)
+{
+    if (!m_replay)
+    {
+        m_replay = new RadarReplay([this](const RecordingReader::Record &rec)
+                                   { return feedReplay(rec); },
+                                   this);
+        connect(m_replay, &RadarReplay::positionChanged, this, &RadarIngestWorker::replayPosition);
+        connect(m_replay, &RadarReplay::finished, this, &RadarIngestWorker::replayFinished);
+    }
+    if (!m_replay->open(path))
+    {
+        qWarning() << "Replay failed:" << m_replay->errorString();
+        emit replayFinished(m_replay->stats());
+        return;
+    }
+    const RecordingReader &reader = m_replay->reader();
+    qDebug() << "Replaying" << reader.recordCount() << "records from" << reader.segmentCount() << "segments, speed"
+             << speed;
+    m_replay->setSpeed(speed);
+    if (startUtcMs > 0)
+        m_replay->seek(startUtcMs);
+    m_replay->start();
+}
+
+void RadarIngestWorker::stopReplay()
+{
+    if (m_replay)
+        m_replay->pause();
+}
+
+void RadarIngestWorker::setReplaySpeed(double speed)
+{
+    if (m_replay)
+        m_replay->setSpeed(speed);
+}
+
+void RadarIngestWorker::seekReplay(qint64 utcMs)
+{
+    if (m_replay)
+        m_replay->seek(utcMs);
+}
+
+bool RadarIngestWorker::feedReplay(const RecordingReader::Record &rec)
+{
+    // 队列留一格余量给实时接收；GUI 取走后再继续
+    if (m_queue.size() + 1 >= m_queue.capacity())
+        return false;
+    DatagramRef buf = m_pool.acquire();
+    if (buf.isNull())
+        return false;
+    if (rec.size > buf.capacity())
+    {
+        // 与实时接收一致：超过缓冲槽长度的数据报丢弃计数
+        m_truncated.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    memcpy(buf.writableData(), rec.data, size_t(rec.size));
+    buf.setSize(rec.size);
+    m_replayed.fetch_add(1, std::memory_order_relaxed);
+    processDatagram(std::move(buf), DatagramRecorder::monotonicNs(), false);
+    return true;
+}
+
+IngestStats RadarIngestWorker::stats() const
+{
+    IngestStats s;
+    s.datagrams = m_datagrams.load(std::memory_order_relaxed);
+    s.bytes = m_bytes.load(std::memory_order_relaxed);
+    s.queueDrops = m_queueDrops.load(std::memory_order_relaxed);
+    s.trackFrames = m_resultCounts[int(MessageDispatcher::Result::Track)].load(std::memory_order_relaxed);
+    s.statusFrames = m_resultCounts[int(MessageDispatcher::Result::Status)].load(std::memory_order_relaxed);
+    s.trackBatchFrames = m_resultCounts[int(MessageDispatcher::Result::TrackBatch)].load(std::memory_order_relaxed);
+    s.batchRecords = m_batchRecords.load(std::memory_order_relaxed);
+    s.invalidRecords = m_invalidRecords.load(std::memory_order_relaxed);
+    s.unknownFrames = m_resultCounts[int(MessageDispatcher::Result::UnknownId)].load(std::memory_order_relaxed);
+    s.malformedFrames = m_resultCounts[int(MessageDispatcher::Result::Malformed)].load(std::memory_order_relaxed);
+    s.badSum16 = m_badSum16.load(std::memory_order_relaxed);
+    s.badCrc16 = m_badCrc16.load(std::memory_order_relaxed);
+    s.truncated = m_truncated.load(std::memory_order_relaxed);
+    s.poolExhausted = m_poolExhausted.load(std::memory_order_relaxed);
+    s.recvBatches = m_recvBatches.load(std::memory_order_relaxed);
+    s.replayed = m_replayed.load(std::memory_order_relaxed);
+    if (m_recorder)
+    {
+        s.recorded = m_recorder->records();
+        s.recordDrops = m_recorder->drops();
+    }
+    s.queueDepth = int(m_queue.size());
+    s.queueHighWater = m_queueHighWater.load(std::memory_order_relaxed);
+    s.queueCapacity = int(m_queue.capacity());
+    s.poolInUse = m_pool.inUse();
+    s.poolSize = m_pool.slotCount();
+    s.batchSize = m_config.batchSize;
+    return s;
+}
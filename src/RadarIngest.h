@@ -0,0 +1,172 @@
+// RadarIngest.h
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include "SpscQueue.h"
+#include "DatagramPool.h"
+#include "MessageDispatcher.h"
+#include "DatagramRecorder.h"
+#include "RadarReplay.h"
+
+class QUdpSocket;
+class QSocketNotifier;
+
+// 采集线程解析完成、交给GUI线程的一帧：
+// 经队列交换传递（SpscQueue::tryPushSwap/tryPopSwap），不析构不重置，batch 的各列容量在队列槽、
+// 采集线程与GUI线程之间循环复用，批量帧解码不再逐帧分配；消费者用完须先 release() 归还缓冲槽
+struct IngestFrame
+{
+    DatagramRef buffer; // 池内原始数据报（引用计数，跨线程传递不拷贝）
+    QByteArray raw;     // buffer 的无拷贝视图，随 buffer 一起失效（复制 QByteArray 不会深拷贝）
+    MessageDispatcher::Result kind{MessageDispatcher::Result::Malformed};
+    bool hasTrack{false};
+    bool hasStatus{false};
+    bool hasBatch{false};
+    TrackMessage track;
+    RadarStatus status;
+    TrackBatch batch; // 批量航迹报文解码结果（已剔除范围不合法的记录）
+
+    // 归还缓冲槽，解码结果（及 batch 的容量）保留
+    void release()
+    {
+        raw.clear();
+        buffer.reset();
+    }
+};
+
+// 采集参数（start 之前设置）
+// 缓冲池一次性保留 poolSize × slotBytes 的地址空间（默认 256MB），页面在第一次写入时才占用物理内存，
+// 实际占用约为 槽数 × 常见数据报长度（按页取整）
+struct IngestConfig
+{
+    int queueCapacity = 2048;      // 采集->GUI 队列容量
+    int batchSize = 64;            // 单次 recvmmsg 最多收取的数据报数
+    int poolSize = 4096;           // 预分配缓冲槽个数（应大于 队列容量 + 批大小）
+    int slotBytes = 65536;         // 每个缓冲槽字节数，不小于 Protocol::MaxDatagramBytes（批量航迹帧 73+71N 字节，N 可达 921）
+    int recvBufferBytes = 4 << 20; // 内核接收缓冲区，0 表示保持系统默认
+    bool batchedReceive = true;    // Linux 下使用 recvmmsg 批量接收
+    bool verifyChecksums = true;   // 按帧头校验方式验证帧尾校验，失败的帧不解码
+    RecorderConfig recorder;       // 原始数据报记录（目录为空则不记录）
+};
+
+// 采集统计（计数自启动起累计）
+struct IngestStats
+{
+    quint64 datagrams{};        // 收到的数据报数
+    quint64 bytes{};            // 收到的字节数
+    quint64 queueDrops{};       // 队列满被丢弃的帧数
+    quint64 trackFrames{};      // 航迹报文
+    quint64 statusFrames{};     // 状态报文
+    quint64 trackBatchFrames{}; // 批量航迹报文
+    quint64 batchRecords{};     // 批量航迹报文中的合法记录数
+    quint64 invalidRecords{};   // 批量航迹中范围校验不合法被剔除的记录数
+    quint64 unknownFrames{};    // 未订阅的报文ID
+    quint64 malformedFrames{};  // 帧头错误或解码失败
+    quint64 badSum16{};         // 和校验不符被拒绝的帧
+    quint64 badCrc16{};         // CRC16 不符被拒绝的帧
+    quint64 truncated{};        // 超过缓冲槽长度被丢弃的数据报
+    quint64 poolExhausted{};    // 缓冲池耗尽被丢弃的数据报
+    quint64 recvBatches{};      // recvmmsg 调用次数（仅批量后端）
+    quint64 recorded{};         // 已写入记录文件的数据报（收+发）
+    quint64 recordDrops{};      // 记录段未就绪等原因未能记录的数据报
+    quint64 replayed{};         // 回放送入管线的数据报（同时计入 datagrams）
+    int queueDepth{};           // 当前队列深度
+    int queueHighWater{};       // 队列深度峰值
+    int queueCapacity{};        // 队列容量
+    int poolInUse{};            // 当前被引用的缓冲槽
+    int poolSize{};             // 缓冲槽总数
+    int batchSize{};            // 配置的批大小
+    // 以下两项由 NetworkManager 按统计周期计算
+    double batchesPerSec{}; // 每秒批次数
+    double avgBatchFill{};  // 平均每批数据报数 / 批大小（0..1）
+};
+
+// 运行在独立采集线程中的UDP收发对象：
+// - 拥有本地端口（默认6553）的socket，读通知在采集线程触发；
+// - Linux 下用 recvmmsg 一次系统调用收取一批数据报，直接写入预分配的缓冲池；
+//   其它平台回退到 QUdpSocket，同样读入缓冲池；
+// - 在采集线程完成报文解析，结果经有界无锁队列交给GUI线程；
+// - 队列满时丢弃新帧并计数，不阻塞接收；
+// - 可回放记录文件：回放的数据报与实时接收走同一条解析/队列路径（不再重复记录），
+//   回放在队列接近满时等待而不是丢帧，因此最快速度即端到端吞吐。
+class RadarIngestWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit RadarIngestWorker(quint16 localPort, const IngestConfig &config = IngestConfig(), QObject *parent = nullptr);
+    ~RadarIngestWorker() override;
+
+    // 消费者（GUI线程）接口
+    SpscQueue<IngestFrame> &queue() { return m_queue; }
+    // 消费者在取队列前调用，重新允许发出 framesReady 通知
+    void acknowledgeFrames() { m_notifyPending.store(false, std::memory_order_release); }
+    // 任意线程可调用
+    IngestStats stats() const;
+
+public slots:
+    // 在采集线程中创建并绑定socket
+    void start();
+    // 由采集线程通过本端口发送（外部以 QueuedConnection 调用）
+    void sendDatagram(const QByteArray &data, const QHostAddress &addr, quint16 port);
+    // 回放记录文件或目录；speed: 1 实时，N 倍速，<= 0 最快；startUtcMs > 0 时先跳转
+    void startReplay(const QString &path, double speed, qint64 startUtcMs);
+    void stopReplay();
+    void setReplaySpeed(double speed);
+    void seekReplay(qint64 utcMs);
+
+signals:
+    // 队列由空变为非空时发出（合并通知，避免每帧一次跨线程事件）
+    void framesReady();
+    void bindFinished(bool ok);
+    void replayPosition(qint64 utcMs);
+    void replayFinished(const ReplayStats &stats);
+
+private slots:
+    void onReadyRead();
+    void onBatchReadable();
+
+private:
+    bool openBatchedSocket();
+    // rxNs：接收时的单调时钟（批量接收时整批共用一个）；record=false 用于回放，不重复记录
+    void processDatagram(DatagramRef &&buf, qint64 rxNs, bool record = true);
+    // 回放 sink：下游暂满返回 false
+    bool feedReplay(const RecordingReader::Record &rec);
+
+    quint16 m_localPort;
+    IngestConfig m_config;
+    QUdpSocket *m_udpSocket{nullptr};
+    // 批量接收后端（Linux）
+    int m_fd{-1};
+    QSocketNotifier *m_notifier{nullptr};
+    QVector<DatagramRef> m_batch; // 本批取得的缓冲槽，复用不重新分配
+    struct BatchState;            // mmsghdr/iovec 等平台结构，预分配
+    BatchState *m_batchState{nullptr};
+
+    // 池须先于队列构造、后于队列析构：队列中的帧仍引用池内缓冲
+    DatagramPool m_pool;
+    SpscQueue<IngestFrame> m_queue;
+    std::atomic<bool> m_notifyPending{false};
+    MessageDispatcher m_dispatcher;
+    std::unique_ptr<DatagramRecorder> m_recorder; // 收发都在采集线程记录
+    RadarReplay *m_replay{nullptr};               // 首次回放时在采集线程创建
+    IngestFrame m_staging;                        // 正在解码的帧，入队时与队列槽交换，换回的旧帧下次复用
+
+    std::atomic<quint64> m_datagrams{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_queueDrops{0};
+    std::atomic<quint64> m_resultCounts[MessageDispatcher::ResultCount]{}; // 按 MessageDispatcher::Result 计数
+    std::atomic<quint64> m_batchRecords{0};
+    std::atomic<quint64> m_invalidRecords{0};
+    std::atomic<quint64> m_badSum16{0};
+    std::atomic<quint64> m_badCrc16{0};
+    std::atomic<quint64> m_truncated{0};
+    std::atomic<quint64> m_poolExhausted{0};
+    std::atomic<quint64> m_recvBatches{0};
+    std::atomic<quint64> m_replayed{0};
+    std::atomic<int> m_queueHighWater{0};
+};
@@ -0,0 +1,144 @@
+// RadarReplay.cpp
+#include "RadarReplay.h"
+
+namespace
+{
+    constexpr qint64 PumpBudgetNs = 4 * 1000000; // 单次泵送最多占用事件循环的时间
+    constexpr qint64 PositionIntervalNs = 100 * 1000000;
+    constexpr qint64 EarlyToleranceNs = 1000000; // 提前不足1ms的直接发出，避免空转定时器
+} // namespace
+
+RadarReplay::RadarReplay(Sink sink, QObject *parent)
+    : QObject(parent),
+      m_sink(std::move(sink))
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &RadarReplay::pump);
+}
+
+bool RadarReplay::open(const QString &path)
+{
+    pause();
+    m_hasPending = false;
+    m_anchored = false;
+    m_stats = ReplayStats();
+    m_activeNs = 0;
+    return m_reader.open(path);
+}
+
+void RadarReplay::setSpeed(double speed)
+{
+    m_speed = speed;
+    m_anchored = false; // 从下一条开始按新速度计时
+}
+
+bool RadarReplay::seek(qint64 utcMs)
+{
+    m_hasPending = false;
+    m_anchored = false;
+    const bool ok = m_reader.seek(utcMs * 1000000);
+    if (m_running)
+        m_timer.start(0);
+    return ok;
+}
+
+void RadarReplay::start()
+{
+    if (m_running || m_reader.segmentCount() == 0)
+        return;
+    m_running = true;
+    m_anchored = false;
+    m_startNs = DatagramRecorder::monotonicNs();
+    m_timer.start(0);
+}
+
+void RadarReplay::pause()
+{
+    if (!m_running)
+        return;
+    m_running = false;
+    m_timer.stop();
+    m_activeNs += DatagramRecorder::monotonicNs() - m_startNs;
+}
+
+ReplayStats RadarReplay::stats() const
+{
+    ReplayStats s = m_stats;
+    s.elapsedNs = m_activeNs + (m_running ? DatagramRecorder::monotonicNs() - m_startNs : 0);
+    if (s.elapsedNs > 0)
+    {
+        const double secs = double(s.elapsedNs) / 1e9;
+        s.datagramsPerSec = double(s.datagrams) / secs;
+        s.megabytesPerSec = double(s.bytes) / secs / 1e6;
+    }
+    return s;
+}
+
+void RadarReplay::reanchor()
+{
+    m_anchorNs = DatagramRecorder::monotonicNs();
+    m_anchorRecordNs = m_pending.utcNs;
+    m_anchored = true;
+}
+
+void RadarReplay::pump()
+{
+    if (!m_running)
+        return;
+    const qint64 budgetEnd = DatagramRecorder::monotonicNs() + PumpBudgetNs;
+    int sent = 0;
+    for (;;)
+    {
+        if (!m_hasPending)
+        {
+            if (!m_reader.next(m_pending))
+            {
+                pause();
+                emit positionChanged(m_lastUtcNs / 1000000);
+                emit finished(stats());
+                return;
+            }
+            if (m_pending.direction != RecordFormat::Rx)
+                continue; // 本机发出的命令不回放
+            m_hasPending = true;
+        }
+        if (!m_anchored)
+            reanchor();
+
+        const qint64 now = DatagramRecorder::monotonicNs();
+        if (m_speed > 0)
+        {
+            const qint64 due = m_anchorNs + qint64(double(m_pending.utcNs - m_anchorRecordNs) / m_speed);
+            if (due - now > EarlyToleranceNs)
+            {
+                m_timer.start(int((due - now) / 1000000));
+                break;
+            }
+        }
+        if (!m_sink(m_pending))
+        {
+            // 下游满：同一条稍后重试
+            ++m_stats.backpressure;
+            m_timer.start(1);
+            break;
+        }
+        m_hasPending = false;
+        ++m_stats.datagrams;
+        m_stats.bytes += quint64(m_pending.size);
+        m_lastUtcNs = m_pending.utcNs;
+
+        if ((++sent & 63) == 0 && now > budgetEnd)
+        {
+            m_timer.start(0); // 让出事件循环（实时接收、发送请求）
+            break;
+        }
+    }
+
+    const qint64 now = DatagramRecorder::monotonicNs();
+    if (now - m_lastPositionNs >= PositionIntervalNs)
+    {
+        m_lastPositionNs = now;
+        emit positionChanged(m_lastUtcNs / 1000000);
+    }
+}
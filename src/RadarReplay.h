@@ -0,0 +1,78 @@
+// RadarReplay.h
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <functional>
+#include "RecordingReader.h"
+
+// 一次回放的统计
+struct ReplayStats
+{
+    quint64 datagrams{};    // 已送入管线的接收记录
+    quint64 bytes{};        // 载荷字节数
+    quint64 backpressure{}; // 下游（队列/缓冲池）满而等待的次数
+    qint64 elapsedNs{};     // 回放耗时（不含暂停）
+    double datagramsPerSec{};
+    double megabytesPerSec{};
+};
+
+// 记录回放：按记录时间把接收方向的数据报重新送入采集管线。
+// - speed = 1 实时，N 为 N 倍速，<= 0 为最快（只受下游背压限制，用于测端到端吞吐）；
+// - 以“单调时钟锚点 + 记录时间锚点”计算每条的到期时间，改速度/跳转时重新锚定；
+// - sink 返回 false 表示下游暂满，同一条稍后重试，不丢帧；
+// - 每次泵送有时间预算，不长时间占住所在线程的事件循环。
+// 对象须与 sink 在同一线程（采集线程）。
+class RadarReplay : public QObject
+{
+    Q_OBJECT
+public:
+    using Sink = std::function<bool(const RecordingReader::Record &)>;
+
+    explicit RadarReplay(Sink sink, QObject *parent = nullptr);
+
+    bool open(const QString &path);
+    QString errorString() const { return m_reader.errorString(); }
+    const RecordingReader &reader() const { return m_reader; }
+
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+    // 跳转到UTC毫秒时刻（用时间索引定位，不扫描文件）
+    bool seek(qint64 utcMs);
+
+    void start();
+    void pause();
+    bool isRunning() const { return m_running; }
+    ReplayStats stats() const;
+
+signals:
+    // 回放位置（UTC毫秒），约每100ms一次
+    void positionChanged(qint64 utcMs);
+    void finished(const ReplayStats &stats);
+
+private slots:
+    void pump();
+
+private:
+    void reanchor();
+
+    RecordingReader m_reader;
+    Sink m_sink;
+    QTimer m_timer;
+    double m_speed{1.0};
+    bool m_running{false};
+
+    RecordingReader::Record m_pending;
+    bool m_hasPending{false};
+
+    // 到期时间 = m_anchorNs + (记录时间 - m_anchorRecordNs) / m_speed
+    qint64 m_anchorNs{0};
+    qint64 m_anchorRecordNs{0};
+    bool m_anchored{false};
+
+    qint64 m_startNs{0};  // 本次 start 的单调时钟
+    qint64 m_activeNs{0}; // 之前各段运行时间之和（暂停不计）
+    qint64 m_lastPositionNs{0};
+    qint64 m_lastUtcNs{0}; // 最近送出的记录时间
+    ReplayStats m_stats;
+};
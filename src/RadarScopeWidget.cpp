@@ -1,488 +1,449 @@
 // RadarScopeWidget.cpp
 #include "RadarScopeWidget.h"
+#include "Protocol.h"
+#include "MessageIds.h"
+#include <QMouseEvent>
 #include <QPainter>
-#include <QPainterPath>
-#include <QConicalGradient>
+#include <QElapsedTimer>
 #include <QtMath>
 #include <QDateTime>
 
+namespace
+{
+    constexpr float MissileHitRadiusM = 30.0f; // 导弹与目标距离小于此值视为命中
+    constexpr qreal PickRadiusPx = 10.0;       // 点选容差（像素）
+} // namespace
+
 RadarScopeWidget::RadarScopeWidget(QWidget *parent)
     : QWidget(parent)
 {
-    setAutoFillBackground(true);
+    // 底图铺满整个窗口，不需要 Qt 先填背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
     QPalette pal = palette();
     pal.setColor(QPalette::Window, QColor(10, 20, 10));
     setPalette(pal);
 
-    m_cleanupTimer.setInterval(1000);
-    connect(&m_cleanupTimer, &QTimer::timeout, this, [this]
-            {
-        const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    const qint64 keepMs = m_trailKeepMs; // 可配置的轨迹保留时长
-        for (auto &t : m_trails) {
-            while (!t.points.isEmpty() && now - t.points.front().ms > keepMs) {
-                t.points.removeFirst();
-            }
-        }
-    // 移除空轨迹或超出检测范围的轨迹
-    m_trails.erase(std::remove_if(m_trails.begin(), m_trails.end(), [this](const Trail &tr){ return tr.points.isEmpty() || tr.lastDistance >= m_maxRange; }), m_trails.end());
-        update(); });
-    m_cleanupTimer.start();
-
-    // attack timer: update attacks at 30Hz
-    m_attackTimer.setInterval(33);
-    connect(&m_attackTimer, &QTimer::timeout, this, [this]()
-            {
-        const qint64 now = QDateTime::currentMSecsSinceEpoch();
-        // update missiles: move towards next target point
-        for (auto &a : m_attacks) {
-            if (a.finished) continue;
-            // find target trail
-            auto it = std::find_if(m_trails.begin(), m_trails.end(), [&](const Trail &t){ return t.id == a.targetId; });
-            if (it == m_trails.end() || it->points.empty()) {
-                // target lost: finish attack
-                a.finished = true;
-                continue;
-            }
-            const QPointF targetPos = it->points.back().pos;
-            if (a.type == Attack::Laser) {
-                // laser persists for 3s from start
-                if (now - a.startMs > 3000) {
-                    a.finished = true;
-                    // remove trail from scope
-                    m_trails.erase(std::remove_if(m_trails.begin(), m_trails.end(), [&](const Trail &tr){ return tr.id == a.targetId; }), m_trails.end());
-                    // laser disappears and target is removed
-                    emit targetHit(a.targetId);
-                }
-            } else {
-                // missile: move towards current targetPos
-                QPointF dir = targetPos - a.pos;
-                const float dist = std::hypot(dir.x(), dir.y());
-                if (dist < 6.0f) {
-                    // hit: remove trail immediately
-                    a.finished = true;
-                    m_trails.erase(std::remove_if(m_trails.begin(), m_trails.end(), [&](const Trail &tr){ return tr.id == a.targetId; }), m_trails.end());
-                    emit targetHit(a.targetId);
-                } else {
-                    if (dist > 0.0f) {
-                        dir /= dist;
-                        const float step = a.speed * (m_attackTimer.interval() / 1000.0f);
-                        a.pos += dir * step;
-                    }
-                }
-            }
-        }
-        // remove finished attacks after emitting
-        m_attacks.erase(std::remove_if(m_attacks.begin(), m_attacks.end(), [](const Attack &at){ return at.finished; }), m_attacks.end());
-        update(); });
-    m_attackTimer.start();
-
-    // 扫描线动画：每16ms更新一次角度
-    m_sweepTimer.setInterval(16);
-    connect(&m_sweepTimer, &QTimer::timeout, this, [this]
-            {
-        if (!m_sweepOn) return;
-        // 每tick转动角度
-        m_sweepAngle += m_sweepSpeed * (m_sweepTimer.interval() / 1000.0f);
-        while (m_sweepAngle >= 360.0f) m_sweepAngle -= 360.0f;
-        update(); });
+    // 自带一个模型，可用 setTrackModel 换成与其他视图共用的模型（过期清理由模型负责）
+    setTrackModel(new TrackModel(this));
+
+    // 唯一的绘制时钟：扫描线与攻击在同一个 tick 推进，每个 tick 至多请求一次重绘
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &RadarScopeWidget::onFrameTick);
+    m_frameClock.start();
+    requestFrame();
 }
 
-void RadarScopeWidget::setMaxRangeMeters(float r)
+RadarScopeWidget::~RadarScopeWidget()
 {
-    m_maxRange = qMax(100.0f, r);
-    update();
+    // 共用的模型可能比本视图活得久：先摘下镜像的块池
+    disconnect(m_model, nullptr, this, nullptr);
+    m_model->setTrailMirrorPool(nullptr);
 }
 
-void RadarScopeWidget::onTrackDatagram(const QByteArray &data)
+void RadarScopeWidget::setMaxFps(int fps)
 {
-    // 轻量过滤 + 解析
-    if (!TrackParser::hasReadableMagic(data))
-        return;
+    m_maxFps = qBound(1, fps, 240);
+    requestFrame();
+}
 
-    TrackMessage msg;
-    if (!TrackParser::parseLittleEndian(data, msg))
-        return;
+void RadarScopeWidget::setIdleFps(int fps)
+{
+    m_idleFps = qBound(1, fps, m_maxFps);
+    requestFrame();
+}
+
+void RadarScopeWidget::setPhosphorDecayMs(qint64 ms)
+{
+    m_phosphorDecayMs = qMax<qint64>(50, ms);
+    requestFrame();
+}
+
+void RadarScopeWidget::requestFrame()
+{
+    // 数据变化只标记，由下一个 tick 统一重绘；空闲频率下先切回全速，变化在一帧内显示
+    m_dirty = true;
+    const int interval = 1000 / m_maxFps;
+    if (!m_frameTimer.isActive() || m_frameTimer.interval() != interval)
+        m_frameTimer.start(interval);
+}
+
+bool RadarScopeWidget::isAnimating(qint64 now) const
+{
+    // 扫描、攻击、淡出中的提示，或有航迹的预测位置仍在移动
+    return m_sweepOn || !m_attacks.isEmpty() || (m_showNotices && !m_notices.isEmpty()) ||
+           m_model->filter().isMoving(now);
+}
 
-    // 将距离/方位转为平面点；以窗口中心为原点，北向上、东向右。
-    const float d = msg.info.distance; // 已是直线距离（米）
-    const float az = msg.info.azimuth; // 相对正北顺时针
-    const QRectF circle(rect());
-    QPointF p = polarToPoint(d, az, circle);
-
-    // 找到/创建轨迹
-    auto it = std::find_if(m_trails.begin(), m_trails.end(), [&](const Trail &t)
-                           { return t.id == msg.info.trackId; });
-    // 如果目标距离大于雷达最大量程，则移除已存在轨迹并忽略该点
-    if (msg.info.distance > m_maxRange)
+void RadarScopeWidget::onFrameTick()
+{
+    const qint64 nowNs = m_frameClock.nsecsElapsed();
+    // 按实际经过时间推进（定时器抖动或界面卡顿后不会变慢），单步最多按 100ms 计
+    const float dt = m_lastTickNs < 0 ? 0.0f : qMin(0.1f, float(nowNs - m_lastTickNs) * 1e-9f);
+    m_lastTickNs = nowNs;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (m_sweepOn)
     {
-        if (it != m_trails.end())
-        {
-            m_trails.erase(it);
-            update();
-        }
-        return;
+        m_sweepAngle += m_sweepSpeed * dt;
+        while (m_sweepAngle >= 360.0f)
+            m_sweepAngle -= 360.0f;
     }
+    advanceAttacks(now, dt);
 
-    if (it == m_trails.end())
+    const bool animating = isAnimating(now);
+    if (animating || m_dirty)
     {
-        Trail t;
-        t.id = msg.info.trackId;
-        m_trails.push_back(t);
-        it = m_trails.end() - 1;
-        if (m_showNotices)
+        if (m_renderThread)
+        {
+            // 绘制线程忙时保留脏标记，下个 tick 再交；两份帧数据轮流用，正在画的那份不动
+            // 镜像也只在绘制线程空闲时同步；tick 里的绘制开销只有这一步
+            ScopeFrame &f = m_frames[m_nextFrame];
+            if (m_renderThread->isBusy())
+            {
+                ++m_paintStats.deferred;
+            }
+            else
+            {
+                QElapsedTimer timer;
+                timer.start();
+                snapshotFrame(f, now);
+                m_paintStats.snapshot.add(timer.nsecsElapsed());
+                m_dirty = !m_renderThread->submit(&f);
+                if (!m_dirty)
+                    m_nextFrame ^= 1;
+            }
+        }
+        else
         {
-            m_notices.push_back({tr("发现新目标 #%1").arg(t.id), QDateTime::currentMSecsSinceEpoch()});
+            update();
+            m_dirty = false;
         }
     }
-    // 更新目标类型/尺寸/速度/距离/身份信息
-    it->targetType = msg.info.targetType;
-    it->targetSize = msg.info.targetSize;
-    it->lastSpeed = qAbs(msg.info.speed);
-    it->lastDistance = msg.info.distance;
-    // 假设身份由 targetType==0 表示未知，否则视为已知
-    it->identityKnown = (msg.info.targetType != 0);
-    it->points.push_back({p, QDateTime::currentMSecsSinceEpoch()});
-    if (it->points.size() > m_maxTrailPoints)
-        it->points.remove(0);
-    update();
+    // 没有东西在动时降到空闲频率（仍定期刷新轨迹淡出）；有变化时 requestFrame 立即切回
+    const int interval = 1000 / (animating ? m_maxFps : m_idleFps);
+    if (m_frameTimer.interval() != interval)
+        m_frameTimer.start(interval);
 }
 
-QPointF RadarScopeWidget::polarToPoint(float distance_m, float azimuth_deg, const QRectF &circle) const
+void RadarScopeWidget::advanceAttacks(qint64 now, float dt)
 {
-    const float r = qBound(0.0f, distance_m, m_maxRange);
-    const float ratio = r / m_maxRange; // 0..1
-    // 绘图半径取正方形中最小边
-    const float radius = 0.48f * qMin(circle.width(), circle.height());
-    // 转屏幕坐标：北(0°)向上 => 屏幕y减；顺时针为正 => 屏幕角度 = -azimuth + 90? 以北为0度，转换到数学坐标x轴正右、逆时针为正：theta = 90° - azimuth
-    const float theta = qDegreesToRadians(90.0f - azimuth_deg);
-    const float rr = ratio * radius;
-    const QPointF center = circle.center();
-    const float x = center.x() + rr * qCos(theta);
-    const float y = center.y() - rr * qSin(theta); // y向下为正，故减
-    return {x, y};
+    // update missiles: move towards next target point
+    for (auto &a : m_attacks) {
+        if (a.finished) continue;
+        // find target trail (handle: a reused id is a different target)
+        const TrackModel::Track *track = m_model->find(a.target);
+        if (!track || track->trail.isEmpty()) {
+            // target lost: finish attack
+            a.finished = true;
+            continue;
+        }
+        // filtered position now; missiles lead the target towards the intercept point
+        const QPointF targetPos = m_model->filter().predict(track->id, now);
+        if (a.type == Attack::Laser) {
+            // laser persists for 3s from start
+            if (now - a.startMs > 3000) {
+                a.finished = true;
+                // remove track (all views)
+                m_model->remove(a.targetId);
+                // laser disappears and target is removed
+                emit targetHit(a.targetId);
+            }
+        } else {
+            // missile: fly towards the intercept point (metres), or straight at the target if it cannot be caught
+            const QPointF toTarget = targetPos - a.pos;
+            const float dist = std::hypot(toTarget.x(), toTarget.y());
+            const float step = a.speed * dt;
+            if (dist <= qMax(MissileHitRadiusM, step)) {
+                // hit (or would pass the target within this tick): remove trail immediately
+                a.finished = true;
+                m_model->remove(a.targetId);
+                emit targetHit(a.targetId);
+            } else {
+                QPointF aim;
+                if (!m_model->filter().intercept(track->id, now, a.pos, a.speed, &aim))
+                    aim = targetPos;
+                QPointF dir = aim - a.pos;
+                const float len = std::hypot(dir.x(), dir.y());
+                if (len > 0.0f)
+                    a.pos += dir * (qMin(step, len) / len);
+            }
+        }
+    }
+    // remove finished attacks after emitting
+    m_attacks.erase(std::remove_if(m_attacks.begin(), m_attacks.end(), [](const Attack &at){ return at.finished; }), m_attacks.end());
 }
 
-QString RadarScopeWidget::typeSizeLabel(int type, int size)
+void RadarScopeWidget::setMaxRangeMeters(float r)
 {
-    QString t;
-    switch (type)
-    {
-    case 0:
-        t = QStringLiteral("未知");
-        break;
-    case 1:
-        t = QStringLiteral("旋翼");
-        break;
-    case 2:
-        t = QStringLiteral("固定翼");
-        break;
-    case 3:
-        t = QStringLiteral("直升机");
-        break;
-    case 4:
-        t = QStringLiteral("民航");
-        break;
-    case 5:
-        t = QStringLiteral("车辆");
-        break;
-    default:
-        t = QStringLiteral("?%1").arg(type);
-        break;
-    }
-    QString s;
-    switch (size)
-    {
-    case 0:
-        s = QStringLiteral("小");
-        break;
-    case 1:
-        s = QStringLiteral("中");
-        break;
-    case 2:
-        s = QStringLiteral("大");
-        break;
-    case 3:
-        s = QStringLiteral("特大");
-        break;
-    default:
-        s = QStringLiteral("?%1").arg(size);
-        break;
-    }
-    return t + QStringLiteral("·") + s;
+    // 每个状态帧都会调用：量程不变时不重画底图、不重算变换
+    r = qMax(100.0f, r);
+    if (r == m_maxRange)
+        return;
+    m_maxRange = r;
+    m_viewDirty = true;
+    m_backgroundDirty = true;
+    requestFrame();
 }
 
-float RadarScopeWidget::computeThreatScore(const RadarScopeWidget::Trail &t) const
+void RadarScopeWidget::setTrailAlphaBuckets(int n)
 {
-    // 规范化距离：越近 -> 越高威胁。这里用简单的线性归一：d_norm = 1 - min(d / maxRange, 1)
-    float dnorm = 1.0f - qBound(0.0f, t.lastDistance / m_maxRange, 1.0f);
-    // 速度归一化：速度越高 -> 越高威胁
-    float snorm = qBound(0.0f, t.lastSpeed / m_maxSpeed, 1.0f);
-    // 类型风险因子：按要求映射（未知=1, 旋翼=0.3, 固定翼=0.3, 直升机=0.6, 民航=0.7, 车=0.6）
-    float typeFactor = 1.0f;
-    switch (t.targetType)
-    {
-    case 0:
-        typeFactor = 1.0f;
-        break;
-    case 1:
-        typeFactor = 0.3f;
-        break;
-    case 2:
-        typeFactor = 0.3f;
-        break;
-    case 3:
-        typeFactor = 0.6f;
-        break;
-    case 4:
-        typeFactor = 0.7f;
-        break;
-    case 5:
-        typeFactor = 0.6f;
-        break;
-    default:
-        typeFactor = 1.0f;
-        break;
-    }
-    // 将 typeFactor 归一到 0..1(较高值表示更危险)。已知 mapping: unknown=1(high), others lower.
-    // We invert so that higher normalized value = more dangerous: tnorm = 1 - (typeFactor/maxPossible)
-    const float maxTypeVal = 1.0f; // since unknown uses 1.0
-    float tnorm = 1.0f - qBound(0.0f, typeFactor / maxTypeVal, 1.0f);
-
-    // 身份：未知=1（危险），已知=0（安全） -> identityNorm in [0..1]
-    float idnorm = t.identityKnown ? 0.0f : 1.0f;
-
-    // 加权合成（注意权重之和为1）
-    float score = m_weightDistance * dnorm + m_weightSpeed * snorm + m_weightType * tnorm + m_weightIdentity * idnorm;
-    // clamp
-    return qBound(0.0f, score, 1.0f);
+    m_trailBuckets = qBound(1, n, 64);
+    requestFrame();
 }
 
-void RadarScopeWidget::paintEvent(QPaintEvent *)
+void RadarScopeWidget::setBackgroundCached(bool on)
 {
-    QPainter p(this);
-    p.setRenderHint(QPainter::Antialiasing, true);
+    m_backgroundCached = on;
+    m_background = QImage();
+    m_backgroundDirty = true;
+    requestFrame();
+}
 
-    const QRectF rc = rect();
-    const QPointF c = rc.center();
-    const float R = 0.48f * qMin(rc.width(), rc.height());
-    const QRectF circle(c.x() - R, c.y() - R, 2 * R, 2 * R);
+void RadarScopeWidget::resizeEvent(QResizeEvent *)
+{
+    m_viewDirty = true;
+    m_backgroundDirty = true;
+    requestFrame(); // 后台绘制时需要按新尺寸出一帧
+}
 
-    // 背景雷达扇面
-    p.setPen(QPen(QColor(40, 120, 40), 2));
-    p.setBrush(QColor(20, 60, 20));
-    p.drawEllipse(circle);
+void RadarScopeWidget::changeEvent(QEvent *e)
+{
+    // 底图用到调色板与字体
+    if (e->type() == QEvent::PaletteChange || e->type() == QEvent::FontChange)
+        m_backgroundDirty = true;
+    QWidget::changeEvent(e);
+}
 
-    // 圈层与刻度
-    p.setPen(QPen(QColor(60, 180, 60), 1));
-    for (int i = 1; i <= 4; ++i)
-    {
-        p.drawEllipse(QRectF(c.x() - R * i / 4.0, c.y() - R * i / 4.0, 2 * R * i / 4.0, 2 * R * i / 4.0));
-    }
-    // 十字和方位刻度
-    p.drawLine(QPointF(c.x() - R, c.y()), QPointF(c.x() + R, c.y()));
-    p.drawLine(QPointF(c.x(), c.y() - R), QPointF(c.x(), c.y() + R));
-    p.setPen(QPen(QColor(120, 220, 120), 1));
-    for (int deg = 0; deg < 360; deg += 30)
+void RadarScopeWidget::setTrackModel(TrackModel *model)
+{
+    if (!model || model == m_model)
+        return;
+    if (m_model)
     {
-        const float theta = qDegreesToRadians(90.0f - float(deg));
-        QPointF o = QPointF(c.x() + (R - 10) * qCos(theta), c.y() - (R - 10) * qSin(theta));
-        QPointF i = QPointF(c.x() + R * qCos(theta), c.y() - R * qSin(theta));
-        p.drawLine(o, i);
-        QString label = QString::number(deg);
-        QPointF t = QPointF(c.x() + (R + 12) * qCos(theta), c.y() - (R + 12) * qSin(theta));
-        p.drawText(QRectF(t.x() - 12, t.y() - 8, 24, 16), Qt::AlignCenter, label);
+        disconnect(m_model, nullptr, this, nullptr);
+        m_model->setTrailMirrorPool(nullptr);
+        if (m_model->parent() == this)
+            m_model->deleteLater();
     }
+    m_model = model;
+    m_scene.markAll(); // 下次同步整表重建
+    m_model->setTrailMirrorPool(m_scene.trailPool());
+    connect(m_model, &TrackModel::changed, this, &RadarScopeWidget::onModelChanged);
+    requestFrame();
+}
+
+void RadarScopeWidget::onTrackDatagram(const QByteArray &data)
+{
+    // 按帧头报文ID过滤 + 解析
+    Protocol::FrameHeader head;
+    if (!Protocol::parseFrameHeader(data, head) || head.msgIdRadar != ProtocolIds::TrackReport)
+        return;
 
-    // 量程标签
-    p.setPen(QColor(150, 240, 150));
-    for (int i = 1; i <= 4; ++i)
+    TrackMessage msg;
+    if (!TrackParser::parseLittleEndian(data, msg))
+        return;
+    m_model->applyTrack(msg);
+}
+
+void RadarScopeWidget::onModelChanged(const TrackChangeSet &changes)
+{
+    // 只记批号，到绘制时再同步
+    m_scene.markChanged(changes);
+    if (m_showNotices && !changes.added.isEmpty())
     {
-        const float rr = R * i / 4.0f;
-        const float range = m_maxRange * (i / 4.0f);
-        p.drawText(QRectF(c.x() + rr - 24, c.y() - 12, 48, 16), Qt::AlignCenter, QString::number(int(range / 1000)) + " km");
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        for (quint16 id : changes.added)
+            m_notices.push_back({tr("发现新目标 #%1").arg(id), now});
     }
+    // 每批变化只请求一次重绘
+    requestFrame();
+}
 
-    // 画轨迹（根据点的时间做轻微衰减）
-    for (const auto &t : m_trails)
+const QTransform &RadarScopeWidget::viewTransform()
+{
+    if (m_viewDirty)
     {
-        if (t.points.size() < 2)
-            continue;
-        const qint64 now = QDateTime::currentMSecsSinceEpoch();
-        for (int i = 1; i < t.points.size(); ++i)
-        {
-            const qint64 age = now - t.points[i].ms;
-            const float alpha = qBound(30.0f, 255.0f * (1.0f - float(age) / float(qMax<qint64>(1, m_trailKeepMs))), 255.0f);
-            QPen pen(QColor(50, 150, 255, int(alpha)));
-            pen.setWidth(2);
-            p.setPen(pen);
-            p.drawLine(t.points[i - 1].pos, t.points[i].pos);
-        }
-        // 末端点
-        const auto &last = t.points.back();
-        // 根据威胁得分计算颜色（蓝->红）
-        const float score = computeThreatScore(t); // 0..1
-        QColor col;
-        // interpolate blue (0,128,255) -> red (255,50,50)
-        col.setRed(int(80 + 175 * score));
-        col.setGreen(int(180 - 130 * score));
-        col.setBlue(int(255 - 205 * score));
-        p.setPen(Qt::NoPen);
-        p.setBrush(col);
-        p.drawEllipse(last.pos, 4, 4);
-        // 绘制类型/尺寸标签
-        QString label = RadarScopeWidget::typeSizeLabel(t.targetType, t.targetSize);
-        if (!label.isEmpty())
-        {
-            QFont f = p.font();
-            f.setPointSize(8);
-            p.setFont(f);
-            p.setPen(QColor(230, 230, 230));
-            QRectF tr(last.pos.x() + 8, last.pos.y() - 10, 120, 14);
-            // 显示 类型·尺寸 以及威胁分 (0.00~1.00)
-            p.drawText(tr, Qt::AlignLeft | Qt::AlignVCenter, label + QStringLiteral(" ") + QString::number(score, 'f', 2));
-        }
-        // 如果有目标类型/尺寸信息（存在于 Trail structure? we need to map by id）
-        // 在当前实现中 Trail only contains points; try to extract type/size from notices or external source.
-        // For now, no per-trail metadata stored; label drawing will be skipped unless we have info.
+        // 绘图半径取正方形中最小边；屏幕 y 向下，故北向取负
+        const QRectF rc(rect());
+        const qreal scale = 0.48 * qMin(rc.width(), rc.height()) / m_maxRange;
+        m_view = QTransform(scale, 0.0, 0.0, -scale, rc.center().x(), rc.center().y());
+        m_viewDirty = false;
     }
+    return m_view;
+}
 
-    // 左上角提示（只显示关键信息）
+void RadarScopeWidget::snapshotFrame(ScopeFrame &f, qint64 now)
+{
+    m_scene.sync(*m_model);
+
+    f.size = size();
+    f.dpr = devicePixelRatioF();
+    f.window = palette().window().color();
+    f.font = font();
+    f.maxRange = m_maxRange;
+    f.scene = &m_scene;
+    f.view = viewTransform();
+    f.nowMs = now;
+    f.trailKeepMs = m_model->trailRetentionMs();
+    f.maxPredictMs = m_model->filter().maxPredictMs();
+    f.trailBuckets = m_trailBuckets;
+
+    // 左上角提示（只显示关键信息）：清理过期的，其余按剩余时间淡出
+    f.notices.clear();
     if (m_showNotices && !m_notices.isEmpty())
     {
-        const qint64 now = QDateTime::currentMSecsSinceEpoch();
-        // 清理过期
         m_notices.erase(std::remove_if(m_notices.begin(), m_notices.end(), [&](const Notice &n)
                                        { return now - n.ms > m_noticeKeepMs; }),
                         m_notices.end());
-        // 绘制剩余
-        int y = 8;
         for (const auto &n : m_notices)
         {
-            const qint64 age = now - n.ms;
-            float a = 1.0f - float(age) / float(m_noticeKeepMs);
-            a = qBound(0.0f, a, 1.0f);
-            QColor fg(230, 250, 230, int(255 * a));
-            QColor bg(0, 0, 0, int(120 * a));
-            p.setPen(Qt::NoPen);
-            p.setBrush(bg);
-            QFont f = p.font();
-            f.setBold(true);
-            p.setFont(f);
-            const QString text = n.text;
-            const QFontMetrics fm(p.font());
-            const int w = fm.horizontalAdvance(text) + 12;
-            const int h = fm.height() + 8;
-            QRect r(8, y, w, h);
-            p.drawRoundedRect(r, 6, 6);
-            p.setPen(fg);
-            p.drawText(r.adjusted(6, 4, -6, -4), Qt::AlignVCenter | Qt::AlignLeft, text);
-            y += h + 6;
+            const float a = 1.0f - float(now - n.ms) / float(m_noticeKeepMs);
+            f.notices.append({n.text, qBound(0.0f, a, 1.0f)});
         }
     }
 
-    // 扫描线与余辉
-    if (m_sweepOn)
+    f.sweepOn = m_sweepOn;
+    f.sweepAngle = m_sweepAngle;
+    f.sweepSpeed = m_sweepSpeed;
+    f.phosphorDecayMs = m_phosphorDecayMs;
+    f.phosphorReset = m_phosphorReset;
+    m_phosphorReset = false;
+    // 余辉：自上一帧以来扫过的楔形（跨过北向时 to 超过360）
+    f.phosphorFrom = m_phosphorAngle;
+    f.phosphorTo = m_sweepAngle < m_phosphorAngle ? m_sweepAngle + 360.0f : m_sweepAngle;
+    m_phosphorAngle = m_sweepAngle;
+
+    f.haloId = m_highlightId;
+    f.haloLocked = m_highlightId != 0 && m_lockedId == m_highlightId;
+
+    // 攻击：目标按发起时的航迹句柄解析成批号（批号被新航迹复用后不再跟随）
+    f.attackSources.clear();
+    for (const auto &a : m_attacks)
     {
-        // 计算几何
-        const float R = circle.width() / 2.0f;
-        const QPointF c = circle.center();
-        // 扫描方向：从中心向外一条亮线 + 线后短扇形余辉
-        const float theta = qDegreesToRadians(90.0f - m_sweepAngle);
-        QPointF tip(c.x() + R * qCos(theta), c.y() - R * qSin(theta));
-
-        // 主扫描线
-        QPen pen(QColor(80, 220, 120), 2);
-        p.setPen(pen);
-        p.drawLine(c, tip);
-
-        // 余辉扇形（约6度宽，线性渐隐）
-        p.setPen(Qt::NoPen);
-        QConicalGradient grad(c, m_sweepAngle);
-        QColor head = QColor(100, 255, 140, 120);
-        QColor tail = QColor(0, 0, 0, 0);
-        grad.setColorAt(0.00, head);
-        grad.setColorAt(0.25, QColor(60, 180, 100, 60));
-        grad.setColorAt(1.00, tail);
-        p.setBrush(grad);
-
-        // 使用path绘制窄扇形
-        QPainterPath path;
-        path.moveTo(c);
-        // 扇形角宽（度）
-        const float span = 8.0f;
-        QRectF arcRect(circle);
-        // Qt的drawPie以3点钟方向为0度，逆时针为正，因此做一个角度换算：
-        float startAngle = -(m_sweepAngle + span / 2.0f) + 90.0f; // 转到Qt角度系
-        // 转为1/16度
-        int start16 = int(startAngle * 16.0f);
-        int span16 = int(span * 16.0f);
-        p.drawPie(arcRect, start16, span16);
+        const TrackModel::Track *tt = m_model->find(a.target);
+        f.attackSources.append({int(a.type), a.pos, tt ? tt->id : quint16(0)});
     }
+}
 
-    // 如果存在高亮目标，在其末端绘制外圈与更醒目标记
-    if (m_highlightId != 0)
+void RadarScopeWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    // 后台绘制：只贴最近完成的一帧
+    if (m_renderThread)
     {
-        auto it = std::find_if(m_trails.begin(), m_trails.end(), [&](const Trail &tr)
-                               { return tr.id == m_highlightId; });
-        if (it != m_trails.end() && !it->points.isEmpty())
-        {
-            const auto &last = it->points.back();
-            QPen haloPen;
-            if (m_lockedId == m_highlightId)
-                haloPen = QPen(QColor(220, 60, 60, 200)); // red when locked
-            else
-                haloPen = QPen(QColor(255, 255, 0, 180));
-            haloPen.setWidth(2);
-            p.setPen(haloPen);
-            p.setBrush(Qt::NoBrush);
-            p.drawEllipse(last.pos, 8, 8);
-            QFont f = p.font();
-            f.setBold(true);
-            f.setPointSize(10);
-            p.setFont(f);
-            p.setPen(QColor(255, 255, 200));
-            p.drawText(QRectF(last.pos.x() + 10, last.pos.y() - 12, 160, 16), Qt::AlignLeft | Qt::AlignVCenter, QStringLiteral("锁定目标 #%1").arg(it->id));
-        }
+        if (!m_renderThread->drawLatest(p, size(), palette().window().color()))
+            p.fillRect(rect(), palette().window());
+        return;
     }
 
-    // 绘制攻击（激光/导弹）
-    for (const auto &a : m_attacks)
+    ScopeFrame &f = m_frames[0];
+    QElapsedTimer timer;
+    timer.start();
+    snapshotFrame(f, QDateTime::currentMSecsSinceEpoch());
+    const qint64 snapshotNs = timer.nsecsElapsed();
+    ScopeRenderer::buildFrame(f);
+    const qint64 buildNs = timer.nsecsElapsed() - snapshotNs;
+
+    p.setRenderHint(QPainter::Antialiasing, true);
+    // 静态底图（量程圈、刻度、标签）：缓存的位图，只在尺寸、像素比或量程变化时重画；
+    // 扫描时余辉与它合成后一起贴（合成图只重算本帧变过的区域），不缓存底图时余辉半透明叠加
+    ScopeRenderer::stampPhosphor(m_phosphor, f);
+    if (m_backgroundCached)
     {
-        // find latest target pos
-        auto tit = std::find_if(m_trails.begin(), m_trails.end(), [&](const Trail &t)
-                                { return t.id == a.targetId; });
-        QPointF targetPos;
-        if (tit != m_trails.end() && !tit->points.isEmpty())
-            targetPos = tit->points.back().pos;
-        if (a.type == Attack::Laser)
+        const qreal dpr = p.device()->devicePixelRatioF();
+        const QSize px = size() * dpr;
+        if (m_backgroundDirty || m_background.size() != px || m_background.devicePixelRatio() != dpr)
+        {
+            m_background = QImage(px, QImage::Format_ARGB32_Premultiplied);
+            m_background.setDevicePixelRatio(dpr);
+            QPainter bp(&m_background);
+            bp.setRenderHint(QPainter::Antialiasing, true);
+            bp.setFont(font());
+            ScopeRenderer::drawStaticLayer(bp, QSizeF(size()), m_maxRange, palette().window().color());
+            m_backgroundDirty = false;
+        }
+        if (f.sweepOn)
         {
-            // laser: draw red line from center to target
-            QPen pen(QColor(255, 40, 40, 220));
-            pen.setWidth(3);
-            p.setPen(pen);
-            p.drawLine(circle.center(), targetPos);
+            m_phosphor.drawComposited(p, m_background);
         }
         else
         {
-            // missile: draw moving circle with tail
-            QColor color = (a.type == Attack::SlowMissile) ? QColor(120, 220, 120) : QColor(255, 200, 80);
-            p.setPen(Qt::NoPen);
-            p.setBrush(color);
-            p.drawEllipse(a.pos, 5, 5);
-            // tail
-            QPen tailPen(color.darker(), 2);
-            tailPen.setCapStyle(Qt::RoundCap);
-            p.setPen(tailPen);
-            p.drawLine(a.pos, targetPos);
+            // 底图不透明，直接拷贝，不做混合
+            p.setCompositionMode(QPainter::CompositionMode_Source);
+            p.drawImage(QPointF(0, 0), m_background);
+            p.setCompositionMode(QPainter::CompositionMode_SourceOver);
         }
     }
+    else
+    {
+        ScopeRenderer::drawStaticLayer(p, QSizeF(size()), m_maxRange, palette().window().color());
+        if (f.sweepOn)
+            m_phosphor.draw(p);
+    }
+
+    ScopeRenderer::drawDynamicLayer(p, f);
+    ++m_paintStats.frames;
+    m_paintStats.snapshot.add(snapshotNs);
+    m_paintStats.build.add(buildNs);
+    m_paintStats.raster.add(timer.nsecsElapsed() - snapshotNs - buildNs);
+}
+
+void RadarScopeWidget::setThreadedRendering(bool on)
+{
+    if (on == bool(m_renderThread))
+        return;
+    if (on)
+    {
+        m_renderThread.reset(new ScopeRenderThread);
+        // 绘制线程发出，排队到 GUI 线程贴图
+        connect(m_renderThread.get(), &ScopeRenderThread::frameReady, this, qOverload<>(&QWidget::update));
+    }
+    else
+    {
+        m_renderThread.reset();
+    }
+    // 换了一块余辉缓冲，从空白开始；耗时按模式重新计
+    m_phosphorReset = true;
+    m_paintStats = ScopeRenderStats();
+    requestFrame();
+}
+
+ScopeRenderStats RadarScopeWidget::renderStats() const
+{
+    if (!m_renderThread)
+        return m_paintStats;
+    // 生成与光栅化在绘制线程计，快照与推迟的帧在 GUI 线程计
+    ScopeRenderStats s = m_renderThread->stats();
+    s.deferred = m_paintStats.deferred;
+    s.snapshot = m_paintStats.snapshot;
+    return s;
+}
+
+void RadarScopeWidget::mousePressEvent(QMouseEvent *e)
+{
+    if (e->button() != Qt::LeftButton)
+    {
+        QWidget::mousePressEvent(e);
+        return;
+    }
+    // 屏幕 -> 东-北（米），点选容差按当前比例换算成米
+    const QTransform &view = viewTransform();
+    const QPointF world = view.inverted().map(e->position());
+    const int id = m_model->pick(world, float(PickRadiusPx / view.m11()), QDateTime::currentMSecsSinceEpoch());
+    if (id < 0)
+    {
+        // 点空白处取消高亮
+        highlightTarget(0);
+        return;
+    }
+    highlightTarget(quint16(id));
+    emit targetPicked(quint16(id));
 }
 
 void RadarScopeWidget::highlightTarget(quint16 id)
 {
     m_highlightId = id;
-    update();
+    requestFrame();
 }
 
 void RadarScopeWidget::setSearchActive(bool on)
@@ -493,27 +454,23 @@ void RadarScopeWidget::setSearchActive(bool on)
     if (m_sweepOn)
     {
         m_sweepAngle = 0.0f;
-        if (!m_sweepTimer.isActive())
-            m_sweepTimer.start();
-    }
-    else
-    {
-        m_sweepTimer.stop();
+        m_phosphorAngle = 0.0f;
+        m_phosphorReset = true;
     }
-    update();
+    requestFrame();
 }
 
 void RadarScopeWidget::clearTrails()
 {
-    m_trails.clear();
     m_notices.clear();
-    update();
+    m_model->clear();
+    requestFrame();
 }
 
 void RadarScopeWidget::lockTarget(quint16 id)
 {
     m_lockedId = id;
-    update();
+    requestFrame();
 }
 
 void RadarScopeWidget::engageTarget(quint16 id)
@@ -528,34 +485,33 @@ void RadarScopeWidget::engageTarget(quint16 id)
         return;
     }
     // find trail to get starting pos and type
-    auto it = std::find_if(m_trails.begin(), m_trails.end(), [&](const Trail &t)
-                           { return t.id == id; });
-    if (it == m_trails.end() || it->points.empty())
+    const TrackModel::Track *t = m_model->find(id);
+    if (!t || t->trail.isEmpty())
         return;
-    const QPointF targetPos = it->points.back().pos;
-    // compute threat score to select weapon type: low score->laser, mid->slow missile, high->fast missile
-    float score = computeThreatScore(*it);
+    // threat tier (from the model's scorer) selects weapon type: 0->laser, 1->slow missile, 2->fast missile
+    const quint8 tier = t->tier;
     Attack a;
     a.targetId = id;
+    a.target = m_model->handle(id);
     a.startMs = QDateTime::currentMSecsSinceEpoch();
-    if (score < 0.3f)
+    if (tier == 0)
     {
         a.type = Attack::Laser;
         a.pos = QPointF(0, 0); // unused for laser
     }
-    else if (score < 0.7f)
+    else if (tier == 1)
     {
         a.type = Attack::SlowMissile;
-        // start from radar center
-        a.pos = rect().center();
-        a.speed = 120.0f; // pixels/s (slow)
+        // start from the radar (origin of the east/north frame)
+        a.pos = QPointF(0, 0);
+        a.speed = 1500.0f; // m/s (slow), about 3 s across the default 5 km range
     }
     else
     {
         a.type = Attack::FastMissile;
-        a.pos = rect().center();
-        a.speed = 300.0f; // pixels/s (fast)
+        a.pos = QPointF(0, 0);
+        a.speed = 4000.0f; // m/s (fast)
     }
     m_attacks.push_back(a);
-    update();
+    requestFrame();
 }
@@ -2,31 +2,57 @@
 #pragma once
 
 #include <QWidget>
+#include <QElapsedTimer>
+#include <QImage>
 #include <QVector>
 #include <QTimer>
 #include <QPointF>
-#include "TrackMessage.h"
+#include <QTransform>
+#include "ScopeRenderer.h"
+#include "ScopeScene.h"
+#include "TrackModel.h"
 #include <QString>
+#include <memory>
 
 // 简单的圆形雷达显示器：
 // - 以正北向上，顺时针为正角；
 // - 支持设置显示半径（米）；
-// - 接收 TrackMessage 实时绘点与航迹；
-// - 显示最近若干条轨迹的折线和末端点。
+// - 航迹与轨迹来自 TrackModel（与目标列表共用）；
+// - 只有一个绘制时钟（帧率上限 maxFps）：数据变化只标记需要重绘，扫描线与攻击在同一个 tick 推进，
+//   每个 tick 至多重绘一次；没有东西在动时降到 idleFps；
+// - 轨迹以雷达为原点的东-北坐标（米）保存，绘制时经同一个缓存的变换投影到屏幕，
+//   改变窗口大小或量程不需要重算历史点；
+// - 显示最近若干条轨迹的折线和末端点；轨迹线段按透明度分档，每档一次批量绘制；末端点按显示时刻的滤波预测位置绘制，导弹按预测的相遇点提前瞄准；
+// - 扫描线的余辉是一块跨帧保留的荧光屏缓冲：每帧只盖上新扫过的楔形与其中的目标，按扫过后的时间渐暗；
+// - 量程圈、刻度与标签画在按设备像素比缓存的底图上，只在尺寸、像素比或量程变化时重画；
+// - 航迹按模型发布的变化增量同步到 ScopeScene 镜像；每帧 GUI 线程只填写 ScopeFrame 的输入，
+//   投影、分档、预测与光栅化由 ScopeRenderer 完成：默认在 paintEvent 里；setThreadedRendering(true) 时
+//   全部交给后台线程画到双缓冲 QImage，tick 里只剩镜像同步，paintEvent 只贴图，界面响应不随航迹数变慢；
+// - 左键点击末端点附近可选中并高亮目标。
 class RadarScopeWidget : public QWidget
 {
     Q_OBJECT
 public:
     explicit RadarScopeWidget(QWidget *parent = nullptr);
+    ~RadarScopeWidget() override;
 
+    // 量程不变时直接返回（状态帧每帧都会设置）
     void setMaxRangeMeters(float r);
     float maxRangeMeters() const { return m_maxRange; }
+    // 轨迹按透明度分几档批量绘制（默认8；档数越多淡出越平滑，绘制调用数随之增加）
+    void setTrailAlphaBuckets(int n);
+    int trailAlphaBuckets() const { return m_trailBuckets; }
+    // 后台线程生成并光栅化（默认关）；renderStats 为每帧各阶段的耗时（见 ScopeRenderStats）
+    void setThreadedRendering(bool on);
+    bool threadedRendering() const { return bool(m_renderThread); }
+    ScopeRenderStats renderStats() const;
+    // 静态底图是否缓存为位图（默认开；关闭时每帧重画，用于对比基准）
+    void setBackgroundCached(bool on);
+    bool backgroundCached() const { return m_backgroundCached; }
 
-    // 轨迹保留策略（默认：保留5分钟，单条轨迹最多2000点）
-    void setTrailRetentionMs(qint64 ms) { m_trailKeepMs = qMax<qint64>(1000, ms); }
-    qint64 trailRetentionMs() const { return m_trailKeepMs; }
-    void setMaxTrailPoints(int n) { m_maxTrailPoints = qMax(10, n); }
-    int maxTrailPoints() const { return m_maxTrailPoints; }
+    // 航迹数据源（默认自带一个模型；与其他视图共用时传入共享模型，不转移所有权）
+    void setTrackModel(TrackModel *model);
+    TrackModel *trackModel() const { return m_model; }
 
     // 事件提示（仅显示关键信息，如“发现新目标”）
     void setShowNotices(bool on) { m_showNotices = on; }
@@ -37,8 +63,11 @@ public:
 signals:
     // notify that a target has been destroyed (so other UI can remove it)
     void targetHit(quint16 id);
+    // 在雷达盘上点选了目标（已在盘上高亮）
+    void targetPicked(quint16 id);
 
 public slots:
+    // 原始航迹报文：解析后应用到模型
     void onTrackDatagram(const QByteArray &data);
     void highlightTarget(quint16 id);
     // 请求锁定（界面变色）
@@ -48,14 +77,33 @@ public slots:
     // 开/关搜索扫描线
     void setSearchActive(bool on);
     void setSweepSpeedDegPerSec(float degPerSec) { m_sweepSpeed = qBound(1.0f, degPerSec, 360.0f); }
-    // 清空当前显示的目标轨迹
+    // 扫描余辉的衰减时间常数（毫秒，默认1500）：扫过后经过这么久亮度降到 1/e
+    void setPhosphorDecayMs(qint64 ms);
+    qint64 phosphorDecayMs() const { return m_phosphorDecayMs; }
+    // 绘制帧率上限（默认60）与空闲时的刷新频率（默认4）
+    void setMaxFps(int fps);
+    int maxFps() const { return m_maxFps; }
+    void setIdleFps(int fps);
+    int idleFps() const { return m_idleFps; }
+    // 清空当前显示的目标轨迹（清空模型，其他视图同步）
     void clearTrails();
 
+private slots:
+    void onModelChanged(const TrackChangeSet &changes);
+    // 绘制时钟：推进扫描线与攻击，需要时重绘，并按是否有动画选择下一个 tick 的间隔
+    void onFrameTick();
+
 protected:
     void paintEvent(QPaintEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
+    void changeEvent(QEvent *e) override;
+    // 左键点选：按末端点的显示（预测）位置取点击处附近最近的航迹（TrackModel::pick）
+    void mousePressEvent(QMouseEvent *e) override;
     QSize minimumSizeHint() const override { return {360, 360}; }
 
 private:
+    // locked target id -> show red halo
+    quint16 m_lockedId{0};
     struct Attack
     {
         enum Type
@@ -65,67 +113,62 @@ private:
             FastMissile
         } type;
         quint16 targetId;
-        QPointF pos; // current position of the attack
+        TrackModel::Tracks::Handle target; // 发起时的航迹，批号被新航迹复用后不再跟随
+        QPointF pos;                       // current position of the attack (east/north metres)
         qint64 startMs;
         bool finished{false};
-        // for missiles: velocity pixels per second
+        // for missiles: velocity metres per second
         float speed{0.0f};
         // for laser: lifetime ms
     };
     QVector<Attack> m_attacks;
-    // locked target id -> show red halo
-    quint16 m_lockedId{0};
-    struct TrailPoint
-    {
-        QPointF pos;
-        qint64 ms;
-    };
-    struct Trail
-    {
-        quint16 id;
-        QVector<TrailPoint> points;
-        quint8 targetType{0};
-        quint8 targetSize{0};
-        float lastSpeed{0.0f};
-        float lastDistance{0.0f};
-        bool identityKnown{false};
-    };
     struct Notice
     {
         QString text;
         qint64 ms;
     };
 
-    // helper to convert type/size to short label
-    static QString typeSizeLabel(int type, int size);
-    // 计算威胁分（0..1）
-    float computeThreatScore(const Trail &t) const;
-
-    // 可调参数（默认值按需求）
-    float m_weightDistance = 0.3f;
-    float m_weightSpeed = 0.3f;
-    float m_weightType = 0.2f;
-    float m_weightIdentity = 0.2f;
-    float m_maxSpeed = 100.0f; // m/s，用于速度归一化
-
-    QPointF polarToPoint(float distance_m, float azimuth_deg, const QRectF &circle) const;
+    // 标记需要重绘（下一个 tick 处理），时钟处于空闲频率时切回全速
+    void requestFrame();
+    bool isAnimating(qint64 now) const;
+    // 导弹按 dt 秒飞行，激光到时命中
+    void advanceAttacks(qint64 now, float dt);
+    // 东-北（米）-> 屏幕像素：原点在窗口中心，北向上，量程对应 0.48 倍短边；尺寸或量程变化后重算
+    const QTransform &viewTransform();
+    // 同步航迹镜像并填写本帧的输入（GUI 线程；后台绘制时只在绘制线程空闲时调用），顺带清理过期提示
+    void snapshotFrame(ScopeFrame &f, qint64 now);
 
-    float m_maxRange = 5000.0f; // 默认5km
-    QVector<Trail> m_trails;    // 多目标轨迹
+    float m_maxRange = 5000.0f;   // 默认5km
+    TrackModel *m_model{nullptr}; // 航迹数据源
+    ScopeScene m_scene;           // 绘制用的航迹镜像，后台绘制时由绘制线程读；轨迹缓冲计入模型的内存预算
     quint16 m_highlightId{0};
-    QTimer m_cleanupTimer; // 周期清理过期航迹
-    QTimer m_attackTimer;  // 更新攻击行为（导弹移动、激光寿命）
+    QTransform m_view;       // 东-北（米）-> 屏幕，见 viewTransform()
+    bool m_viewDirty = true;
+    QImage m_background; // 静态底图，设备像素大小（余辉合成要逐像素读，不用 QPixmap）
+    bool m_backgroundDirty = true;
+    bool m_backgroundCached = true;
+    int m_trailBuckets = 8;
+    ScopeFrame m_frames[2]; // 绘制数据，跨帧复用；后台绘制时轮流使用
+    int m_nextFrame = 0;
+    ScopeRenderStats m_paintStats; // 同步绘制的各阶段耗时；后台绘制时只记 snapshot 与 deferred
+    std::unique_ptr<ScopeRenderThread> m_renderThread; // 须后于 m_frames、m_scene 声明（先析构，线程先停）
+    QTimer m_frameTimer;        // 绘制时钟
+    QElapsedTimer m_frameClock; // tick 间隔按实际经过时间计
+    qint64 m_lastTickNs = -1;
+    bool m_dirty = true;        // 自上一个 tick 以来有变化
+    int m_maxFps = 60;
+    int m_idleFps = 4;
 
-    // 减少默认保留时长与点数以降低内存与绘制负担
-    qint64 m_trailKeepMs = 60ll * 1000ll; // 保留60秒
-    int m_maxTrailPoints = 500;           // 每条轨迹最大采样点
     bool m_showNotices = true;
     qint64 m_noticeKeepMs = 3000; // 提示保留3s
     QVector<Notice> m_notices;    // 左上角提示
 
     // 扫描线（搜索模式）
     bool m_sweepOn = false;
-    QTimer m_sweepTimer;        // 动画定时器
-    float m_sweepAngle = 0.0f;  // 0..360，北为0，顺时针增加
-    float m_sweepSpeed = 60.0f; // deg/s
+    float m_sweepAngle = 0.0f;    // 0..360，北为0，顺时针增加
+    float m_sweepSpeed = 60.0f;   // deg/s
+    PhosphorLayer m_phosphor;     // 余辉缓冲（同步绘制时用；后台绘制时由绘制线程持有一份）
+    float m_phosphorAngle = 0.0f; // 余辉已盖到的角度
+    qint64 m_phosphorDecayMs = 1500;
+    bool m_phosphorReset = true;
 };
@@ -4,23 +4,6 @@
 #include <QStringList>
 #include <cstring>
 
-static quint16 rd_u16(const uchar *p) { return qFromLittleEndian<quint16>(p); }
-static quint32 rd_u32(const uchar *p) { return qFromLittleEndian<quint32>(p); }
-static float rd_f32(const uchar *p)
-{
-    quint32 bits = rd_u32(p);
-    float f;
-    memcpy(&f, &bits, sizeof(f));
-    return f;
-}
-static double rd_f64(const uchar *p)
-{
-    quint64 bits = qFromLittleEndian<quint64>(p);
-    double d;
-    memcpy(&d, &bits, sizeof(d));
-    return d;
-}
-
 QString RadarStatus::hwFaultText() const
 {
     QStringList items;
@@ -70,74 +53,66 @@ QString RadarStatus::antPowerModeText() const
     }
 }
 
-bool RadarStatusParser::parseLittleEndian(const QByteArray &payload, RadarStatus &out)
+bool RadarStatusView::fromBytes(const uchar *data, int size, RadarStatusView &out)
 {
-    const int needMin = 32 /*head*/ + 4 + 1 + 1 + 2 + 1 + 1 + 1 + 1 + 8 + 8 + 4 + 4 + 4 + 4 + 8 + 21 + 32 + 4 + 1 + 16 + 8 + 16 + 2 + 2 + 12 + 2;
-    if (payload.size() < needMin)
+    // 32(head) + 4 + 1 + 1 + 2 + 1 + 1 + 1 + 1 + 8 + 8 + 4 + 4 + 4 + 4 + 8 + 21 + 32 + 4 + 1 + 16 + 8 + 16 + 2 + 2 + 12 + 2
+    if (!data || size < Size)
         return false;
+    out = RadarStatusView(data, size);
+    return true;
+}
 
-    const uchar *p = reinterpret_cast<const uchar *>(payload.constData());
-    int off = 0;
+bool RadarStatusView::fromBytes(const QByteArray &payload, RadarStatusView &out)
+{
+    return fromBytes(reinterpret_cast<const uchar *>(payload.constData()), int(payload.size()), out);
+}
 
-    out = RadarStatus{};
-    out.frameHead = QByteArray(reinterpret_cast<const char *>(p), 32);
-    off += 32;
+void RadarStatusView::toStatus(RadarStatus &out) const
+{
+    copyTo(out.frameHead, 0, 32);
 
     // 异常代码 4B: hw(1) + sw(3)
-    out.hwFault = p[off];
-    out.swFault24 = (quint32)p[off + 1] | ((quint32)p[off + 2] << 8) | ((quint32)p[off + 3] << 16);
-    off += 4;
-
-    out.workState = p[off++];
-    out.reserved1 = p[off++];
-    out.detectRange = rd_u16(p + off);
-    off += 2;
-    out.insValid = p[off++] == 0x01;
-    out.simOn = p[off++] == 0x01;
-    out.retracted = p[off++] == 0x01;
-    out.driving = p[off++] == 0x01;
-
-    out.longitude = rd_f64(p + off);
-    off += 8;
-    out.latitude = rd_f64(p + off);
-    off += 8;
-    out.altitude = rd_f32(p + off);
-    off += 4;
-    out.yaw = rd_f32(p + off);
-    off += 4;
-    out.pitch = rd_f32(p + off);
-    off += 4;
-    out.roll = rd_f32(p + off);
-    off += 4;
-
-    out.reserved2_8 = QByteArray(reinterpret_cast<const char *>(p + off), 8);
-    off += 8;
-    out.verReserved_21 = QByteArray(reinterpret_cast<const char *>(p + off), 21);
-    off += 21;
-    out.infoReserved_32 = QByteArray(reinterpret_cast<const char *>(p + off), 32);
-    off += 32;
-
-    out.freqGHz = rd_f32(p + off);
-    off += 4;
-    out.antPowerMode = p[off++];
-
-    out.antReserved_16 = QByteArray(reinterpret_cast<const char *>(p + off), 16);
-    off += 16;
-    out.chanReserved_8 = QByteArray(reinterpret_cast<const char *>(p + off), 8);
-    off += 8;
-    out.servoReserved_16 = QByteArray(reinterpret_cast<const char *>(p + off), 16);
-    off += 16;
-
-    out.silentStart = rd_u16(p + off);
-    off += 2;
-    out.silentEnd = rd_u16(p + off);
-    off += 2;
-
-    out.reserved3_12 = QByteArray(reinterpret_cast<const char *>(p + off), 12);
-    off += 12;
-    out.checksum = rd_u16(p + off);
-    off += 2;
-
-    Q_UNUSED(off);
+    out.hwFault = hwFault();
+    out.swFault24 = swFault24();
+
+    out.workState = workState();
+    out.reserved1 = u8(37);
+    out.detectRange = detectRange();
+    out.insValid = insValid();
+    out.simOn = simOn();
+    out.retracted = retracted();
+    out.driving = driving();
+
+    out.longitude = longitude();
+    out.latitude = latitude();
+    out.altitude = altitude();
+    out.yaw = yaw();
+    out.pitch = pitch();
+    out.roll = roll();
+
+    copyTo(out.reserved2_8, 76, 8);
+    copyTo(out.verReserved_21, 84, 21);
+    copyTo(out.infoReserved_32, 105, 32);
+
+    out.freqGHz = freqGHz();
+    out.antPowerMode = antPowerMode();
+
+    copyTo(out.antReserved_16, 142, 16);
+    copyTo(out.chanReserved_8, 158, 8);
+    copyTo(out.servoReserved_16, 166, 16);
+
+    out.silentStart = silentStart();
+    out.silentEnd = silentEnd();
+
+    copyTo(out.reserved3_12, 186, 12);
+    out.checksum = checksum();
+}
+
+bool RadarStatusParser::parseLittleEndian(const QByteArray &payload, RadarStatus &out)
+{
+    RadarStatusView view;
+    if (!RadarStatusView::fromBytes(payload, view))
+        return false;
+    view.toStatus(out);
     return true;
 }
@@ -4,13 +4,16 @@
 #include <QtGlobal>
 #include <QByteArray>
 #include <QString>
+#include "FrameView.h"
 
 // 依据“表24 雷达状态报文”定义的解析结果（假定小端字节序，帧头32字节）。
 // 若后续协议明确了校验与消息ID，再完善对应校验与判别。
+// 热路径使用 RadarStatusView 直接读接收缓冲；RadarStatus 仅在需要保存数据时使用，
+// 预留字段均为定长数组，拷贝不分配堆内存。
 struct RadarStatus
 {
-    // 原始帧头（32字节，暂不细分字段）
-    QByteArray frameHead; // size==32
+    // 原始帧头（32字节，字段见 Protocol::FrameHeader）
+    quint8 frameHead[32]{};
 
     // 异常代码
     quint8 hwFault{};    // [0] 硬件故障位：bit0 天线, bit1 伺服, bit2 惯导
@@ -31,22 +34,22 @@ struct RadarStatus
     float pitch{};      // -90~90 度
     float roll{};       // -90~90 度
 
-    QByteArray reserved2_8;     // 8B
-    QByteArray verReserved_21;  // 21B
-    QByteArray infoReserved_32; // 32B
+    quint8 reserved2_8[8]{};      // 8B
+    quint8 verReserved_21[21]{};  // 21B
+    quint8 infoReserved_32[32]{}; // 32B
 
     float freqGHz{};       // 频点 GHz（默认15.80）
     quint8 antPowerMode{}; // 天线上电模式 0~3
 
-    QByteArray antReserved_16;   // 16B
-    QByteArray chanReserved_8;   // 8B
-    QByteArray servoReserved_16; // 16B
+    quint8 antReserved_16[16]{};   // 16B
+    quint8 chanReserved_8[8]{};    // 8B
+    quint8 servoReserved_16[16]{}; // 16B
 
     quint16 silentStart{}; // 静默区起点 [0..36000] (0.01deg)
     quint16 silentEnd{};   // 静默区终点 [0..36000]
 
-    QByteArray reserved3_12; // 12B
-    quint16 checksum{};      // 校验位（未校验）
+    quint8 reserved3_12[12]{}; // 12B
+    quint16 checksum{};        // 校验位（未校验）
 
     // 简易可读文本
     QString hwFaultText() const;
@@ -55,6 +58,43 @@ struct RadarStatus
     QString antPowerModeText() const;
 };
 
+// 状态报文（200字节）的非拥有视图，字段直接从接收缓冲读取，不分配内存
+class RadarStatusView : public FrameView
+{
+public:
+    static constexpr int Size = 200;
+
+    RadarStatusView() = default;
+    // 长度不足返回false
+    static bool fromBytes(const uchar *data, int size, RadarStatusView &out);
+    static bool fromBytes(const QByteArray &payload, RadarStatusView &out);
+
+    quint8 hwFault() const { return u8(32); }
+    quint32 swFault24() const { return quint32(u8(33)) | (quint32(u8(34)) << 8) | (quint32(u8(35)) << 16); }
+    quint8 workState() const { return u8(36); }
+    quint16 detectRange() const { return u16(38); }
+    bool insValid() const { return u8(40) == 0x01; }
+    bool simOn() const { return u8(41) == 0x01; }
+    bool retracted() const { return u8(42) == 0x01; }
+    bool driving() const { return u8(43) == 0x01; }
+    double longitude() const { return f64(44); }
+    double latitude() const { return f64(52); }
+    float altitude() const { return f32(60); }
+    float yaw() const { return f32(64); }
+    float pitch() const { return f32(68); }
+    float roll() const { return f32(72); }
+    float freqGHz() const { return f32(137); }
+    quint8 antPowerMode() const { return u8(141); }
+    quint16 silentStart() const { return u16(182); }
+    quint16 silentEnd() const { return u16(184); }
+    quint16 checksum() const { return u16(198); }
+
+    void toStatus(RadarStatus &out) const;
+
+private:
+    RadarStatusView(const uchar *data, int size) : FrameView(data, size) {}
+};
+
 namespace RadarStatusParser
 {
     // 成功返回true；若长度不足或字段异常返回false。
@@ -1,5 +1,7 @@
 // RadarStatusWidget.cpp
 #include "RadarStatusWidget.h"
+#include "Protocol.h"
+#include "MessageIds.h"
 #include <QGroupBox>
 #include <QVBoxLayout>
 
@@ -55,12 +57,20 @@ void RadarStatusWidget::setText(QLabel *lab, const QString &text)
 
 void RadarStatusWidget::onRadarDatagram(const QByteArray &data)
 {
+    Protocol::FrameHeader head;
+    if (!Protocol::parseFrameHeader(data, head) || head.msgIdRadar != ProtocolIds::RadarStatusReport)
+        return;
     RadarStatus s;
     if (!RadarStatusParser::parseLittleEndian(data, s))
     {
         // 非状态报文：忽略，不改变当前显示；由超时计时器决定断开显示
         return;
     }
+    onRadarStatus(s);
+}
+
+void RadarStatusWidget::onRadarStatus(const RadarStatus &s)
+{
     setStatus(s);
     m_inactiveTimer.start();
 }
@@ -15,6 +15,8 @@ public:
 
 public slots:
     void onRadarDatagram(const QByteArray &data);
+    // 已解析的状态报文（由采集线程解析后分发）
+    void onRadarStatus(const RadarStatus &s);
     void setStatus(const RadarStatus &s);
 
 private:
@@ -0,0 +1,189 @@
+// RecordingReader.cpp
+#include "RecordingReader.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+using namespace RecordFormat;
+
+RecordingReader::RecordingReader() = default;
+
+RecordingReader::~RecordingReader()
+{
+    close();
+}
+
+bool RecordingReader::open(const QString &path)
+{
+    close();
+    const QFileInfo fi(path);
+    QStringList files;
+    if (fi.isDir())
+    {
+        const QDir dir(path);
+        for (const QString &name : dir.entryList({QStringLiteral("radar-*.rec")}, QDir::Files, QDir::Name))
+            files.append(dir.absoluteFilePath(name));
+    }
+    else
+    {
+        files.append(path);
+    }
+    for (const QString &f : files)
+        addSegment(f); // 单个坏段只跳过，errorString 保留原因
+    if (m_segments.empty())
+    {
+        if (m_error.isEmpty())
+            m_error = QStringLiteral("no recorded datagrams in %1").arg(path);
+        return false;
+    }
+    // 不同运行的段按UTC时间排列
+    std::stable_sort(m_segments.begin(), m_segments.end(), [](const Segment &a, const Segment &b)
+                     { return a.firstUtc < b.firstUtc; });
+    rewind();
+    return true;
+}
+
+void RecordingReader::close()
+{
+    for (Segment &seg : m_segments)
+    {
+        seg.file->unmap(const_cast<uchar *>(seg.map));
+        seg.file->close();
+    }
+    m_segments.clear();
+    m_records = 0;
+    m_seg = 0;
+    m_off = 0;
+}
+
+bool RecordingReader::addSegment(const QString &path)
+{
+    std::unique_ptr<QFile> file(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        m_error = QStringLiteral("cannot open %1").arg(path);
+        return false;
+    }
+    const qint64 size = file->size();
+    if (size < DataOffset)
+    {
+        m_error = QStringLiteral("%1 is too short").arg(path);
+        return false;
+    }
+    const uchar *map = file->map(0, size);
+    if (!map)
+    {
+        m_error = QStringLiteral("cannot map %1").arg(path);
+        return false;
+    }
+    SegmentHeader h;
+    memcpy(&h, map, sizeof(h));
+    if (memcmp(h.magic, Magic, sizeof(h.magic)) != 0 || h.version != Version || h.dataOffset != quint32(DataOffset) ||
+        h.records == 0)
+    {
+        if (h.records != 0)
+            m_error = QStringLiteral("%1 is not a recording").arg(path);
+        file->unmap(const_cast<uchar *>(map));
+        return false;
+    }
+
+    Segment seg;
+    seg.map = map;
+    seg.used = qMin<quint64>(h.usedBytes, quint64(size));
+    seg.monoToUtc = h.wallStartMs * 1000000 - h.monoStartNs;
+    seg.firstUtc = h.firstNs + seg.monoToUtc;
+    seg.lastUtc = h.lastNs + seg.monoToUtc;
+    seg.records = h.records;
+    seg.indexCount = qMin<quint32>(h.indexCount, quint32(IndexEntries));
+    seg.indexStride = h.indexStride;
+    seg.file = std::move(file);
+    m_records += seg.records;
+    m_segments.push_back(std::move(seg));
+    return true;
+}
+
+qint64 RecordingReader::startUtcNs() const
+{
+    return m_segments.empty() ? 0 : m_segments.front().firstUtc;
+}
+
+qint64 RecordingReader::endUtcNs() const
+{
+    qint64 t = 0;
+    for (const Segment &seg : m_segments)
+        t = qMax(t, seg.lastUtc);
+    return t;
+}
+
+const RecordHeader *RecordingReader::headerAt(const Segment &seg, quint64 off) const
+{
+    if (off + sizeof(RecordHeader) > seg.used)
+        return nullptr;
+    // 记录按8字节对齐，段映射按页对齐，可直接按结构体访问
+    const auto *rh = reinterpret_cast<const RecordHeader *>(seg.map + off);
+    if (rh->monoNs == 0 || off + sizeof(RecordHeader) + rh->length > seg.used)
+        return nullptr; // 未写完或段尾
+    return rh;
+}
+
+void RecordingReader::rewind()
+{
+    m_seg = 0;
+    m_off = DataOffset;
+}
+
+bool RecordingReader::seek(qint64 utcNs)
+{
+    // 第一个结束时间不早于目标的段
+    const auto it = std::lower_bound(m_segments.begin(), m_segments.end(), utcNs, [](const Segment &s, qint64 t)
+                                     { return s.lastUtc < t; });
+    m_seg = int(it - m_segments.begin());
+    m_off = DataOffset;
+    if (it == m_segments.end())
+        return false;
+
+    const Segment &seg = *it;
+    if (utcNs > seg.firstUtc && seg.indexCount > 0)
+    {
+        // 段内索引：从最后一个早于目标的索引项开始扫
+        const auto *idx = reinterpret_cast<const IndexEntry *>(seg.map + HeaderBytes);
+        const IndexEntry *e = std::lower_bound(idx, idx + seg.indexCount, utcNs, [&seg](const IndexEntry &x, qint64 t)
+                                               { return x.monoNs + seg.monoToUtc < t; });
+        if (e != idx)
+            m_off = (e - 1)->offset;
+    }
+    while (const RecordHeader *rh = headerAt(seg, m_off))
+    {
+        if (rh->monoNs + seg.monoToUtc >= utcNs)
+            return true;
+        m_off += recordBytes(int(rh->length));
+    }
+    // 段头时间范围比实际可读数据新（未关闭的段）：从下一段开头继续
+    ++m_seg;
+    m_off = DataOffset;
+    return m_seg < int(m_segments.size());
+}
+
+bool RecordingReader::next(Record &out)
+{
+    while (m_seg < int(m_segments.size()))
+    {
+        const Segment &seg = m_segments[size_t(m_seg)];
+        const RecordHeader *rh = headerAt(seg, m_off);
+        if (!rh)
+        {
+            ++m_seg;
+            m_off = DataOffset;
+            continue;
+        }
+        out.direction = Direction(rh->direction);
+        out.utcNs = rh->monoNs + seg.monoToUtc;
+        out.data = reinterpret_cast<const char *>(rh + 1);
+        out.size = int(rh->length);
+        m_off += recordBytes(out.size);
+        return true;
+    }
+    return false;
+}
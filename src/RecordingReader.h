@@ -0,0 +1,73 @@
+// RecordingReader.h
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "DatagramRecorder.h"
+
+class QFile;
+
+// DatagramRecorder 记录文件的只读访问：
+// - 打开单个段文件或整个记录目录，各段只读映射，记录载荷直接指向映射内存；
+// - 时间轴统一换算为UTC纳秒（段头的 wallStartMs 与 monoStartNs 对齐单调时钟），跨多次运行也有序；
+// - seek 先按段时间范围二分，再用段内稀疏索引二分，最后只顺序扫描一个索引间隔，不扫整个文件；
+// - 未正常关闭的段（程序异常退出或仍在记录）读到时间戳为0处为止。
+class RecordingReader
+{
+public:
+    struct Record
+    {
+        RecordFormat::Direction direction{RecordFormat::Rx};
+        qint64 utcNs{};     // UTC 纳秒
+        const char *data{}; // 指向映射内存，reader 关闭前有效
+        int size{};
+    };
+
+    RecordingReader();
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader &) = delete;
+    RecordingReader &operator=(const RecordingReader &) = delete;
+
+    // path 为 .rec 文件或目录（目录下全部 radar-*.rec）
+    bool open(const QString &path);
+    void close();
+    QString errorString() const { return m_error; }
+
+    int segmentCount() const { return int(m_segments.size()); }
+    quint64 recordCount() const { return m_records; }
+    qint64 startUtcNs() const;
+    qint64 endUtcNs() const;
+
+    // 定位到时间不早于 utcNs 的第一条记录；超出末尾返回 false
+    bool seek(qint64 utcNs);
+    void rewind();
+    // 顺序读取下一条；读完返回 false
+    bool next(Record &out);
+
+private:
+    struct Segment
+    {
+        std::unique_ptr<QFile> file;
+        const uchar *map{nullptr};
+        quint64 used{0};     // 可读数据结束偏移
+        qint64 monoToUtc{0}; // utcNs = monoNs + monoToUtc
+        qint64 firstUtc{0};
+        qint64 lastUtc{0};
+        quint64 records{0};
+        quint32 indexCount{0};
+        quint32 indexStride{0};
+    };
+
+    bool addSegment(const QString &file);
+    const RecordFormat::RecordHeader *headerAt(const Segment &seg, quint64 off) const;
+
+    std::vector<Segment> m_segments; // 按时间排序
+    quint64 m_records{0};
+    QString m_error;
+    // 读取位置
+    int m_seg{0};
+    quint64 m_off{0};
+};
@@ -0,0 +1,186 @@
+// RingBuffer.h
+#pragma once
+
+#include <QtGlobal>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include "BlockPool.h"
+
+// 单线程环形缓冲（航迹历史点）：
+// - push 追加到尾部，达到 maxSize 时覆盖最旧的一个，popFront/popBack 丢弃最旧/最新的一个，均为 O(1)，不搬移元素；
+// - 容量为2的幂，按需倍增到能容纳 maxSize 为止，短航迹不会预先占满最大点数的内存；
+// - 下标 0 为最旧、size()-1 为最新；存储最多分成两段连续区间（firstSpan/secondSpan），
+//   绘制时可按段整体提交；
+// - 存储可来自 BlockPool（setPool），未设置时直接向系统申请；shrinkTo 丢弃最旧的点并换用更小的缓冲，
+//   内存预算不足时由调用方用来让出历史。元素须可平凡复制（搬移用 memcpy）。
+template <typename T>
+class RingBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "RingBuffer 元素须可平凡复制");
+
+public:
+    struct Span
+    {
+        const T *data{nullptr};
+        int count{0};
+    };
+
+    RingBuffer() = default;
+    ~RingBuffer() { deallocate(); }
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+    RingBuffer(RingBuffer &&other) noexcept { take(other); }
+    RingBuffer &operator=(RingBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            deallocate();
+            take(other);
+        }
+        return *this;
+    }
+
+    // 之后的缓冲从 pool 取得；已有缓冲时先释放（内容清空）
+    void setPool(BlockPool *pool)
+    {
+        if (pool == m_pool)
+            return;
+        deallocate();
+        m_pool = pool;
+    }
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    int capacity() const { return m_capacity; }
+    qint64 bytes() const { return m_buf ? qint64(BlockPool::blockSize(storageBytes(m_capacity))) : 0; }
+
+    T &operator[](int i) { return m_buf[std::size_t((m_head + i) & m_mask)]; }
+    const T &operator[](int i) const { return m_buf[std::size_t((m_head + i) & m_mask)]; }
+    const T &front() const { return (*this)[0]; }
+    const T &back() const { return (*this)[m_size - 1]; }
+
+    // 追加；已有 maxSize 个时先丢弃最旧的（maxSize 变小后多出的也一并丢弃）
+    void push(const T &value, int maxSize)
+    {
+        maxSize = qMax(1, maxSize);
+        while (m_size >= maxSize)
+            popFront();
+        if (m_size == capacity())
+            grow();
+        new (m_buf + ((m_head + m_size) & m_mask)) T(value);
+        ++m_size;
+    }
+
+    void popFront()
+    {
+        if (m_size == 0)
+            return;
+        m_head = (m_head + 1) & m_mask;
+        --m_size;
+    }
+
+    // 丢弃最新的一个
+    void popBack()
+    {
+        if (m_size > 0)
+            --m_size;
+    }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    // 只保留最新的 keep 个（至少1个），缓冲缩到能容纳它们的最小容量；返回丢弃的个数
+    int shrinkTo(int keep)
+    {
+        keep = qMax(1, keep);
+        const int dropped = qMax(0, m_size - keep);
+        for (int i = 0; i < dropped; ++i)
+            popFront();
+        int cap = int(InitialCapacity);
+        while (cap < m_size)
+            cap *= 2;
+        if (m_buf && cap < m_capacity)
+            reallocate(cap);
+        return dropped;
+    }
+
+    // 按时间先后的两段连续存储：firstSpan 在前，secondSpan 为回绕后的部分（可能为空）
+    Span firstSpan() const
+    {
+        if (m_size == 0)
+            return {};
+        return {m_buf + m_head, qMin(m_size, m_capacity - m_head)};
+    }
+    Span secondSpan() const
+    {
+        const int n = m_size - firstSpan().count;
+        return {n > 0 ? m_buf : nullptr, n};
+    }
+
+private:
+    static std::size_t storageBytes(int capacity) { return std::size_t(capacity) * sizeof(T); }
+
+    void grow() { reallocate(m_buf ? m_capacity * 2 : int(InitialCapacity)); }
+
+    void reallocate(int capacity)
+    {
+        // 按逻辑顺序搬到新缓冲（最多两段），head 归零
+        const std::size_t bytes = storageBytes(capacity);
+        T *buf = static_cast<T *>(m_pool ? m_pool->acquire(bytes) : ::operator new(bytes));
+        const Span a = firstSpan(), b = secondSpan();
+        if (a.count)
+            std::memcpy(static_cast<void *>(buf), a.data, std::size_t(a.count) * sizeof(T));
+        if (b.count)
+            std::memcpy(static_cast<void *>(buf + a.count), b.data, std::size_t(b.count) * sizeof(T));
+        const int size = m_size;
+        deallocate();
+        m_buf = buf;
+        m_capacity = capacity;
+        m_mask = capacity - 1;
+        m_size = size;
+    }
+
+    void deallocate()
+    {
+        if (m_buf)
+        {
+            if (m_pool)
+                m_pool->release(m_buf, storageBytes(m_capacity));
+            else
+                ::operator delete(m_buf);
+        }
+        m_buf = nullptr;
+        m_capacity = 0;
+        m_mask = 0;
+        m_head = 0;
+        m_size = 0;
+    }
+
+    void take(RingBuffer &other)
+    {
+        m_pool = other.m_pool;
+        m_buf = other.m_buf;
+        m_capacity = other.m_capacity;
+        m_mask = other.m_mask;
+        m_head = other.m_head;
+        m_size = other.m_size;
+        other.m_buf = nullptr;
+        other.m_capacity = 0;
+        other.m_mask = 0;
+        other.m_head = 0;
+        other.m_size = 0;
+    }
+
+    static constexpr std::size_t InitialCapacity = 16;
+
+    BlockPool *m_pool{nullptr};
+    T *m_buf{nullptr};
+    int m_capacity{0};
+    int m_mask{0};
+    int m_head{0};
+    int m_size{0};
+};
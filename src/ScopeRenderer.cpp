@@ -0,0 +1,471 @@
+// ScopeRenderer.cpp
+#include "ScopeRenderer.h"
+#include <QElapsedTimer>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QThread>
+#include <QtMath>
+
+namespace
+{
+    // 类型·尺寸的简短标签
+    QString typeSizeLabel(int type, int size)
+    {
+        QString t;
+        switch (type)
+        {
+        case 0:
+            t = QStringLiteral("未知");
+            break;
+        case 1:
+            t = QStringLiteral("旋翼");
+            break;
+        case 2:
+            t = QStringLiteral("固定翼");
+            break;
+        case 3:
+            t = QStringLiteral("直升机");
+            break;
+        case 4:
+            t = QStringLiteral("民航");
+            break;
+        case 5:
+            t = QStringLiteral("车辆");
+            break;
+        default:
+            t = QStringLiteral("?%1").arg(type);
+            break;
+        }
+        QString s;
+        switch (size)
+        {
+        case 0:
+            s = QStringLiteral("小");
+            break;
+        case 1:
+            s = QStringLiteral("中");
+            break;
+        case 2:
+            s = QStringLiteral("大");
+            break;
+        case 3:
+            s = QStringLiteral("特大");
+            break;
+        default:
+            s = QStringLiteral("?%1").arg(size);
+            break;
+        }
+        return t + QStringLiteral("·") + s;
+    }
+} // namespace
+
+QRectF ScopeFrame::circle() const
+{
+    const QPointF c = center();
+    const float R = radius();
+    return QRectF(c.x() - R, c.y() - R, 2 * R, 2 * R);
+}
+
+void ScopeRenderer::buildFrame(ScopeFrame &f)
+{
+    const QTransform &view = f.view;
+    const qint64 now = f.nowMs;
+
+    // 轨迹（根据点的时间做轻微衰减）：线段按透明度分桶，每桶一支画笔、一次 drawLines，
+    // 绘制调用数与桶数有关、与线段数无关；各桶的顶点数组跨帧复用
+    const int buckets = f.trailBuckets;
+    if (int(f.bucketLines.size()) != buckets)
+        f.bucketLines.resize(std::size_t(buckets));
+    for (QVector<QPointF> &lines : f.bucketLines)
+        lines.clear(); // 保留容量
+    f.heads.clear();
+    // 透明度 = clamp(30, 255·(1 - age/keep), 255)，按 [30,255] 等分成 buckets 档
+    const float invKeep = 1.0f / float(qMax<qint64>(1, f.trailKeepMs));
+    auto bucketOf = [&](qint64 age)
+    {
+        const float alpha = qBound(30.0f, 255.0f * (1.0f - float(age) * invKeep), 255.0f);
+        return qMin(buckets - 1, int((alpha - 30.0f) * float(buckets) / 225.0f));
+    };
+    const qint64 cutoff = now - f.trailKeepMs;
+    if (f.scene)
+    {
+        for (const ScopeScene::Track &t : f.scene->tracks())
+        {
+            // 跳过模型已按保留期裁掉、镜像里还留着的首端点（与模型的裁剪规则相同）
+            const RingBuffer<TrackModel::TrailPoint> &trail = t.trail;
+            int first = 0;
+            while (first + 1 < trail.size() && trail[first + 1].ms <= cutoff)
+                ++first;
+            if (trail.size() - first < 2)
+                continue;
+            // 首段跨过保留边界时从边界时刻处画起（模型在第二点也过期时才丢弃首点）
+            const TrackModel::TrailPoint &p0 = trail[first], &p1 = trail[first + 1];
+            QPointF start = p0.pos;
+            if (p0.ms < cutoff && p1.ms > p0.ms)
+                start += (p1.pos - p0.pos) * qBound(0.0, qreal(cutoff - p0.ms) / qreal(p1.ms - p0.ms), 1.0);
+            QPointF prev = view.map(start);
+            int bucket = 0;
+            for (int i = first + 1; i < trail.size(); ++i)
+            {
+                const QPointF cur = view.map(trail[i].pos);
+                bucket = bucketOf(now - trail[i].ms);
+                QVector<QPointF> &lines = f.bucketLines[std::size_t(bucket)];
+                lines.append(prev);
+                lines.append(cur);
+                prev = cur;
+            }
+            // 末端点按显示时刻的滤波预测位置画（两次雷达点之间平滑移动），与最新一段同桶连到最后一个点
+            const QPointF last = view.map(t.filter.predict(now, f.maxPredictMs));
+            QVector<QPointF> &lines = f.bucketLines[std::size_t(bucket)];
+            lines.append(prev);
+            lines.append(last);
+            // 根据威胁得分计算颜色（蓝->红）
+            const float score = t.score; // 0..1，由模型计算
+            QColor col;
+            // interpolate blue (0,128,255) -> red (255,50,50)
+            col.setRed(int(80 + 175 * score));
+            col.setGreen(int(180 - 130 * score));
+            col.setBlue(int(255 - 205 * score));
+            // 标签：类型·尺寸 以及威胁分 (0.00~1.00)
+            const QString label = typeSizeLabel(t.targetType, t.targetSize);
+            f.heads.append({last, col, label.isEmpty() ? label : label + QStringLiteral(" ") + QString::number(score, 'f', 2)});
+        }
+    }
+
+    // 余辉：末端点落在本帧扫过的楔形里的目标
+    f.blips.clear();
+    if (f.sweepOn && f.phosphorTo > f.phosphorFrom)
+    {
+        const QPointF c = f.center();
+        const float R = f.radius();
+        const float span = f.phosphorTo - f.phosphorFrom;
+        for (const ScopeFrame::Head &h : f.heads)
+        {
+            const QPointF d = h.pos - c;
+            if (d.x() * d.x() + d.y() * d.y() > qreal(R) * R)
+                continue;
+            float az = float(qRadiansToDegrees(qAtan2(d.x(), -d.y()))) - f.phosphorFrom;
+            while (az < 0.0f)
+                az += 360.0f;
+            if (az < span)
+                f.blips.append(h.pos);
+        }
+    }
+
+    // 高亮目标
+    const ScopeScene::Track *ht = f.scene && f.haloId != 0 ? f.scene->find(f.haloId) : nullptr;
+    f.halo = ht && !ht->trail.isEmpty();
+    if (f.halo)
+        f.haloPos = view.map(ht->filter.predict(now, f.maxPredictMs));
+
+    // 攻击：目标取本帧的预测位置
+    f.attacks.clear();
+    for (const ScopeFrame::AttackSource &a : f.attackSources)
+    {
+        const ScopeScene::Track *tt = f.scene && a.targetId != 0 ? f.scene->find(a.targetId) : nullptr;
+        QPointF targetPos;
+        if (tt && !tt->trail.isEmpty())
+            targetPos = view.map(tt->filter.predict(now, f.maxPredictMs));
+        f.attacks.append({a.type, view.map(a.pos), targetPos});
+    }
+}
+
+void ScopeRenderer::drawStaticLayer(QPainter &p, const QSizeF &size, float maxRange, const QColor &window)
+{
+    const QRectF rc(QPointF(0, 0), size);
+    const QPointF c = rc.center();
+    const float R = 0.48f * qMin(rc.width(), rc.height());
+    const QRectF circle(c.x() - R, c.y() - R, 2 * R, 2 * R);
+
+    p.fillRect(rc, window);
+    // 背景雷达扇面
+    p.setPen(QPen(QColor(40, 120, 40), 2));
+    p.setBrush(QColor(20, 60, 20));
+    p.drawEllipse(circle);
+
+    // 圈层与刻度
+    p.setPen(QPen(QColor(60, 180, 60), 1));
+    for (int i = 1; i <= 4; ++i)
+    {
+        p.drawEllipse(QRectF(c.x() - R * i / 4.0, c.y() - R * i / 4.0, 2 * R * i / 4.0, 2 * R * i / 4.0));
+    }
+    // 十字和方位刻度
+    p.drawLine(QPointF(c.x() - R, c.y()), QPointF(c.x() + R, c.y()));
+    p.drawLine(QPointF(c.x(), c.y() - R), QPointF(c.x(), c.y() + R));
+    p.setPen(QPen(QColor(120, 220, 120), 1));
+    for (int deg = 0; deg < 360; deg += 30)
+    {
+        const float theta = qDegreesToRadians(90.0f - float(deg));
+        QPointF o = QPointF(c.x() + (R - 10) * qCos(theta), c.y() - (R - 10) * qSin(theta));
+        QPointF i = QPointF(c.x() + R * qCos(theta), c.y() - R * qSin(theta));
+        p.drawLine(o, i);
+        QString label = QString::number(deg);
+        QPointF t = QPointF(c.x() + (R + 12) * qCos(theta), c.y() - (R + 12) * qSin(theta));
+        p.drawText(QRectF(t.x() - 12, t.y() - 8, 24, 16), Qt::AlignCenter, label);
+    }
+
+    // 量程标签
+    p.setPen(QColor(150, 240, 150));
+    for (int i = 1; i <= 4; ++i)
+    {
+        const float rr = R * i / 4.0f;
+        const float range = maxRange * (i / 4.0f);
+        p.drawText(QRectF(c.x() + rr - 24, c.y() - 12, 48, 16), Qt::AlignCenter, QString::number(int(range / 1000)) + " km");
+    }
+}
+
+void ScopeRenderer::stampPhosphor(PhosphorLayer &phosphor, const ScopeFrame &f)
+{
+    if (!f.sweepOn)
+        return;
+    phosphor.setDecayMs(f.phosphorDecayMs);
+    phosphor.setGeometry(f.circle(), f.dpr);
+    if (f.phosphorReset)
+        phosphor.clear();
+    phosphor.stamp(f.phosphorFrom, f.phosphorTo, f.blips, f.sweepSpeed);
+}
+
+void ScopeRenderer::drawDynamicLayer(QPainter &p, const ScopeFrame &f)
+{
+    p.setFont(f.font);
+    const QRectF circle = f.circle();
+
+    // 轨迹：每档一支画笔、一次 drawLines
+    const int buckets = int(f.bucketLines.size());
+    QPen trailPen(QColor(50, 150, 255), 2);
+    for (int b = 0; b < buckets; ++b)
+    {
+        const QVector<QPointF> &lines = f.bucketLines[std::size_t(b)];
+        if (lines.isEmpty())
+            continue;
+        trailPen.setColor(QColor(50, 150, 255, ScopeFrame::bucketAlpha(b, buckets)));
+        p.setPen(trailPen);
+        p.drawLines(lines.constData(), int(lines.size() / 2));
+    }
+
+    // 末端点与标签画在全部轨迹之上
+    for (const ScopeFrame::Head &h : f.heads)
+    {
+        p.setPen(Qt::NoPen);
+        p.setBrush(h.color);
+        p.drawEllipse(h.pos, 4, 4);
+        if (!h.label.isEmpty())
+        {
+            QFont font = p.font();
+            font.setPointSize(8);
+            p.setFont(font);
+            p.setPen(QColor(230, 230, 230));
+            p.drawText(QRectF(h.pos.x() + 8, h.pos.y() - 10, 120, 14), Qt::AlignLeft | Qt::AlignVCenter, h.label);
+        }
+    }
+
+    // 左上角提示（只显示关键信息）
+    int y = 8;
+    for (const ScopeFrame::Notice &n : f.notices)
+    {
+        QColor fg(230, 250, 230, int(255 * n.alpha));
+        QColor bg(0, 0, 0, int(120 * n.alpha));
+        p.setPen(Qt::NoPen);
+        p.setBrush(bg);
+        QFont font = p.font();
+        font.setBold(true);
+        p.setFont(font);
+        const QFontMetrics fm(p.font());
+        const int w = fm.horizontalAdvance(n.text) + 12;
+        const int h = fm.height() + 8;
+        QRect r(8, y, w, h);
+        p.drawRoundedRect(r, 6, 6);
+        p.setPen(fg);
+        p.drawText(r.adjusted(6, 4, -6, -4), Qt::AlignVCenter | Qt::AlignLeft, n.text);
+        y += h + 6;
+    }
+
+    // 扫描线（余辉已随底图贴上）
+    if (f.sweepOn)
+    {
+        const float R = circle.width() / 2.0f;
+        const QPointF c = circle.center();
+        // 主扫描线：从中心向外一条亮线
+        const float theta = qDegreesToRadians(90.0f - f.sweepAngle);
+        QPointF tip(c.x() + R * qCos(theta), c.y() - R * qSin(theta));
+        QPen pen(QColor(80, 220, 120), 2);
+        p.setPen(pen);
+        p.drawLine(c, tip);
+    }
+
+    // 高亮目标：末端外圈与更醒目标记
+    if (f.halo)
+    {
+        QPen haloPen(f.haloLocked ? QColor(220, 60, 60, 200) : QColor(255, 255, 0, 180)); // red when locked
+        haloPen.setWidth(2);
+        p.setPen(haloPen);
+        p.setBrush(Qt::NoBrush);
+        p.drawEllipse(f.haloPos, 8, 8);
+        QFont font = p.font();
+        font.setBold(true);
+        font.setPointSize(10);
+        p.setFont(font);
+        p.setPen(QColor(255, 255, 200));
+        p.drawText(QRectF(f.haloPos.x() + 10, f.haloPos.y() - 12, 160, 16), Qt::AlignLeft | Qt::AlignVCenter,
+                   QStringLiteral("锁定目标 #%1").arg(f.haloId));
+    }
+
+    // 攻击（激光/导弹）
+    for (const ScopeFrame::Attack &a : f.attacks)
+    {
+        if (a.type == 0)
+        {
+            // laser: draw red line from center to target
+            QPen pen(QColor(255, 40, 40, 220));
+            pen.setWidth(3);
+            p.setPen(pen);
+            p.drawLine(circle.center(), a.target);
+        }
+        else
+        {
+            // missile: draw moving circle with tail
+            QColor color = a.type == 1 ? QColor(120, 220, 120) : QColor(255, 200, 80);
+            p.setPen(Qt::NoPen);
+            p.setBrush(color);
+            p.drawEllipse(a.pos, 5, 5);
+            QPen tailPen(color.darker(), 2);
+            tailPen.setCapStyle(Qt::RoundCap);
+            p.setPen(tailPen);
+            p.drawLine(a.pos, a.target);
+        }
+    }
+}
+
+ScopeRenderThread::ScopeRenderThread(QObject *parent)
+    : QObject(parent)
+{
+    m_thread = QThread::create([this]()
+                               { renderLoop(); });
+    m_thread->setObjectName(QStringLiteral("radar-scope-render"));
+    m_thread->start();
+}
+
+ScopeRenderThread::~ScopeRenderThread()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_stop = true;
+    }
+    m_wake.wakeAll();
+    m_thread->wait();
+    delete m_thread;
+}
+
+bool ScopeRenderThread::submit(ScopeFrame *frame)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_busy)
+            return false;
+        m_pending = frame;
+        m_busy = true;
+    }
+    m_wake.wakeOne();
+    return true;
+}
+
+bool ScopeRenderThread::isBusy() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_busy;
+}
+
+bool ScopeRenderThread::drawLatest(QPainter &p, const QSize &logicalSize, const QColor &fill) const
+{
+    QMutexLocker lock(&m_mutex);
+    if (m_front < 0)
+        return false;
+    const QImage &img = m_buffers[m_front];
+    // 窗口尺寸刚变，新尺寸的帧还没画完：先铺底，旧帧照常贴上
+    if (img.deviceIndependentSize().toSize() != logicalSize)
+        p.fillRect(QRect(QPoint(0, 0), logicalSize), fill);
+    p.drawImage(QPointF(0, 0), img);
+    return true;
+}
+
+ScopeRenderStats ScopeRenderThread::stats() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_stats;
+}
+
+void ScopeRenderThread::renderLoop()
+{
+    QMutexLocker lock(&m_mutex);
+    while (!m_stop)
+    {
+        if (!m_pending)
+        {
+            m_wake.wait(&m_mutex);
+            continue;
+        }
+        ScopeFrame *frame = m_pending;
+        m_pending = nullptr;
+        // 画后台那块；前台那块 GUI 线程可能正在贴图
+        const int back = m_front == 0 ? 1 : 0;
+        QImage target = std::move(m_buffers[back]);
+        lock.unlock();
+
+        QElapsedTimer timer;
+        timer.start();
+        ScopeRenderer::buildFrame(*frame);
+        const qint64 buildNs = timer.nsecsElapsed();
+        render(*frame, &target);
+        const qint64 rasterNs = timer.nsecsElapsed() - buildNs;
+
+        lock.relock();
+        m_buffers[back] = std::move(target);
+        m_front = back;
+        m_busy = false;
+        ++m_stats.frames;
+        m_stats.build.add(buildNs);
+        m_stats.raster.add(rasterNs);
+        lock.unlock();
+        emit frameReady();
+        lock.relock();
+    }
+}
+
+void ScopeRenderThread::render(const ScopeFrame &f, QImage *target)
+{
+    const QSize px = f.size * f.dpr;
+    if (target->size() != px)
+        *target = QImage(px, QImage::Format_ARGB32_Premultiplied);
+    target->setDevicePixelRatio(f.dpr);
+
+    // 底图只在尺寸、像素比、量程、调色板或字体变化时重画
+    if (m_background.size() != px || m_background.devicePixelRatio() != f.dpr || m_bgRange != f.maxRange ||
+        m_bgWindow != f.window || m_bgFont != f.font)
+    {
+        m_background = QImage(px, QImage::Format_ARGB32_Premultiplied);
+        m_background.setDevicePixelRatio(f.dpr);
+        QPainter bp(&m_background);
+        bp.setRenderHint(QPainter::Antialiasing, true);
+        bp.setFont(f.font);
+        drawStaticLayer(bp, QSizeF(f.size), f.maxRange, f.window);
+        m_bgRange = f.maxRange;
+        m_bgWindow = f.window;
+        m_bgFont = f.font;
+    }
+
+    QPainter p(target);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    // 扫描时贴底图与余辉的合成（只重算本帧变过的区域），否则直接贴底图
+    if (f.sweepOn)
+    {
+        stampPhosphor(m_phosphor, f);
+        m_phosphor.drawComposited(p, m_background);
+    }
+    else
+    {
+        p.drawImage(QPointF(0, 0), m_background);
+    }
+    p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    drawDynamicLayer(p, f);
+}
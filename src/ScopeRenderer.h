@@ -0,0 +1,178 @@
+// ScopeRenderer.h
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <QTransform>
+#include <QVector>
+#include <QWaitCondition>
+#include <vector>
+#include "PhosphorLayer.h"
+#include "ScopeScene.h"
+
+class QPainter;
+class QThread;
+
+// 雷达盘一帧的绘制数据：
+// - 输入由 GUI 线程填写（航迹镜像、变换、时刻、提示、扫描、高亮、攻击），只是几十个字段的拷贝，与航迹数无关；
+// - ScopeRenderer::buildFrame 从输入生成输出（屏幕逻辑像素：投影、分档、预测、标签、余辉目标），
+//   后台绘制时在绘制线程执行，否则在 paintEvent 里；不引用模型，只读 scene 镜像。
+struct ScopeFrame
+{
+    struct AttackSource
+    {
+        int type;         // 0 激光 1 慢速导弹 2 快速导弹
+        QPointF pos;      // 东-北（米）
+        quint16 targetId; // 目标已消失（或批号已被复用）为 0
+    };
+    struct Head
+    {
+        QPointF pos;
+        QColor color;
+        QString label; // 空则不画
+    };
+    struct Notice
+    {
+        QString text;
+        float alpha; // 0..1
+    };
+    struct Attack
+    {
+        int type; // 0 激光 1 慢速导弹 2 快速导弹
+        QPointF pos;
+        QPointF target;
+    };
+
+    // 输入
+    QSize size;
+    qreal dpr{1.0};
+    QColor window;
+    QFont font;
+    float maxRange{};
+    const ScopeScene *scene{nullptr}; // 航迹镜像
+    QTransform view;                  // 东-北（米）-> 屏幕
+    qint64 nowMs{};                   // 显示时刻
+    qint64 trailKeepMs{};
+    qint64 maxPredictMs{};
+    int trailBuckets{8};
+    QVector<Notice> notices;
+    bool sweepOn{false};
+    float sweepAngle{};
+    float sweepSpeed{};               // deg/s
+    float phosphorFrom{};             // 自上一帧以来扫过的楔形 [from, to]，to 可超过360
+    float phosphorTo{};
+    qint64 phosphorDecayMs{1500};
+    bool phosphorReset{false};        // 余辉缓冲先清空（重新开始扫描）
+    quint16 haloId{};                 // 高亮的目标，0 为无
+    bool haloLocked{false};
+    QVector<AttackSource> attackSources;
+
+    // 输出（buildFrame）
+    std::vector<QVector<QPointF>> bucketLines; // 各透明度档的线段端点（成对），档数即 size()
+    QVector<Head> heads;
+    QVector<QPointF> blips;                    // 末端点落在余辉楔形里的目标
+    bool halo{false};                          // 高亮目标在镜像里：画外圈与标记
+    QPointF haloPos;
+    QVector<Attack> attacks;
+
+    QPointF center() const { return QRectF(QPointF(0, 0), QSizeF(size)).center(); }
+    float radius() const { return 0.48f * float(qMin(size.width(), size.height())); }
+    QRectF circle() const;
+    // 第 b 档（共 buckets 档）的透明度，取档内中间值
+    static int bucketAlpha(int b, int buckets) { return int(30.0f + (float(b) + 0.5f) * 225.0f / float(buckets)); }
+};
+
+namespace ScopeRenderer
+{
+    // 由帧的输入生成输出（投影、分档、预测、标签、余辉目标、高亮与攻击位置）；各档顶点数组跨帧复用
+    void buildFrame(ScopeFrame &f);
+    // 底图：背景、量程圈、十字、方位刻度与标签、量程标签（文字用 painter 当前字体）
+    void drawStaticLayer(QPainter &p, const QSizeF &size, float maxRange, const QColor &window);
+    // 余辉：扫描打开时把本帧扫过的楔形与其中的目标盖到缓冲上（缓冲由调用方持有、跨帧保留），否则不动；
+    // 缓冲随底图贴出（PhosphorLayer::drawComposited，没有缓存底图时 draw），在动态层之前
+    void stampPhosphor(PhosphorLayer &phosphor, const ScopeFrame &f);
+    // 动态层：轨迹、末端点与标签、提示、扫描线、高亮、攻击
+    void drawDynamicLayer(QPainter &p, const ScopeFrame &f);
+} // namespace ScopeRenderer
+
+// 一个绘制阶段的每帧耗时
+struct ScopeTiming
+{
+    quint64 count{};
+    qint64 lastNs{};
+    qint64 maxNs{};
+    double avgNs{}; // 指数滑动平均（约最近16帧）
+
+    void add(qint64 ns)
+    {
+        ++count;
+        lastNs = ns;
+        maxNs = qMax(maxNs, ns);
+        avgNs = count == 1 ? double(ns) : avgNs + (double(ns) - avgNs) / 16.0;
+    }
+};
+
+// 每帧绘制耗时，按阶段分开记：
+// - snapshot：GUI 线程同步航迹镜像、填写帧输入（后台绘制时即 tick 里的全部绘制开销）；
+// - build：ScopeRenderer::buildFrame；raster：底图与动态层光栅化；
+// 后台绘制时 build/raster 在绘制线程计，否则在 paintEvent 里计
+struct ScopeRenderStats
+{
+    quint64 frames{};
+    quint64 deferred{}; // 绘制线程忙、推迟到下一个 tick 的帧（由提交方统计）
+    ScopeTiming snapshot;
+    ScopeTiming build;
+    ScopeTiming raster;
+};
+
+// 后台绘制线程：对 ScopeFrame 执行 buildFrame，再光栅化到两块 QImage 中的后台一块，完成后与前台交换并发出 frameReady；
+// - 同时只处理一帧：submit 在上一帧未完成时返回 false，调用方保留脏标记下个 tick 再交；
+// - 提交的 ScopeFrame 在下一次 submit 成功前不得修改（调用方轮流使用两份），它引用的航迹镜像在本帧完成
+//   （isBusy 变为 false）前不得修改；stats 只含 frames/build/raster；
+// - 底图按尺寸/像素比/量程/调色板/字体缓存为 QImage（非 GUI 线程不能用 QPixmap）。
+class ScopeRenderThread : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ScopeRenderThread(QObject *parent = nullptr);
+    ~ScopeRenderThread() override;
+
+    bool submit(ScopeFrame *frame);
+    bool isBusy() const;
+    // 在 GUI 线程把最近完成的一帧画到 p（持锁，绘制线程此时只能画后台那块）；
+    // 帧的逻辑尺寸与 logicalSize 不同时先用 fill 铺底；还没有完成的帧返回 false
+    bool drawLatest(QPainter &p, const QSize &logicalSize, const QColor &fill) const;
+    ScopeRenderStats stats() const;
+
+signals:
+    // 在绘制线程发出，接收方按排队连接处理
+    void frameReady();
+
+private:
+    void renderLoop();
+    void render(const ScopeFrame &f, QImage *target);
+
+    QThread *m_thread{nullptr};
+    mutable QMutex m_mutex; // 保护以下全部
+    QWaitCondition m_wake;
+    ScopeFrame *m_pending{nullptr};
+    bool m_busy{false};
+    bool m_stop{false};
+    QImage m_buffers[2];
+    int m_front{-1}; // 最近完成的一块，-1 为尚无
+    ScopeRenderStats m_stats;
+
+    // 以下只在绘制线程访问
+    PhosphorLayer m_phosphor;
+    QImage m_background;
+    float m_bgRange{};
+    QColor m_bgWindow;
+    QFont m_bgFont;
+};
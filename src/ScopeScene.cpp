@@ -0,0 +1,98 @@
+// ScopeScene.cpp
+#include "ScopeScene.h"
+#include <limits>
+
+namespace
+{
+    void addOnce(DenseIdIndex &set, quint16 id)
+    {
+        if (!set.contains(id))
+            set.append(id);
+    }
+} // namespace
+
+void ScopeScene::markChanged(const TrackChangeSet &changes)
+{
+    if (m_resetAll)
+        return;
+    for (quint16 id : changes.removed)
+        addOnce(m_removed, id);
+    for (quint16 id : changes.added)
+        addOnce(m_dirty, id);
+    for (quint16 id : changes.updated)
+        addOnce(m_dirty, id);
+}
+
+int ScopeScene::sync(const TrackModel &model)
+{
+    int copied = 0;
+    if (m_resetAll)
+    {
+        m_resetAll = false;
+        m_tracks.clear();
+        m_removed.clear();
+        m_dirty.clear();
+        m_tracks.reserve(model.size());
+        for (const TrackModel::Track &t : model.tracks())
+        {
+            Track &d = m_tracks.insert(t.id);
+            d.id = t.id;
+            d.trail.setPool(&m_pool);
+            syncTrack(model, t, d);
+            ++copied;
+        }
+        return copied;
+    }
+
+    // 先删后建：删除后以同一批号重新出现的航迹整段重拷
+    for (quint16 id : m_removed.ids())
+        m_tracks.remove(id);
+    for (quint16 id : m_dirty.ids())
+    {
+        const TrackModel::Track *t = model.find(id);
+        if (!t)
+        {
+            m_tracks.remove(id);
+            continue;
+        }
+        bool created = false;
+        Track &d = m_tracks.insert(id, &created);
+        if (created)
+        {
+            d.id = id;
+            d.trail.setPool(&m_pool);
+        }
+        syncTrack(model, *t, d);
+        ++copied;
+    }
+    m_removed.clear();
+    m_dirty.clear();
+    return copied;
+}
+
+void ScopeScene::syncTrack(const TrackModel &model, const TrackModel::Track &src, Track &dst)
+{
+    dst.filter = model.filter().state(src.id);
+    dst.score = src.score;
+    dst.targetType = src.targetType;
+    dst.targetSize = src.targetSize;
+
+    // 末点可能已被抽稀替换，先去掉；剩下的点在模型里不会再变，按累计序号对齐
+    // （按值匹配不可靠：同一时刻同一位置的重复点会对错位置）
+    RingBuffer<TrackModel::TrailPoint> &s = dst.trail;
+    const RingBuffer<TrackModel::TrailPoint> &m = src.trail;
+    s.popBack();
+    const qint64 first = qint64(src.trailPushed) - m.size(); // 模型首点的序号
+    const qint64 end = qint64(dst.trailPushed) - 1;          // 镜像剩余各点之后的序号
+    if (end <= first || end - s.size() > first)
+        s.clear(); // 剩余的点已全被裁掉（或是新航迹）
+    // 模型首端裁掉的点（过期、超出点数上限或内存预算缩减）
+    while (!s.isEmpty() && end - s.size() < first)
+        s.popFront();
+    for (int i = s.isEmpty() ? 0 : int(end - first); i < m.size(); ++i)
+        s.push(m[i], std::numeric_limits<int>::max());
+    // 模型缩减了这条的缓冲（内存预算）：镜像也缩，容量不超过模型
+    if (s.capacity() > m.capacity())
+        s.shrinkTo(s.size());
+    dst.trailPushed = src.trailPushed;
+}
@@ -0,0 +1,55 @@
+// ScopeScene.h
+#pragma once
+
+#include <QtGlobal>
+#include "DenseIdIndex.h"
+#include "RingBuffer.h"
+#include "TrackFilter.h"
+#include "TrackModel.h"
+#include "TrackTable.h"
+
+// 雷达盘绘制用的航迹镜像（东-北坐标，米），投影、分档、预测都从这里读，不再访问模型：
+// - GUI 线程按模型发布的变化增量同步：markChanged 只记批号，sync 时只拷贝这些航迹的滤波状态与新增的轨迹点，
+//   每帧成本与变化的航迹数成正比，与航迹总数和轨迹长度无关；
+// - 模型的轨迹只会“首端裁掉若干点、末点被抽稀替换、末尾追加新点”，同步时按轨迹点的累计序号（trailPushed）
+//   对齐：镜像去掉末点与模型已裁掉的首端点，之后的重拷；镜像剩下的点已全被裁掉（新航迹）时整段重拷；
+// - 未变化航迹的首端可能还留着模型已按保留期裁掉的点，投影时按同样的规则跳过；
+// - 镜像的轨迹缓冲取自自己的块池 trailPool()，挂到模型上（TrackModel::setTrailMirrorPool）计入轨迹内存预算；
+//   同步后每条轨迹的容量不超过模型中对应的一条，模型缩减历史时镜像跟着缩；
+// - 镜像与绘制线程交替访问：sync 只在绘制线程空闲时调用（见 ScopeRenderThread::submit），绘制线程只在忙时读。
+class ScopeScene
+{
+public:
+    struct Track
+    {
+        quint16 id{};
+        RingBuffer<TrackModel::TrailPoint> trail;
+        quint32 trailPushed{}; // 同步时模型的 trailPushed
+        TrackFilter::State filter;
+        float score{};
+        quint8 targetType{};
+        quint8 targetSize{};
+    };
+    using Tracks = TrackTable<Track>;
+
+    // 记下模型发布的变化（GUI 线程，绘制线程忙时也可调用）
+    void markChanged(const TrackChangeSet &changes);
+    // 换了模型：下次 sync 整表重建
+    void markAll() { m_resetAll = true; }
+    // 把记下的变化同步到镜像（GUI 线程，绘制线程空闲时）；返回拷贝的航迹数
+    int sync(const TrackModel &model);
+
+    const Tracks &tracks() const { return m_tracks; }
+    const Track *find(quint16 id) const { return m_tracks.find(id); }
+    // 镜像轨迹缓冲的块池（只在 GUI 线程分配与释放）
+    BlockPool *trailPool() { return &m_pool; }
+
+private:
+    static void syncTrack(const TrackModel &model, const TrackModel::Track &src, Track &dst);
+
+    BlockPool m_pool; // 须先于 m_tracks 构造、后于其析构
+    Tracks m_tracks;
+    DenseIdIndex m_removed; // 待同步的删除（当作批号集合用）
+    DenseIdIndex m_dirty;   // 待同步的新增/更新
+    bool m_resetAll{true};
+};
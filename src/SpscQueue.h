@@ -0,0 +1,113 @@
+// SpscQueue.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// 有界无锁单生产者/单消费者环形队列：
+// - 仅允许一个线程调用 tryPush（生产者），一个线程调用 tryPop（消费者）；
+// - 队列满时 tryPush 直接返回 false，由调用方决定丢弃并计数，绝不阻塞；
+// - 容量向上取整为2的幂，下标用掩码回绕。
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity)
+    {
+        std::size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+        m_mask = cap - 1;
+        m_slots.reset(new T[cap]);
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // 生产者线程调用
+    bool tryPush(T &&value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache > m_mask)
+        {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache > m_mask)
+                return false; // 满
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用
+    bool tryPop(T &out)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return false; // 空
+        }
+        out = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T{}; // 尽早释放槽内持有的资源
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 交换式入队/出队：槽内元素与调用方的对象交换，不析构也不重置。
+    // 消费者交回的旧对象留在槽里，生产者下一轮写到这个槽时再换回去复用，
+    // 元素内部的容器容量因此在两端之间循环，稳定后不再分配内存。
+    // 生产者线程调用；满时返回 false，value 不变
+    bool tryPushSwap(T &value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache > m_mask)
+        {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache > m_mask)
+                return false; // 满
+        }
+        using std::swap;
+        swap(m_slots[tail & m_mask], value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用；空时返回 false，inout 不变
+    bool tryPopSwap(T &inout)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache)
+        {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+                return false; // 空
+        }
+        using std::swap;
+        swap(m_slots[head & m_mask], inout);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 当前深度（任意线程可调用，仅为近似值）
+    std::size_t size() const
+    {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    std::unique_ptr<T[]> m_slots;
+    std::size_t m_mask{0};
+
+    // 生产者与消费者各自的下标放在不同缓存行，避免伪共享
+    alignas(64) std::atomic<std::size_t> m_head{0}; // 消费者写
+    std::size_t m_tailCache{0};                     // 消费者本地缓存的 tail
+    alignas(64) std::atomic<std::size_t> m_tail{0}; // 生产者写
+    std::size_t m_headCache{0};                     // 生产者本地缓存的 head
+};
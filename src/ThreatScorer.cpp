@@ -0,0 +1,240 @@
+// ThreatScorer.cpp
+#include "ThreatScorer.h"
+#include <algorithm>
+#include <limits>
+
+// x86-64 上 SSE2 是基线指令集；AArch64 上 NEON 是基线
+#if defined(__x86_64__) || defined(_M_X64)
+#define RADAR_THREAT_SSE2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RADAR_THREAT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    struct Params
+    {
+        float wd, ws, wt, wi;
+        float invRange, invSpeed;
+    };
+
+    // 类型风险因子：未知=1, 旋翼=0.3, 固定翼=0.3, 直升机=0.6, 民航=0.7, 车=0.6
+    float typeFactor(quint8 type)
+    {
+        switch (type)
+        {
+        case 1:
+        case 2:
+            return 0.3f;
+        case 3:
+        case 5:
+            return 0.6f;
+        case 4:
+            return 0.7f;
+        default:
+            return 1.0f;
+        }
+    }
+
+    inline float clamp01(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+
+    // score = wd·(1 - clamp(d/range)) + ws·clamp(v/vmax) + wt·tn + wi·idn，再钳到 0..1
+    inline float scoreOne(float d, float s, float tn, float idn, const Params &p)
+    {
+        const float dnorm = 1.0f - clamp01(d * p.invRange);
+        const float snorm = clamp01(s * p.invSpeed);
+        return clamp01(p.wd * dnorm + p.ws * snorm + p.wt * tn + p.wi * idn);
+    }
+
+    void scoreRows(const float *d, const float *s, const float *tn, const float *idn, float *out, int n, const Params &p)
+    {
+        int i = 0;
+#if defined(RADAR_THREAT_SSE2)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 wd = _mm_set1_ps(p.wd), ws = _mm_set1_ps(p.ws), wt = _mm_set1_ps(p.wt), wi = _mm_set1_ps(p.wi);
+        const __m128 invR = _mm_set1_ps(p.invRange), invS = _mm_set1_ps(p.invSpeed);
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 dn = _mm_sub_ps(one, _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(d + i), invR), zero), one));
+            const __m128 sn = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(s + i), invS), zero), one);
+            __m128 acc = _mm_mul_ps(wd, dn);
+            acc = _mm_add_ps(acc, _mm_mul_ps(ws, sn));
+            acc = _mm_add_ps(acc, _mm_mul_ps(wt, _mm_loadu_ps(tn + i)));
+            acc = _mm_add_ps(acc, _mm_mul_ps(wi, _mm_loadu_ps(idn + i)));
+            _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(acc, zero), one));
+        }
+#elif defined(RADAR_THREAT_NEON)
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t invR = vdupq_n_f32(p.invRange), invS = vdupq_n_f32(p.invSpeed);
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t dn = vsubq_f32(one, vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(d + i), invR), zero), one));
+            const float32x4_t sn = vminq_f32(vmaxq_f32(vmulq_f32(vld1q_f32(s + i), invS), zero), one);
+            float32x4_t acc = vmulq_n_f32(dn, p.wd);
+            acc = vmlaq_n_f32(acc, sn, p.ws);
+            acc = vmlaq_n_f32(acc, vld1q_f32(tn + i), p.wt);
+            acc = vmlaq_n_f32(acc, vld1q_f32(idn + i), p.wi);
+            vst1q_f32(out + i, vminq_f32(vmaxq_f32(acc, zero), one));
+        }
+#endif
+        for (; i < n; ++i)
+            out[i] = scoreOne(d[i], s[i], tn[i], idn[i], p);
+    }
+} // namespace
+
+const char *ThreatScorer::kernelName()
+{
+#if defined(RADAR_THREAT_SSE2)
+    return "sse2";
+#elif defined(RADAR_THREAT_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void ThreatScorer::setWeights(const ThreatWeights &w)
+{
+    m_weights = w;
+    m_allDirty = true;
+}
+
+void ThreatScorer::setMaxRange(float meters)
+{
+    meters = qMax(1.0f, meters);
+    if (meters == m_maxRange)
+        return;
+    m_maxRange = meters;
+    m_allDirty = true;
+}
+
+void ThreatScorer::setMaxSpeed(float mps)
+{
+    mps = qMax(1.0f, mps);
+    if (mps == m_maxSpeed)
+        return;
+    m_maxSpeed = mps;
+    m_allDirty = true;
+}
+
+void ThreatScorer::set(quint16 id, float distance, float speed, quint8 targetType)
+{
+    const float tn = 1.0f - clamp01(typeFactor(targetType));
+    const float idn = targetType != 0 ? 0.0f : 1.0f;
+    qint32 pos = m_index.rowOf(id);
+    if (pos < 0)
+    {
+        pos = m_index.append(id);
+        m_distance.push_back(distance);
+        m_speed.push_back(speed);
+        m_typeNorm.push_back(tn);
+        m_idNorm.push_back(idn);
+        m_score.push_back(std::numeric_limits<float>::quiet_NaN()); // 首次必定报告变化
+        m_tier.push_back(0);
+        m_isDirty.push_back(0);
+    }
+    else
+    {
+        const std::size_t p = std::size_t(pos);
+        if (m_distance[p] == distance && m_speed[p] == speed && m_typeNorm[p] == tn && m_idNorm[p] == idn)
+            return;
+        m_distance[p] = distance;
+        m_speed[p] = speed;
+        m_typeNorm[p] = tn;
+        m_idNorm[p] = idn;
+    }
+    if (!m_isDirty[std::size_t(pos)])
+    {
+        m_isDirty[std::size_t(pos)] = 1;
+        m_dirty.push_back(pos);
+    }
+}
+
+void ThreatScorer::remove(quint16 id)
+{
+    const int pos = m_index.rowOf(id);
+    if (pos < 0)
+        return;
+    const std::size_t p = std::size_t(pos);
+    const std::size_t last = std::size_t(size()) - 1;
+    // 末行移到空位；它若待算而空位原本不在待算表中，补登记新行号
+    const bool movedDirty = p != last && m_isDirty[last] && !m_isDirty[p];
+    m_index.removeRow(pos);
+    DenseIdIndex::eraseRow(pos, m_distance, m_speed, m_typeNorm, m_idNorm, m_score, m_tier, m_isDirty);
+    if (movedDirty)
+        m_dirty.push_back(pos);
+}
+
+void ThreatScorer::clear()
+{
+    m_index.clear();
+    m_distance.clear();
+    m_speed.clear();
+    m_typeNorm.clear();
+    m_idNorm.clear();
+    m_score.clear();
+    m_tier.clear();
+    m_isDirty.clear();
+    m_dirty.clear();
+}
+
+int ThreatScorer::rescore(QVector<quint16> *changed)
+{
+    const Params p{m_weights.distance, m_weights.speed, m_weights.type, m_weights.identity,
+                   1.0f / m_maxRange, 1.0f / m_maxSpeed};
+    const int n = size();
+    int computed = 0;
+    // 待算行较多时整表向量化重算比逐行更快
+    if (m_allDirty || int(m_dirty.size()) * 4 > n)
+    {
+        m_scratch.resize(std::size_t(n));
+        scoreRows(m_distance.data(), m_speed.data(), m_typeNorm.data(), m_idNorm.data(), m_scratch.data(), n, p);
+        for (int i = 0; i < n; ++i)
+        {
+            const std::size_t k = std::size_t(i);
+            // NaN（新行）与任何值都不相等，必定报告
+            if (m_scratch[k] != m_score[k] && changed)
+                changed->append(m_index.idAt(int(k)));
+            m_tier[k] = tierOf(m_scratch[k]);
+            m_isDirty[k] = 0;
+        }
+        m_score.swap(m_scratch);
+        computed = n;
+    }
+    else
+    {
+        for (qint32 pos : m_dirty)
+        {
+            const std::size_t k = std::size_t(pos);
+            // 已删除或被末行覆盖的旧登记
+            if (pos >= n || !m_isDirty[k])
+                continue;
+            m_isDirty[k] = 0;
+            const float s = scoreOne(m_distance[k], m_speed[k], m_typeNorm[k], m_idNorm[k], p);
+            if (s != m_score[k] && changed)
+                changed->append(m_index.idAt(int(k)));
+            m_score[k] = s;
+            m_tier[k] = tierOf(s);
+            ++computed;
+        }
+    }
+    m_dirty.clear();
+    m_allDirty = false;
+    return computed;
+}
+
+float ThreatScorer::score(quint16 id) const
+{
+    const int pos = m_index.rowOf(id);
+    return pos < 0 ? 0.0f : m_score[std::size_t(pos)];
+}
+
+quint8 ThreatScorer::tier(quint16 id) const
+{
+    const int pos = m_index.rowOf(id);
+    return pos < 0 ? 0 : m_tier[std::size_t(pos)];
+}
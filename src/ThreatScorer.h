@@ -0,0 +1,73 @@
+// ThreatScorer.h
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+#include "DenseIdIndex.h"
+
+// 威胁分权重（和为1时分数落在 0..1）
+struct ThreatWeights
+{
+    float distance = 0.3f; // 越近越危险
+    float speed = 0.3f;    // 越快越危险
+    float type = 0.2f;     // 类型风险（未知最高）
+    float identity = 0.2f; // 身份未知
+};
+
+// 批量威胁评分：每条航迹一行，各输入一列（SoA），按列整批计算。
+// - 输入（距离/速度/类型）未变的行不重算；改权重、量程、速度上限时整表重算；
+// - 整表重算用 SSE2（x86-64）/ NEON（AArch64）一次算4行，否则走标量；
+// - 同时给出三级分组：0 = [0, 0.3)，1 = [0.3, 0.7)，2 = [0.7, 1]，界面只读结果不自己算。
+// 以批号为键（DenseIdIndex），行稠密存放，删除时末行填补。
+class ThreatScorer
+{
+public:
+    static constexpr float Tier1Min = 0.3f; // 二级下限
+    static constexpr float Tier2Min = 0.7f; // 三级下限
+    static quint8 tierOf(float score) { return quint8(score >= Tier1Min) + quint8(score >= Tier2Min); }
+
+    void setWeights(const ThreatWeights &w);
+    const ThreatWeights &weights() const { return m_weights; }
+    void setMaxRange(float meters);
+    float maxRange() const { return m_maxRange; }
+    void setMaxSpeed(float mps);
+    float maxSpeed() const { return m_maxSpeed; }
+
+    // 新增/更新一行的输入；与现值相同则不标记重算
+    void set(quint16 id, float distance, float speed, quint8 targetType);
+    void remove(quint16 id);
+    void clear();
+    int size() const { return m_index.size(); }
+
+    // 重算所有待算行，返回重算行数；分数发生变化的批号追加到 changed
+    int rescore(QVector<quint16> *changed = nullptr);
+    bool hasPending() const { return m_allDirty || !m_dirty.empty(); }
+
+    // 最近一次 rescore 的结果；未知批号返回 0
+    float score(quint16 id) const;
+    quint8 tier(quint16 id) const;
+
+    // 当前整表内核（"sse2"/"neon"/"scalar"）
+    static const char *kernelName();
+
+private:
+    ThreatWeights m_weights;
+    float m_maxRange = 5000.0f;
+    float m_maxSpeed = 100.0f; // m/s，用于速度归一化
+
+    DenseIdIndex m_index; // 批号 <-> 行
+    // 输入列
+    std::vector<float> m_distance;
+    std::vector<float> m_speed;
+    std::vector<float> m_typeNorm; // 1 - 类型风险因子
+    std::vector<float> m_idNorm;   // 身份未知 = 1
+    // 输出列
+    std::vector<float> m_score;
+    std::vector<quint8> m_tier;
+    std::vector<float> m_scratch; // 整表重算的新分数
+
+    std::vector<qint32> m_dirty; // 待算行号
+    std::vector<quint8> m_isDirty;
+    bool m_allDirty = false;
+};
@@ -0,0 +1,150 @@
+// TimerWheel.cpp
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr std::size_t IndexSize = 65536;
+} // namespace
+
+TimerWheel::TimerWheel(qint64 tickMs)
+    : m_tickMs(qMax<qint64>(1, tickMs)),
+      m_next(new qint32[IndexSize]),
+      m_prev(new qint32[IndexSize]),
+      m_slotOf(new qint16[IndexSize]),
+      m_deadline(new qint64[IndexSize]())
+{
+    std::fill(m_head, m_head + Levels * SlotsPerLevel, -1);
+    std::fill(m_slotOf.get(), m_slotOf.get() + IndexSize, qint16(-1));
+}
+
+void TimerWheel::link(quint16 id, int slot)
+{
+    const qint32 head = m_head[slot];
+    m_prev[id] = -1;
+    m_next[id] = head;
+    if (head >= 0)
+        m_prev[head] = id;
+    m_head[slot] = id;
+    m_slotOf[id] = qint16(slot);
+}
+
+void TimerWheel::unlink(quint16 id)
+{
+    const int slot = m_slotOf[id];
+    const qint32 prev = m_prev[id], next = m_next[id];
+    if (prev >= 0)
+        m_next[prev] = next;
+    else
+        m_head[slot] = next;
+    if (next >= 0)
+        m_prev[next] = prev;
+    m_slotOf[id] = -1;
+}
+
+void TimerWheel::place(quint16 id, qint64 minTick)
+{
+    // 按距当前 tick 的远近选层；早于 minTick 的放到 minTick
+    const qint64 due = qMax(tickOf(m_deadline[id]), minTick);
+    const qint64 delta = due - m_now;
+    int level = 0;
+    qint64 span = SlotsPerLevel;
+    while (level < Levels - 1 && delta >= span)
+    {
+        ++level;
+        span <<= LevelBits;
+    }
+    // 超出最高层范围：放在最高层最远的槽，到时降层再判断
+    const qint64 slotTick = delta < span ? due : m_now + span - 1;
+    const int slot = int((slotTick >> (LevelBits * level)) & (SlotsPerLevel - 1));
+    link(id, level * SlotsPerLevel + slot);
+}
+
+void TimerWheel::schedule(quint16 id, qint64 deadlineMs)
+{
+    if (m_slotOf[id] >= 0)
+        unlink(id);
+    else
+        ++m_size;
+    if (m_now < 0)
+        m_now = tickOf(deadlineMs) - 1;
+    m_deadline[id] = deadlineMs;
+    place(id, m_now + 1);
+}
+
+void TimerWheel::cancel(quint16 id)
+{
+    if (m_slotOf[id] < 0)
+        return;
+    unlink(id);
+    --m_size;
+}
+
+void TimerWheel::clear()
+{
+    for (int s = 0; s < Levels * SlotsPerLevel; ++s)
+    {
+        for (qint32 id = m_head[s]; id >= 0; id = m_next[id])
+            m_slotOf[id] = -1;
+        m_head[s] = -1;
+    }
+    m_size = 0;
+}
+
+int TimerWheel::advance(qint64 nowMs, QVector<quint16> *out)
+{
+    const qint64 target = tickOf(nowMs);
+    if (m_size == 0 || m_now < 0)
+    {
+        m_now = qMax(m_now, target);
+        return 0;
+    }
+    int fired = 0;
+    while (m_now < target)
+    {
+        ++m_now;
+        // 低层转满一圈时，把上一层对应槽的定时降层（从高到低）
+        for (int level = Levels - 1; level > 0; --level)
+        {
+            const qint64 lowMask = (qint64(1) << (LevelBits * level)) - 1;
+            if ((m_now & lowMask) != 0)
+                continue;
+            const int slot = level * SlotsPerLevel + int((m_now >> (LevelBits * level)) & (SlotsPerLevel - 1));
+            qint32 id = m_head[slot];
+            m_head[slot] = -1;
+            while (id >= 0)
+            {
+                const qint32 next = m_next[id];
+                m_slotOf[id] = -1;
+                place(quint16(id), m_now); // 本 tick 到期的落在下面马上处理的第0层槽
+                id = next;
+            }
+        }
+        const int slot = int(m_now & (SlotsPerLevel - 1));
+        qint32 id = m_head[slot];
+        m_head[slot] = -1;
+        while (id >= 0)
+        {
+            const qint32 next = m_next[id];
+            m_slotOf[id] = -1;
+            if (m_deadline[id] <= nowMs)
+            {
+                --m_size;
+                out->append(quint16(id));
+                ++fired;
+            }
+            else
+            {
+                // 超出范围被放在最远槽的，或与 nowMs 同一 tick 但尚未到时的，重新放置
+                place(quint16(id), m_now + 1);
+            }
+            id = next;
+        }
+        if (m_size == 0)
+        {
+            m_now = target;
+            break;
+        }
+    }
+    return fired;
+}
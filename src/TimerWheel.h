@@ -0,0 +1,49 @@
+// TimerWheel.h
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+#include <memory>
+
+// 分层时间轮（以批号为键，每个批号至多一个定时）：
+// - 3 层 × 64 槽，第0层每槽一个 tick，逐层 ×64；tick 默认 100ms，第2层可覆盖约7小时，更远的放最远槽、到时再放回；
+// - schedule/cancel 为 O(1)（按批号直接索引的双向链表）；advance 只访问经过的槽，
+//   总耗时为 O(经过的 tick 数 + 到期数 + 降层搬移数)，不扫描全部定时；
+// - 时间只由 advance 推进：首次 schedule 前（及时间轮为空时）先 advance 到当前时刻；空轮 advance 直接跳过去。
+class TimerWheel
+{
+public:
+    explicit TimerWheel(qint64 tickMs = 100);
+
+    qint64 tickMs() const { return m_tickMs; }
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    // 设置/改期（已有定时则替换）；已过的截止时刻在下一个 tick 到期
+    void schedule(quint16 id, qint64 deadlineMs);
+    void cancel(quint16 id);
+    bool isScheduled(quint16 id) const { return m_slotOf[id] >= 0; }
+    qint64 deadline(quint16 id) const { return m_deadline[id]; }
+    void clear();
+
+    // 推进到 nowMs：到期（deadline <= nowMs）的批号追加到 out 并移出时间轮，返回到期数
+    int advance(qint64 nowMs, QVector<quint16> *out);
+
+private:
+    static constexpr int LevelBits = 6;
+    static constexpr int SlotsPerLevel = 1 << LevelBits;
+    static constexpr int Levels = 3;
+
+    qint64 tickOf(qint64 ms) const { return ms / m_tickMs; }
+    void place(quint16 id, qint64 minTick);
+    void link(quint16 id, int slot);
+    void unlink(quint16 id);
+
+    qint64 m_tickMs;
+    qint64 m_now{-1}; // 已处理到的 tick，-1 为尚未开始
+    int m_size{0};
+    qint32 m_head[Levels * SlotsPerLevel];
+    std::unique_ptr<qint32[]> m_next, m_prev;
+    std::unique_ptr<qint16[]> m_slotOf; // -1 为未定时
+    std::unique_ptr<qint64[]> m_deadline;
+};
@@ -0,0 +1,311 @@
+// TrackBatch.cpp
+#include "TrackBatch.h"
+
+namespace
+{
+    // 逐行掩码：返回0/1而不是bool，整列循环里用按位与合并，不产生分支
+    template <typename T>
+    inline quint8 inRangeMask(T v, T lo, T hi)
+    {
+        return quint8(v >= lo) & quint8(v <= hi);
+    }
+
+    // 按掩码原地压缩一列，保持顺序
+    template <typename T>
+    void compact(QVector<T> &col, const quint8 *keep, int n)
+    {
+        T *p = col.data();
+        int w = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            p[w] = p[i];
+            w += keep[i];
+        }
+        col.resize(w);
+    }
+} // namespace
+
+void TrackBatch::clear()
+{
+    trackId.clear();
+    tgtLon.clear();
+    tgtLat.clear();
+    tgtAlt.clear();
+    distance.clear();
+    azimuth.clear();
+    elevation.clear();
+    speed.clear();
+    course.clear();
+    strength.clear();
+    targetType.clear();
+    targetSize.clear();
+    pointType.clear();
+    trackType.clear();
+    lostCount.clear();
+    quality.clear();
+    rawDistance.clear();
+    rawAzimuth.clear();
+    rawElevation.clear();
+}
+
+void TrackBatch::reserve(int n)
+{
+    trackId.reserve(n);
+    tgtLon.reserve(n);
+    tgtLat.reserve(n);
+    tgtAlt.reserve(n);
+    distance.reserve(n);
+    azimuth.reserve(n);
+    elevation.reserve(n);
+    speed.reserve(n);
+    course.reserve(n);
+    strength.reserve(n);
+    targetType.reserve(n);
+    targetSize.reserve(n);
+    pointType.reserve(n);
+    trackType.reserve(n);
+    lostCount.reserve(n);
+    quality.reserve(n);
+    rawDistance.reserve(n);
+    rawAzimuth.reserve(n);
+    rawElevation.reserve(n);
+}
+
+void TrackBatch::resize(int n)
+{
+    trackId.resize(n);
+    tgtLon.resize(n);
+    tgtLat.resize(n);
+    tgtAlt.resize(n);
+    distance.resize(n);
+    azimuth.resize(n);
+    elevation.resize(n);
+    speed.resize(n);
+    course.resize(n);
+    strength.resize(n);
+    targetType.resize(n);
+    targetSize.resize(n);
+    pointType.resize(n);
+    trackType.resize(n);
+    lostCount.resize(n);
+    quality.resize(n);
+    rawDistance.resize(n);
+    rawAzimuth.resize(n);
+    rawElevation.resize(n);
+}
+
+void TrackBatch::append(const TrackInfo &info)
+{
+    trackId.append(info.trackId);
+    tgtLon.append(info.tgtLon);
+    tgtLat.append(info.tgtLat);
+    tgtAlt.append(info.tgtAlt);
+    distance.append(info.distance);
+    azimuth.append(info.azimuth);
+    elevation.append(info.elevation);
+    speed.append(info.speed);
+    course.append(info.course);
+    strength.append(info.strength);
+    targetType.append(info.targetType);
+    targetSize.append(info.targetSize);
+    pointType.append(info.pointType);
+    trackType.append(info.trackType);
+    lostCount.append(info.lostCount);
+    quality.append(info.quality);
+    rawDistance.append(info.rawDistance);
+    rawAzimuth.append(info.rawAzimuth);
+    rawElevation.append(info.rawElevation);
+}
+
+void TrackBatch::append(const TrackInfoView &r)
+{
+    trackId.append(r.trackId());
+    tgtLon.append(r.tgtLon());
+    tgtLat.append(r.tgtLat());
+    tgtAlt.append(r.tgtAlt());
+    distance.append(r.distance());
+    azimuth.append(r.azimuth());
+    elevation.append(r.elevation());
+    speed.append(r.speed());
+    course.append(r.course());
+    strength.append(r.strength());
+    targetType.append(r.targetType());
+    targetSize.append(r.targetSize());
+    pointType.append(r.pointType());
+    trackType.append(r.trackType());
+    lostCount.append(r.lostCount());
+    quality.append(r.quality());
+    rawDistance.append(r.rawDistance());
+    rawAzimuth.append(r.rawAzimuth());
+    rawElevation.append(r.rawElevation());
+}
+
+void TrackBatch::append(const TrackBatch &o)
+{
+    trackId.append(o.trackId);
+    tgtLon.append(o.tgtLon);
+    tgtLat.append(o.tgtLat);
+    tgtAlt.append(o.tgtAlt);
+    distance.append(o.distance);
+    azimuth.append(o.azimuth);
+    elevation.append(o.elevation);
+    speed.append(o.speed);
+    course.append(o.course);
+    strength.append(o.strength);
+    targetType.append(o.targetType);
+    targetSize.append(o.targetSize);
+    pointType.append(o.pointType);
+    trackType.append(o.trackType);
+    lostCount.append(o.lostCount);
+    quality.append(o.quality);
+    rawDistance.append(o.rawDistance);
+    rawAzimuth.append(o.rawAzimuth);
+    rawElevation.append(o.rawElevation);
+}
+
+TrackInfo TrackBatch::row(int i) const
+{
+    TrackInfo ti;
+    ti.trackId = trackId[i];
+    ti.tgtLon = tgtLon[i];
+    ti.tgtLat = tgtLat[i];
+    ti.tgtAlt = tgtAlt[i];
+    ti.distance = distance[i];
+    ti.azimuth = azimuth[i];
+    ti.elevation = elevation[i];
+    ti.speed = speed[i];
+    ti.course = course[i];
+    ti.strength = strength[i];
+    ti.targetType = targetType[i];
+    ti.targetSize = targetSize[i];
+    ti.pointType = pointType[i];
+    ti.trackType = trackType[i];
+    ti.lostCount = lostCount[i];
+    ti.quality = quality[i];
+    ti.rawDistance = rawDistance[i];
+    ti.rawAzimuth = rawAzimuth[i];
+    ti.rawElevation = rawElevation[i];
+    return ti;
+}
+
+int TrackBatch::removeInvalid()
+{
+    const int n = size();
+    if (n == 0)
+        return 0;
+    m_mask.resize(n);
+    quint8 *ok = m_mask.data();
+
+    // 每个循环只读连续的列，比较结果按位与进掩码；NaN 比较为假，与逐条校验一致
+    const double *lon = tgtLon.constData();
+    const double *lat = tgtLat.constData();
+    for (int i = 0; i < n; ++i)
+        ok[i] = inRangeMask(lon[i], -180.0, 180.0) & inRangeMask(lat[i], -90.0, 90.0);
+
+    const float *az = azimuth.constData();
+    const float *el = elevation.constData();
+    const float *crs = course.constData();
+    for (int i = 0; i < n; ++i)
+        ok[i] &= inRangeMask(az[i], 0.0f, 360.0f) & inRangeMask(el[i], -90.0f, 90.0f) & inRangeMask(crs[i], 0.0f, 360.0f);
+
+    const float *raz = rawAzimuth.constData();
+    const float *rel = rawElevation.constData();
+    for (int i = 0; i < n; ++i)
+        ok[i] &= inRangeMask(raz[i], 0.0f, 360.0f) & inRangeMask(rel[i], -90.0f, 90.0f);
+
+    // 距离只拒绝负值（NaN 放行，与原解析器一致）
+    const float *dist = distance.constData();
+    const float *rdist = rawDistance.constData();
+    const quint8 *q = quality.constData();
+    for (int i = 0; i < n; ++i)
+        ok[i] &= quint8(!(dist[i] < 0.0f)) & quint8(!(rdist[i] < 0.0f)) & quint8(q[i] <= 100);
+
+    int kept = 0;
+    for (int i = 0; i < n; ++i)
+        kept += ok[i];
+    if (kept == n)
+        return 0;
+
+    compact(trackId, ok, n);
+    compact(tgtLon, ok, n);
+    compact(tgtLat, ok, n);
+    compact(tgtAlt, ok, n);
+    compact(distance, ok, n);
+    compact(azimuth, ok, n);
+    compact(elevation, ok, n);
+    compact(speed, ok, n);
+    compact(course, ok, n);
+    compact(strength, ok, n);
+    compact(targetType, ok, n);
+    compact(targetSize, ok, n);
+    compact(pointType, ok, n);
+    compact(trackType, ok, n);
+    compact(lostCount, ok, n);
+    compact(quality, ok, n);
+    compact(rawDistance, ok, n);
+    compact(rawAzimuth, ok, n);
+    compact(rawElevation, ok, n);
+    return n - kept;
+}
+
+bool TrackBatchView::fromBytes(const uchar *data, int size, TrackBatchView &out)
+{
+    if (!data || size < MinSize)
+        return false;
+    const int count = qFromLittleEndian<quint16>(data + CountOffset);
+    if (size < frameSize(count))
+        return false;
+    out = TrackBatchView(data, size);
+    return true;
+}
+
+bool TrackBatchView::fromBytes(const QByteArray &payload, TrackBatchView &out)
+{
+    return fromBytes(reinterpret_cast<const uchar *>(payload.constData()), int(payload.size()), out);
+}
+
+bool TrackBatchView::isValid() const
+{
+    const double lon = radarLon();
+    const double lat = radarLat();
+    return lon >= -180.0 && lon <= 180.0 && lat >= -90.0 && lat <= 90.0;
+}
+
+void TrackBatchView::appendTo(TrackBatch &out) const
+{
+    const Protocol::FrameHeader h = header();
+    out.utcMs = h.utcMs;
+    out.insValid = insValid();
+    out.radarLon = radarLon();
+    out.radarLat = radarLat();
+    out.radarAlt = radarAlt();
+
+    const int n = count();
+    const int base = out.size();
+    out.resize(base + n);
+    // 按记录顺序读一遍接收缓冲，逐列写入
+    for (int i = 0; i < n; ++i)
+    {
+        const TrackInfoView r = record(i);
+        const int k = base + i;
+        out.trackId[k] = r.trackId();
+        out.tgtLon[k] = r.tgtLon();
+        out.tgtLat[k] = r.tgtLat();
+        out.tgtAlt[k] = r.tgtAlt();
+        out.distance[k] = r.distance();
+        out.azimuth[k] = r.azimuth();
+        out.elevation[k] = r.elevation();
+        out.speed[k] = r.speed();
+        out.course[k] = r.course();
+        out.strength[k] = r.strength();
+        out.targetType[k] = r.targetType();
+        out.targetSize[k] = r.targetSize();
+        out.pointType[k] = r.pointType();
+        out.trackType[k] = r.trackType();
+        out.lostCount[k] = r.lostCount();
+        out.quality[k] = r.quality();
+        out.rawDistance[k] = r.rawDistance();
+        out.rawAzimuth[k] = r.rawAzimuth();
+        out.rawElevation[k] = r.rawElevation();
+    }
+}
@@ -0,0 +1,95 @@
+// TrackBatch.h
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+#include "TrackMessage.h"
+
+// 一批航迹的列式（SoA）存储：每个字段一列，第 i 行即第 i 条航迹。
+// - 由批量航迹报文（0x3003）整帧解码得到，也可逐条追加单航迹报文；
+// - 范围校验 removeInvalid() 按列整批计算，循环无分支，便于编译器向量化；
+// - 显示器与目标列表按批更新，每批只触发一次重绘/排序。
+struct TrackBatch
+{
+    // 批内公共信息（多帧合并时取最后一帧）
+    quint64 utcMs{};   // 帧头UTC毫秒
+    bool insValid{};   // 惯导有效标志
+    double radarLon{}; // 雷达经度
+    double radarLat{}; // 雷达纬度
+    float radarAlt{};  // 雷达海拔
+
+    QVector<quint16> trackId;
+    QVector<double> tgtLon;
+    QVector<double> tgtLat;
+    QVector<float> tgtAlt;
+    QVector<float> distance;
+    QVector<float> azimuth;
+    QVector<float> elevation;
+    QVector<float> speed;
+    QVector<float> course;
+    QVector<float> strength;
+    QVector<quint8> targetType;
+    QVector<quint8> targetSize;
+    QVector<quint8> pointType;
+    QVector<quint8> trackType;
+    QVector<quint8> lostCount;
+    QVector<quint8> quality;
+    QVector<float> rawDistance;
+    QVector<float> rawAzimuth;
+    QVector<float> rawElevation;
+
+    int size() const { return int(trackId.size()); }
+    bool isEmpty() const { return trackId.isEmpty(); }
+    // 清空行，保留各列容量（GUI线程每轮复用同一个批）
+    void clear();
+    void reserve(int n);
+    void resize(int n);
+
+    void append(const TrackInfo &info);
+    void append(const TrackInfoView &record);
+    // 按列追加另一批的全部行（公共信息不变）
+    void append(const TrackBatch &other);
+    // 取第 i 行为拥有型结构体（预留字段为0）
+    TrackInfo row(int i) const;
+
+    // 按协议范围整批校验，删除不合法的行并保持原顺序，返回删除行数。
+    // 判定规则与 TrackInfoView::isValid 一致。
+    int removeInvalid();
+
+private:
+    QVector<quint8> m_mask; // removeInvalid 的逐行结果，复用不重新分配
+};
+
+// 批量航迹报文（0x3003，本系统扩展）的非拥有视图：
+// 32B帧头 + 1B惯导有效 + 8B经度 + 8B纬度 + 4B海拔 + 2B航迹数N
+// + N×71B航迹记录（同 6.1 航迹信息） + 16B预留 + 2B校验
+class TrackBatchView : public FrameView
+{
+public:
+    static constexpr int CountOffset = 53;
+    static constexpr int RecordsOffset = 55;
+    static constexpr int TrailerSize = 18;                      // 预留16 + 校验2
+    static constexpr int MinSize = RecordsOffset + TrailerSize; // N=0
+    static int frameSize(int count) { return MinSize + count * TrackInfoView::Size; }
+    // 一个 UDP 数据报最多容纳的航迹数（921）
+    static constexpr int MaxCount = (Protocol::MaxDatagramBytes - MinSize) / TrackInfoView::Size;
+
+    TrackBatchView() = default;
+    // 长度不足以容纳声明的航迹数返回false
+    static bool fromBytes(const uchar *data, int size, TrackBatchView &out);
+    static bool fromBytes(const QByteArray &payload, TrackBatchView &out);
+
+    bool insValid() const { return u8(32) == 0x01; }
+    double radarLon() const { return f64(33); }
+    double radarLat() const { return f64(41); }
+    float radarAlt() const { return f32(49); }
+    int count() const { return u16(CountOffset); }
+    TrackInfoView record(int i) const { return TrackInfoView(m_data + RecordsOffset + i * TrackInfoView::Size); }
+
+    bool isValid() const;
+    // 整帧解码到列式批（追加到 out 末尾，不校验记录范围）
+    void appendTo(TrackBatch &out) const;
+
+private:
+    TrackBatchView(const uchar *data, int size) : FrameView(data, size) {}
+};
@@ -0,0 +1,187 @@
+// TrackFilter.cpp
+#include "TrackFilter.h"
+#include <cmath>
+
+void TrackFilter::setGains(float alpha, float beta)
+{
+    m_alpha = qBound(0.0f, alpha, 1.0f);
+    m_beta = qBound(0.0f, beta, 2.0f);
+}
+
+float TrackFilter::horizon(qint64 fromMs, qint64 toMs) const
+{
+    return float(qBound<qint64>(0, toMs - fromMs, m_maxPredictMs)) * 1e-3f;
+}
+
+void TrackFilter::update(quint16 id, QPointF measured, qint64 ms, bool coasting)
+{
+    const float mx = float(measured.x()), my = float(measured.y());
+    const int pos = m_index.rowOf(id);
+    if (pos < 0)
+    {
+        m_index.append(id);
+        m_x.push_back(mx);
+        m_y.push_back(my);
+        m_vx.push_back(0.0f);
+        m_vy.push_back(0.0f);
+        m_ms.push_back(ms);
+        return;
+    }
+    const std::size_t k = std::size_t(pos);
+    const qint64 gap = ms - m_ms[k];
+    if (gap > m_maxGapMs || gap < 0)
+    {
+        // 中断太久（或时间倒退）：重新起批
+        m_x[k] = mx;
+        m_y[k] = my;
+        m_vx[k] = 0.0f;
+        m_vy[k] = 0.0f;
+        m_ms[k] = ms;
+        return;
+    }
+    const float dt = float(gap) * 1e-3f;
+    // 预测到量测时刻，再按残差修正
+    const float px = m_x[k] + m_vx[k] * dt, py = m_y[k] + m_vy[k] * dt;
+    const float rx = mx - px, ry = my - py;
+    m_x[k] = px + m_alpha * rx;
+    m_y[k] = py + m_alpha * ry;
+    // 同一时刻的重复点（dt=0）与外推点不修正速度
+    if (dt > 0.0f && !coasting)
+    {
+        const float g = m_beta / dt;
+        m_vx[k] += g * rx;
+        m_vy[k] += g * ry;
+    }
+    m_ms[k] = ms;
+}
+
+void TrackFilter::remove(quint16 id)
+{
+    const int pos = m_index.rowOf(id);
+    if (pos < 0)
+        return;
+    m_index.removeRow(pos);
+    DenseIdIndex::eraseRow(pos, m_x, m_y, m_vx, m_vy, m_ms);
+}
+
+void TrackFilter::clear()
+{
+    m_index.clear();
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_ms.clear();
+}
+
+TrackFilter::State TrackFilter::state(quint16 id) const
+{
+    const int pos = m_index.rowOf(id);
+    if (pos < 0)
+        return {};
+    const std::size_t k = std::size_t(pos);
+    return {QPointF(m_x[k], m_y[k]), QPointF(m_vx[k], m_vy[k]), m_ms[k]};
+}
+
+QPointF TrackFilter::position(quint16 id) const
+{
+    const int pos = m_index.rowOf(id);
+    return pos < 0 ? QPointF() : QPointF(m_x[std::size_t(pos)], m_y[std::size_t(pos)]);
+}
+
+QPointF TrackFilter::velocity(quint16 id) const
+{
+    const int pos = m_index.rowOf(id);
+    return pos < 0 ? QPointF() : QPointF(m_vx[std::size_t(pos)], m_vy[std::size_t(pos)]);
+}
+
+QPointF TrackFilter::predict(quint16 id, qint64 ms) const
+{
+    const int pos = m_index.rowOf(id);
+    if (pos < 0)
+        return QPointF();
+    const std::size_t k = std::size_t(pos);
+    const float dt = horizon(m_ms[k], ms);
+    return QPointF(m_x[k] + m_vx[k] * dt, m_y[k] + m_vy[k] * dt);
+}
+
+void TrackFilter::predictAll(qint64 ms, std::vector<float> *x, std::vector<float> *y) const
+{
+    const std::size_t n = m_x.size();
+    x->resize(n);
+    y->resize(n);
+    const float maxDt = float(m_maxPredictMs) * 1e-3f;
+    float *ox = x->data();
+    float *oy = y->data();
+    // 列式逐行，无分支，编译器可向量化
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float dt = qBound(0.0f, float(ms - m_ms[i]) * 1e-3f, maxDt);
+        ox[i] = m_x[i] + m_vx[i] * dt;
+        oy[i] = m_y[i] + m_vy[i] * dt;
+    }
+}
+
+bool TrackFilter::isMoving(qint64 ms) const
+{
+    for (std::size_t i = 0; i < m_x.size(); ++i)
+    {
+        if ((m_vx[i] != 0.0f || m_vy[i] != 0.0f) && ms - m_ms[i] < m_maxPredictMs)
+            return true;
+    }
+    return false;
+}
+
+float TrackFilter::maxLead(qint64 ms) const
+{
+    const float maxDt = float(m_maxPredictMs) * 1e-3f;
+    float lead2 = 0.0f;
+    for (std::size_t i = 0; i < m_x.size(); ++i)
+    {
+        const float dt = qBound(0.0f, float(ms - m_ms[i]) * 1e-3f, maxDt);
+        lead2 = qMax(lead2, (m_vx[i] * m_vx[i] + m_vy[i] * m_vy[i]) * dt * dt);
+    }
+    return std::sqrt(lead2);
+}
+
+bool TrackFilter::intercept(quint16 id, qint64 ms, QPointF from, float speed, QPointF *aim, float *timeSec) const
+{
+    const int pos = m_index.rowOf(id);
+    if (pos < 0 || speed <= 0.0f)
+        return false;
+    const std::size_t k = std::size_t(pos);
+    // 目标 p + v·t 与导弹 from + s·t·dir 相遇：|r + v·t| = s·t，r = p - from
+    const QPointF p = predict(id, ms);
+    const float rx = float(p.x() - from.x()), ry = float(p.y() - from.y());
+    const float vx = m_vx[k], vy = m_vy[k];
+    const float a = vx * vx + vy * vy - speed * speed;
+    const float b = 2.0f * (rx * vx + ry * vy);
+    const float c = rx * rx + ry * ry;
+    float t = -1.0f;
+    if (std::fabs(a) < 1e-6f)
+    {
+        if (b < 0.0f)
+            t = -c / b;
+    }
+    else
+    {
+        const float disc = b * b - 4.0f * a * c;
+        if (disc >= 0.0f)
+        {
+            const float sq = std::sqrt(disc);
+            const float t1 = (-b - sq) / (2.0f * a), t2 = (-b + sq) / (2.0f * a);
+            // 取最早的非负解
+            if (t1 >= 0.0f && (t2 < 0.0f || t1 <= t2))
+                t = t1;
+            else if (t2 >= 0.0f)
+                t = t2;
+        }
+    }
+    if (t < 0.0f)
+        return false;
+    if (aim)
+        *aim = QPointF(p.x() + vx * t, p.y() + vy * t);
+    if (timeSec)
+        *timeSec = t;
+    return true;
+}
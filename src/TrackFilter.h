@@ -0,0 +1,79 @@
+// TrackFilter.h
+#pragma once
+
+#include <QPointF>
+#include <QtGlobal>
+#include <vector>
+#include "DenseIdIndex.h"
+
+// 每条航迹一个 α-β 滤波器（东-北坐标，米；速度 m/s）：
+// - 平滑雷达点的距离/方位噪声并估计速度，回答“某航迹在 t 时刻在哪里”；
+// - 外推点或丢失中的航迹（coasting）只修正位置、不修正速度，保持原有运动趋势；
+// - 两次更新间隔超过 maxGapMs 视为重新起批：位置直接取量测，速度清零；
+// - 状态按列存放（SoA），predictAll 一次算出全部航迹在某时刻的位置（每帧绘制用），
+//   以批号为键（DenseIdIndex），删除时末行填补。
+class TrackFilter
+{
+public:
+    // 增益：alpha 修正位置，beta 修正速度；默认 alpha=0.5、beta 取 Benedict–Bordner 关系 alpha²/(2-alpha)
+    // （alpha=0.5 时约 0.167，比临界阻尼 (2-alpha)-2√(1-alpha)≈0.086 大：欠阻尼，跟踪机动更快）
+    void setGains(float alpha, float beta);
+    float alpha() const { return m_alpha; }
+    float beta() const { return m_beta; }
+    void setMaxGapMs(qint64 ms) { m_maxGapMs = qMax<qint64>(1, ms); }
+    qint64 maxGapMs() const { return m_maxGapMs; }
+    // 预测最多外推这么久（默认3s），更久按此截断，避免丢失后目标“飞走”
+    void setMaxPredictMs(qint64 ms) { m_maxPredictMs = qMax<qint64>(0, ms); }
+    qint64 maxPredictMs() const { return m_maxPredictMs; }
+
+    void update(quint16 id, QPointF measured, qint64 ms, bool coasting);
+    void remove(quint16 id);
+    void clear();
+    int size() const { return m_index.size(); }
+    bool contains(quint16 id) const { return m_index.contains(id); }
+
+    // 单条航迹的滤波状态：拷贝出去后可在别处（如绘制线程）预测，不再访问滤波器
+    struct State
+    {
+        QPointF pos;
+        QPointF vel; // m/s
+        qint64 ms{}; // 最近一次更新时刻
+        // atMs 时刻的位置，外推时长截断到 [0, maxPredictMs]
+        QPointF predict(qint64 atMs, qint64 maxPredictMs) const
+        {
+            return pos + vel * (qreal(qBound<qint64>(0, atMs - ms, maxPredictMs)) * 1e-3);
+        }
+    };
+    // 未知批号返回全零状态
+    State state(quint16 id) const;
+
+    // 最近一次更新后的滤波位置与速度；未知批号返回 (0,0)
+    QPointF position(quint16 id) const;
+    QPointF velocity(quint16 id) const;
+    // ms 时刻的预测位置（外推时长截断到 maxPredictMs）
+    QPointF predict(quint16 id, qint64 ms) const;
+
+    // 全部航迹在 ms 时刻的预测位置，按行写入 x/y，第 i 行对应 ids()[i]
+    void predictAll(qint64 ms, std::vector<float> *x, std::vector<float> *y) const;
+    const std::vector<quint16> &ids() const { return m_index.ids(); }
+    // ms 时刻是否还有航迹的预测位置在变化（有速度且外推未到 maxPredictMs）；视图据此决定是否需要连续重绘
+    bool isMoving(qint64 ms) const;
+    // ms 时刻各航迹预测位置离其滤波位置的最大距离（米）；按滤波位置做的空间查询据此放宽半径
+    float maxLead(qint64 ms) const;
+
+    // 拦截：从 from 以 speed（m/s）直线飞行，按当前速度估计与航迹的相遇点；无解（追不上）返回 false
+    bool intercept(quint16 id, qint64 ms, QPointF from, float speed, QPointF *aim, float *timeSec = nullptr) const;
+
+private:
+    float horizon(qint64 fromMs, qint64 toMs) const;
+
+    float m_alpha = 0.5f;
+    float m_beta = 0.5f * 0.5f / (2.0f - 0.5f);
+    qint64 m_maxGapMs = 10000;
+    qint64 m_maxPredictMs = 3000;
+
+    DenseIdIndex m_index;          // 批号 <-> 行
+    std::vector<float> m_x, m_y;   // 滤波位置 (m)
+    std::vector<float> m_vx, m_vy; // 速度 (m/s)
+    std::vector<qint64> m_ms;      // 最近一次更新时刻
+};
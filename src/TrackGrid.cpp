@@ -0,0 +1,226 @@
+// TrackGrid.cpp
+#include "TrackGrid.h"
+#include <algorithm>
+#include <utility>
+
+TrackGrid::TrackGrid()
+    : m_cells(std::size_t(Cells * Cells))
+{
+}
+
+int TrackGrid::cellCoord(float v) const
+{
+    const float f = (v + m_extent) * m_invCell;
+    if (!(f > 0.0f))
+        return 0;
+    return f >= float(Cells) ? Cells - 1 : int(f);
+}
+
+void TrackGrid::setExtent(float meters)
+{
+    meters = qMax(1.0f, meters);
+    if (meters == m_extent)
+        return;
+    m_extent = meters;
+    m_cellSize = 2.0f * meters / Cells;
+    m_invCell = 1.0f / m_cellSize;
+    for (auto &cell : m_cells)
+        cell.clear();
+    for (int row = 0; row < size(); ++row)
+    {
+        m_cell[std::size_t(row)] = cellOf(m_x[std::size_t(row)], m_y[std::size_t(row)]);
+        link(row);
+    }
+}
+
+void TrackGrid::link(int row)
+{
+    auto &c = m_cells[std::size_t(m_cell[std::size_t(row)])];
+    m_slot[std::size_t(row)] = qint32(c.size());
+    c.push_back(quint16(row));
+}
+
+void TrackGrid::unlink(int row)
+{
+    // 格内末项移到空位
+    auto &c = m_cells[std::size_t(m_cell[std::size_t(row)])];
+    const qint32 slot = m_slot[std::size_t(row)];
+    const quint16 moved = c.back();
+    c[std::size_t(slot)] = moved;
+    m_slot[moved] = slot;
+    c.pop_back();
+}
+
+void TrackGrid::update(quint16 id, QPointF pos)
+{
+    const float x = float(pos.x()), y = float(pos.y());
+    const int cell = cellOf(x, y);
+    int row = m_index.rowOf(id);
+    if (row < 0)
+    {
+        row = m_index.append(id);
+        m_x.push_back(x);
+        m_y.push_back(y);
+        m_cell.push_back(cell);
+        m_slot.push_back(0);
+        link(row);
+        return;
+    }
+    const std::size_t r = std::size_t(row);
+    m_x[r] = x;
+    m_y[r] = y;
+    if (m_cell[r] == cell)
+        return;
+    unlink(row);
+    m_cell[r] = cell;
+    link(row);
+}
+
+void TrackGrid::remove(quint16 id)
+{
+    const int row = m_index.rowOf(id);
+    if (row < 0)
+        return;
+    unlink(row);
+    const int last = size() - 1;
+    m_index.removeRow(row);
+    DenseIdIndex::eraseRow(row, m_x, m_y, m_cell, m_slot);
+    // 末行移到了 row：格子里改记新行号
+    if (row != last)
+        m_cells[std::size_t(m_cell[std::size_t(row)])][std::size_t(m_slot[std::size_t(row)])] = quint16(row);
+}
+
+void TrackGrid::clear()
+{
+    for (auto &cell : m_cells)
+        cell.clear();
+    m_index.clear();
+    m_x.clear();
+    m_y.clear();
+    m_cell.clear();
+    m_slot.clear();
+}
+
+QPointF TrackGrid::position(quint16 id) const
+{
+    const int row = m_index.rowOf(id);
+    return row < 0 ? QPointF() : QPointF(m_x[std::size_t(row)], m_y[std::size_t(row)]);
+}
+
+int TrackGrid::nearest(QPointF pos, float maxDist) const
+{
+    const float px = float(pos.x()), py = float(pos.y());
+    const int x0 = cellCoord(px - maxDist), x1 = cellCoord(px + maxDist);
+    const int y0 = cellCoord(py - maxDist), y1 = cellCoord(py + maxDist);
+    float best = maxDist * maxDist;
+    int bestId = -1;
+    for (int cy = y0; cy <= y1; ++cy)
+    {
+        for (int cx = x0; cx <= x1; ++cx)
+        {
+            for (quint16 row : m_cells[std::size_t(cy * Cells + cx)])
+            {
+                const float dx = m_x[row] - px, dy = m_y[row] - py;
+                const float d2 = dx * dx + dy * dy;
+                if (d2 <= best)
+                {
+                    best = d2;
+                    bestId = m_index.idAt(row);
+                }
+            }
+        }
+    }
+    return bestId;
+}
+
+int TrackGrid::withinRadius(QPointF center, float radius, QVector<quint16> *out) const
+{
+    const float px = float(center.x()), py = float(center.y());
+    const float r2 = radius * radius;
+    const int x0 = cellCoord(px - radius), x1 = cellCoord(px + radius);
+    const int y0 = cellCoord(py - radius), y1 = cellCoord(py + radius);
+    int found = 0;
+    for (int cy = y0; cy <= y1; ++cy)
+    {
+        for (int cx = x0; cx <= x1; ++cx)
+        {
+            for (quint16 row : m_cells[std::size_t(cy * Cells + cx)])
+            {
+                const float dx = m_x[row] - px, dy = m_y[row] - py;
+                if (dx * dx + dy * dy <= r2)
+                {
+                    out->append(m_index.idAt(row));
+                    ++found;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+int TrackGrid::nearestK(QPointF pos, int k, QVector<quint16> *out) const
+{
+    k = qMin(k, size());
+    if (k <= 0)
+        return 0;
+    const float px = float(pos.x()), py = float(pos.y());
+    const int cx = cellCoord(px), cy = cellCoord(py);
+    // 以距离为键的最大堆，堆顶为当前第 k 近
+    std::vector<std::pair<float, quint16>> best;
+    best.reserve(std::size_t(k));
+    auto visit = [&](int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= Cells || y >= Cells)
+            return;
+        for (quint16 row : m_cells[std::size_t(y * Cells + x)])
+        {
+            const float dx = m_x[row] - px, dy = m_y[row] - py;
+            const float d2 = dx * dx + dy * dy;
+            if (int(best.size()) < k)
+            {
+                best.emplace_back(d2, row);
+                std::push_heap(best.begin(), best.end());
+            }
+            else if (d2 < best.front().first)
+            {
+                std::pop_heap(best.begin(), best.end());
+                best.back() = {d2, row};
+                std::push_heap(best.begin(), best.end());
+            }
+        }
+    };
+    // 以所在格为中心逐环向外；已访问的方块之外的点距离不小于 pos 到方块（未触及网格边界的）边的距离
+    for (int ring = 0; ring < Cells; ++ring)
+    {
+        const int x0 = cx - ring, x1 = cx + ring, y0 = cy - ring, y1 = cy + ring;
+        for (int x = x0; x <= x1; ++x)
+        {
+            visit(x, y0);
+            if (ring > 0)
+                visit(x, y1);
+        }
+        for (int y = y0 + 1; y < y1; ++y)
+        {
+            visit(x0, y);
+            visit(x1, y);
+        }
+        if (int(best.size()) < k)
+            continue;
+        float bound = -1.0f;
+        auto edge = [&bound](bool open, float d)
+        {
+            if (open)
+                bound = bound < 0.0f ? d : qMin(bound, d);
+        };
+        edge(x0 > 0, px - (-m_extent + float(x0) * m_cellSize));
+        edge(x1 < Cells - 1, (-m_extent + float(x1 + 1) * m_cellSize) - px);
+        edge(y0 > 0, py - (-m_extent + float(y0) * m_cellSize));
+        edge(y1 < Cells - 1, (-m_extent + float(y1 + 1) * m_cellSize) - py);
+        if (bound < 0.0f || (bound > 0.0f && bound * bound >= best.front().first))
+            break;
+    }
+    std::sort_heap(best.begin(), best.end());
+    for (const auto &b : best)
+        out->append(m_index.idAt(b.second));
+    return int(best.size());
+}
@@ -0,0 +1,55 @@
+// TrackGrid.h
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+#include "DenseIdIndex.h"
+
+// 航迹位置的均匀网格索引（东-北坐标，米，以雷达为原点）：
+// - 覆盖 [-extent, extent]²，Cells×Cells 个格子，量程外的点归入边缘格子（仍可查到）；
+// - update/remove 为 O(1)：每行记录位置、所在格子与格内下标，格子里存行号，删除时格内末项填补；
+// - 查询只访问与查询范围相交的格子：点选（给定半径内最近）、半径查询、k 近邻（按环向外扩展）。
+// 以批号为键（DenseIdIndex），行稠密存放。
+class TrackGrid
+{
+public:
+    static constexpr int Cells = 64; // 每边格数；1 万条航迹时平均每格 2~3 条
+
+    TrackGrid();
+
+    // 覆盖范围（米，通常为量程）；改变后按新格子重新归档
+    void setExtent(float meters);
+    float extent() const { return m_extent; }
+
+    void update(quint16 id, QPointF pos);
+    void remove(quint16 id);
+    void clear();
+    int size() const { return m_index.size(); }
+    bool contains(quint16 id) const { return m_index.contains(id); }
+    QPointF position(quint16 id) const;
+
+    // 距 pos 不超过 maxDist 的最近一条，没有返回 -1
+    int nearest(QPointF pos, float maxDist) const;
+    // 距 center 不超过 radius 的全部批号（无序），追加到 out，返回个数
+    int withinRadius(QPointF center, float radius, QVector<quint16> *out) const;
+    // 距 pos 最近的 k 条，由近到远追加到 out，返回个数
+    int nearestK(QPointF pos, int k, QVector<quint16> *out) const;
+
+private:
+    int cellCoord(float v) const;
+    int cellOf(float x, float y) const { return cellCoord(y) * Cells + cellCoord(x); }
+    // 行 row 加入/移出其格子（m_cell[row] 为格子）
+    void link(int row);
+    void unlink(int row);
+
+    DenseIdIndex m_index;                      // 批号 <-> 行
+    std::vector<float> m_x, m_y;
+    std::vector<qint32> m_cell;                // 所在格子
+    std::vector<qint32> m_slot;                // 在格子内的下标
+    std::vector<std::vector<quint16>> m_cells; // 格子 -> 行号
+    float m_extent = 5000.0f;
+    float m_cellSize = 2.0f * 5000.0f / Cells;
+    float m_invCell = 1.0f / m_cellSize;
+};
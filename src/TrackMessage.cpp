@@ -4,128 +4,103 @@
 #include <cstring>
 #include <QtGlobal>
 
-static quint16 rd_u16(const uchar *p) { return qFromLittleEndian<quint16>(p); }
-static quint32 rd_u32(const uchar *p) { return qFromLittleEndian<quint32>(p); }
-static float rd_f32(const uchar *p)
+static bool inRange(double v, double lo, double hi) { return v >= lo && v <= hi; }
+
+bool TrackInfoView::isValid() const
 {
-    quint32 bits = rd_u32(p);
-    float f;
-    memcpy(&f, &bits, sizeof(f));
-    return f;
+    // 基本合法性校验（根据协议注释的范围）：
+    if (!inRange(tgtLon(), -180.0, 180.0))
+        return false;
+    if (!inRange(tgtLat(), -90.0, 90.0))
+        return false;
+    if (!inRange(double(azimuth()), 0.0, 360.0))
+        return false;
+    if (!inRange(double(elevation()), -90.0, 90.0))
+        return false;
+    if (!inRange(double(course()), 0.0, 360.0))
+        return false;
+    if (!inRange(double(rawAzimuth()), 0.0, 360.0))
+        return false;
+    if (!inRange(double(rawElevation()), -90.0, 90.0))
+        return false;
+    if (quality() > 100)
+        return false;
+    // 有些设备distance<0表示异常，过滤
+    if (distance() < 0 || rawDistance() < 0)
+        return false;
+    return true;
 }
-static double rd_f64(const uchar *p)
+
+void TrackInfoView::toInfo(TrackInfo &ti) const
 {
-    quint64 bits = qFromLittleEndian<quint64>(p);
-    double d;
-    memcpy(&d, &bits, sizeof(d));
-    return d;
+    ti.trackId = trackId();
+    ti.tgtLon = tgtLon();
+    ti.tgtLat = tgtLat();
+    ti.tgtAlt = tgtAlt();
+    ti.distance = distance();
+    ti.azimuth = azimuth();
+    ti.elevation = elevation();
+    ti.speed = speed();
+    ti.course = course();
+    ti.strength = strength();
+    copyTo(ti.reserved4, 46, 4); // 预留4字节
+    ti.targetType = targetType();
+    ti.targetSize = targetSize();
+    ti.pointType = pointType();
+    ti.trackType = trackType();
+    ti.lostCount = lostCount();
+    ti.quality = quality();
+    ti.rawDistance = rawDistance();
+    ti.rawAzimuth = rawAzimuth();
+    ti.rawElevation = rawElevation();
+    copyTo(ti.reserved3, 68, 3);
 }
 
-bool TrackParser::parseLittleEndian(const QByteArray &payload, TrackMessage &out)
+bool TrackMessageView::fromBytes(const uchar *data, int size, TrackMessageView &out)
 {
-    // 计算最小长度：32(head)+1+8+8+4 + trackInfo(2+8+8+4+4+4+4+4+4+4+4+1*?)+16+2
-    // 逐字段推进避免算错时越界。
     // 最小长度精确为 142 字节：
     // 32(head) + 1(ins) + 8(lon) + 8(lat) + 4(alt)
     // + trackInfo(2 + 8 + 8 + 4 + 6*4 + 4 + 6 + 3*4 + 3 = 71)
     // + 16(reserved) + 2(crc)
-    if (payload.size() < 142)
+    if (!data || size < Size)
         return false;
+    out = TrackMessageView(data, size);
+    return true;
+}
 
-    const uchar *p = reinterpret_cast<const uchar *>(payload.constData());
-    int off = 0;
-
-    out = TrackMessage{};
-    out.frameHead = QByteArray(reinterpret_cast<const char *>(p), 32);
-    off += 32;
-
-    out.insValid = p[off++] == 0x01;
-    out.radarLon = rd_f64(p + off);
-    off += 8;
-    out.radarLat = rd_f64(p + off);
-    off += 8;
-    out.radarAlt = rd_f32(p + off);
-    off += 4;
-
-    TrackInfo ti{};
-    ti.trackId = rd_u16(p + off);
-    off += 2;
-    ti.tgtLon = rd_f64(p + off);
-    off += 8;
-    ti.tgtLat = rd_f64(p + off);
-    off += 8;
-    ti.tgtAlt = rd_f32(p + off);
-    off += 4;
-    ti.distance = rd_f32(p + off);
-    off += 4;
-    ti.azimuth = rd_f32(p + off);
-    off += 4;
-    ti.elevation = rd_f32(p + off);
-    off += 4;
-    ti.speed = rd_f32(p + off);
-    off += 4;
-    ti.course = rd_f32(p + off);
-    off += 4;
-    ti.strength = rd_f32(p + off);
-    off += 4;
-
-    // 预留4字节
-    memcpy(ti.reserved4, p + off, 4);
-    off += 4;
-
-    ti.targetType = p[off++];
-    ti.targetSize = p[off++];
-    ti.pointType = p[off++];
-    ti.trackType = p[off++];
-    ti.lostCount = p[off++];
-    ti.quality = p[off++];
-
-    ti.rawDistance = rd_f32(p + off);
-    off += 4;
-    ti.rawAzimuth = rd_f32(p + off);
-    off += 4;
-    ti.rawElevation = rd_f32(p + off);
-    off += 4;
-    memcpy(ti.reserved3, p + off, 3);
-    off += 3;
-
-    out.info = ti;
-
-    memcpy(out.reserved16, p + off, 16);
-    off += 16;
-    out.checksum = rd_u16(p + off);
-    off += 2;
-
-    Q_UNUSED(off);
+bool TrackMessageView::fromBytes(const QByteArray &payload, TrackMessageView &out)
+{
+    return fromBytes(reinterpret_cast<const uchar *>(payload.constData()), int(payload.size()), out);
+}
 
-    // 基本合法性校验（根据协议注释的范围）：
-    auto inRange = [](double v, double lo, double hi)
-    { return v >= lo && v <= hi; };
-    if (!inRange(out.radarLon, -180.0, 180.0))
-        return false;
-    if (!inRange(out.radarLat, -90.0, 90.0))
-        return false;
-    if (!inRange(double(out.info.tgtLon), -180.0, 180.0))
-        return false;
-    if (!inRange(double(out.info.tgtLat), -90.0, 90.0))
-        return false;
-    if (!inRange(double(out.info.azimuth), 0.0, 360.0))
-        return false;
-    if (!inRange(double(out.info.elevation), -90.0, 90.0))
-        return false;
-    if (!inRange(double(out.info.course), 0.0, 360.0))
-        return false;
-    if (!inRange(double(out.info.rawAzimuth), 0.0, 360.0))
-        return false;
-    if (!inRange(double(out.info.rawElevation), -90.0, 90.0))
-        return false;
-    if (out.info.quality > 100)
+bool TrackMessageView::isValid() const
+{
+    if (!inRange(radarLon(), -180.0, 180.0))
         return false;
-    // 有些设备distance<0表示异常，过滤
-    if (out.info.distance < 0 || out.info.rawDistance < 0)
+    if (!inRange(radarLat(), -90.0, 90.0))
         return false;
+    return info().isValid();
+}
 
-    return true;
+void TrackMessageView::toMessage(TrackMessage &out) const
+{
+    copyTo(out.frameHead, 0, 32);
+    out.insValid = insValid();
+    out.radarLon = radarLon();
+    out.radarLat = radarLat();
+    out.radarAlt = radarAlt();
+    info().toInfo(out.info);
+    copyTo(out.reserved16, 124, 16);
+    out.checksum = checksum();
+}
+
+bool TrackParser::parseLittleEndian(const QByteArray &payload, TrackMessage &out)
+{
+    TrackMessageView view;
+    if (!TrackMessageView::fromBytes(payload, view))
+        return false;
+    view.toMessage(out);
+    return view.isValid();
 }
 
 bool TrackParser::hasReadableMagic(const QByteArray &payload)
@@ -3,9 +3,11 @@
 
 #include <QByteArray>
 #include <QtGlobal>
+#include "FrameView.h"
 
 // 6.1 雷达航迹报文（假定小端字节序，帧头32字节）
-// 本文件仅解析协议字段到内存结构，未做校验位验证。
+// 本文件仅解析协议字段到内存结构；校验位由 MessageDispatcher 按帧头校验方式验证。
+// 热路径使用 TrackMessageView 直接读接收缓冲；TrackMessage 仅在需要保存数据时使用。
 struct TrackInfo
 {
     quint16 trackId{};     // 航迹批号
@@ -35,11 +37,11 @@ struct TrackInfo
 
 struct TrackMessage
 {
-    QByteArray frameHead; // 32B
-    bool insValid{};      // 惯导有效标志 0x01 有效
-    double radarLon{};    // 雷达经度
-    double radarLat{};    // 雷达纬度
-    float radarAlt{};     // 雷达海拔
+    quint8 frameHead[32]{}; // 32B
+    bool insValid{};        // 惯导有效标志 0x01 有效
+    double radarLon{};      // 雷达经度
+    double radarLat{};      // 雷达纬度
+    float radarAlt{};       // 雷达海拔
 
     TrackInfo info; // 1个航迹
 
@@ -47,6 +49,66 @@ struct TrackMessage
     quint16 checksum{};      // 校验（未验）
 };
 
+// 单条航迹记录（71字节）的非拥有视图
+class TrackInfoView : public FrameView
+{
+public:
+    static constexpr int Size = 71;
+
+    TrackInfoView() = default;
+    explicit TrackInfoView(const uchar *record) : FrameView(record, Size) {}
+
+    quint16 trackId() const { return u16(0); }
+    double tgtLon() const { return f64(2); }
+    double tgtLat() const { return f64(10); }
+    float tgtAlt() const { return f32(18); }
+    float distance() const { return f32(22); }
+    float azimuth() const { return f32(26); }
+    float elevation() const { return f32(30); }
+    float speed() const { return f32(34); }
+    float course() const { return f32(38); }
+    float strength() const { return f32(42); }
+    quint8 targetType() const { return u8(50); }
+    quint8 targetSize() const { return u8(51); }
+    quint8 pointType() const { return u8(52); }
+    quint8 trackType() const { return u8(53); }
+    quint8 lostCount() const { return u8(54); }
+    quint8 quality() const { return u8(55); }
+    float rawDistance() const { return f32(56); }
+    float rawAzimuth() const { return f32(60); }
+    float rawElevation() const { return f32(64); }
+
+    // 按协议注释的取值范围检查
+    bool isValid() const;
+    void toInfo(TrackInfo &out) const;
+};
+
+// 航迹报文（142字节）的非拥有视图，字段直接从接收缓冲读取，不分配内存
+class TrackMessageView : public FrameView
+{
+public:
+    static constexpr int Size = 142;
+    static constexpr int InfoOffset = 53;
+
+    TrackMessageView() = default;
+    // 长度不足返回false
+    static bool fromBytes(const uchar *data, int size, TrackMessageView &out);
+    static bool fromBytes(const QByteArray &payload, TrackMessageView &out);
+
+    bool insValid() const { return u8(32) == 0x01; }
+    double radarLon() const { return f64(33); }
+    double radarLat() const { return f64(41); }
+    float radarAlt() const { return f32(49); }
+    TrackInfoView info() const { return TrackInfoView(m_data + InfoOffset); }
+    quint16 checksum() const { return u16(140); }
+
+    bool isValid() const;
+    void toMessage(TrackMessage &out) const;
+
+private:
+    TrackMessageView(const uchar *data, int size) : FrameView(data, size) {}
+};
+
 namespace TrackParser
 {
     // 成功返回 true；否则 false。不会越界访问。
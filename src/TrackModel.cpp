@@ -0,0 +1,442 @@
+// TrackModel.cpp
+#include "TrackModel.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+
+namespace
+{
+    // 缩减时每条轨迹至少保留的点数
+    constexpr int MinShedKeep = 16;
+} // namespace
+
+TrackModel::TrackModel(QObject *parent)
+    : QObject(parent)
+{
+    // 时间轮非空时按 tick 推进，空闲时停下
+    m_expiryTimer.setInterval(int(m_expiry.tickMs()));
+    connect(&m_expiryTimer, &QTimer::timeout, this, [this]
+            { expire(QDateTime::currentMSecsSinceEpoch()); });
+    applyTrailCacheLimits();
+}
+
+void TrackModel::setTrailMemoryBudget(qint64 bytes)
+{
+    m_trailBudget = qMax<qint64>(0, bytes);
+    applyTrailCacheLimits();
+    enforceTrailBudget();
+    publish();
+}
+
+void TrackModel::setTrailMirrorPool(BlockPool *pool)
+{
+    if (pool == m_mirrorPool)
+        return;
+    m_mirrorPool = pool;
+    applyTrailCacheLimits();
+    enforceTrailBudget();
+    publish();
+}
+
+void TrackModel::applyTrailCacheLimits()
+{
+    // 缓存的空闲块不超过各自预算的 1/8（不限预算时保留默认缓存）
+    const qint64 limit = m_trailBudget > 0 ? ownTrailBudget() / 8 : qint64(4) << 20;
+    m_trailPool.setCacheLimit(limit);
+    if (m_mirrorPool)
+        m_mirrorPool->setCacheLimit(limit);
+}
+
+void TrackModel::setTrailRetentionMs(qint64 ms)
+{
+    m_trailKeepMs = qMax<qint64>(1000, ms);
+    rescheduleAll();
+}
+
+void TrackModel::setTrackTimeoutMs(qint64 ms)
+{
+    m_trackTimeoutMs = qMax<qint64>(1000, ms);
+    rescheduleAll();
+}
+
+void TrackModel::setCoastTimeoutMs(qint64 ms)
+{
+    m_coastTimeoutMs = qMax<qint64>(1000, ms);
+    rescheduleAll();
+}
+
+void TrackModel::setMaxRange(float meters)
+{
+    meters = qMax(100.0f, meters);
+    if (meters == m_maxRange)
+        return;
+    m_maxRange = meters;
+    m_scorer.setMaxRange(meters);
+    m_grid.setExtent(meters);
+    // 超出新量程的删除，其余在发布前按新量程重算威胁分
+    QVector<quint16> outside;
+    for (const Track &t : m_tracks)
+    {
+        if (t.distance > m_maxRange)
+            outside.append(t.id);
+    }
+    for (quint16 id : outside)
+        erase(id);
+    publish();
+}
+
+void TrackModel::setThreatWeights(const ThreatWeights &w)
+{
+    m_scorer.setWeights(w);
+    publish();
+}
+
+void TrackModel::setMaxSpeed(float mps)
+{
+    m_scorer.setMaxSpeed(mps);
+    publish();
+}
+
+void TrackModel::applyTrack(const TrackMessage &msg)
+{
+    applyTrackAt(msg, QDateTime::currentMSecsSinceEpoch());
+}
+
+void TrackModel::applyTrackAt(const TrackMessage &msg, qint64 now)
+{
+    const TrackInfo &ti = msg.info;
+    runExpiry(now);
+    Track *t = touch(ti.trackId, ti.distance, ti.azimuth, now);
+    if (t)
+    {
+        t->elevation = ti.elevation;
+        t->speed = qAbs(ti.speed);
+        t->course = ti.course;
+        t->targetType = ti.targetType;
+        t->targetSize = ti.targetSize;
+        t->pointType = ti.pointType;
+        t->trackType = ti.trackType;
+        t->lostCount = ti.lostCount;
+        t->quality = ti.quality;
+        t->identityKnown = ti.targetType != 0;
+        m_scorer.set(t->id, t->distance, t->speed, t->targetType);
+        m_filter.update(t->id, t->trail.back().pos, now, t->coasting());
+        m_grid.update(t->id, m_filter.position(t->id));
+        scheduleExpiry(*t);
+    }
+    publish();
+}
+
+void TrackModel::applyBatch(const TrackBatch &batch)
+{
+    // 整批共用一个时间戳，最后只发布一次
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    runExpiry(now);
+    for (int i = 0; i < batch.size(); ++i)
+    {
+        Track *t = touch(batch.trackId[i], batch.distance[i], batch.azimuth[i], now);
+        if (!t)
+            continue;
+        t->elevation = batch.elevation[i];
+        t->speed = qAbs(batch.speed[i]);
+        t->course = batch.course[i];
+        t->targetType = batch.targetType[i];
+        t->targetSize = batch.targetSize[i];
+        t->pointType = batch.pointType[i];
+        t->trackType = batch.trackType[i];
+        t->lostCount = batch.lostCount[i];
+        t->quality = batch.quality[i];
+        t->identityKnown = batch.targetType[i] != 0;
+        m_scorer.set(t->id, t->distance, t->speed, t->targetType);
+        m_filter.update(t->id, t->trail.back().pos, now, t->coasting());
+        m_grid.update(t->id, m_filter.position(t->id));
+        scheduleExpiry(*t);
+    }
+    publish();
+}
+
+bool TrackModel::remove(quint16 id)
+{
+    if (!m_tracks.contains(id))
+        return false;
+    erase(id);
+    publish();
+    return true;
+}
+
+void TrackModel::clear()
+{
+    for (const Track &t : m_tracks)
+    {
+        if (t.pending != Added)
+            m_changes.removed.append(t.id);
+    }
+    m_tracks.clear();
+    m_scorer.clear();
+    m_grid.clear();
+    m_filter.clear();
+    m_expiry.clear();
+    m_expiryTimer.stop();
+    publish();
+}
+
+void TrackModel::expire(qint64 nowMs)
+{
+    runExpiry(nowMs);
+    if (m_expiry.isEmpty())
+        m_expiryTimer.stop();
+    publish();
+}
+
+qint64 TrackModel::deadlineOf(const Track &t) const
+{
+    // 外推点或连续丢失中的航迹超时更短
+    qint64 deadline = t.lastMs + (t.coasting() ? m_coastTimeoutMs : m_trackTimeoutMs);
+    // 首点在第二点过期时丢弃（首段跨过保留边界的部分由视图绘制时裁掉）
+    if (!t.trail.isEmpty())
+        deadline = qMin(deadline, t.trail[t.trail.size() >= 2 ? 1 : 0].ms + m_trailKeepMs);
+    return deadline;
+}
+
+void TrackModel::scheduleExpiry(const Track &t)
+{
+    const qint64 deadline = deadlineOf(t);
+    if (!m_expiry.isScheduled(t.id) || deadline < m_expiry.deadline(t.id))
+        m_expiry.schedule(t.id, deadline);
+    if (!m_expiryTimer.isActive())
+        m_expiryTimer.start();
+}
+
+void TrackModel::rescheduleAll()
+{
+    for (const Track &t : m_tracks)
+        m_expiry.schedule(t.id, deadlineOf(t));
+}
+
+void TrackModel::runExpiry(qint64 nowMs)
+{
+    m_due.clear();
+    m_expiry.advance(nowMs, &m_due);
+    const qint64 cutoff = nowMs - m_trailKeepMs;
+    for (quint16 id : m_due)
+    {
+        Track *t = m_tracks.find(id);
+        if (!t)
+            continue;
+        // 只丢弃整段都已过期的首点；单独剩下的过期点也丢弃
+        while (t->trail.size() >= 2 ? t->trail[1].ms <= cutoff : (!t->trail.isEmpty() && t->trail.front().ms <= cutoff))
+        {
+            t->trail.popFront();
+            // 锚点被丢弃，末段重新开始
+            if (t->trail.size() <= 2)
+                t->trailFit.reset();
+        }
+        const qint64 deadline = deadlineOf(*t);
+        if (t->trail.isEmpty() || deadline <= nowMs)
+            erase(id);
+        else
+            m_expiry.schedule(id, deadline); // 截止时刻被推迟（期间有更新）或只裁剪了轨迹
+    }
+}
+
+void TrackModel::enforceTrailBudget()
+{
+    const qint64 budget = ownTrailBudget();
+    if (budget <= 0 || m_trailPool.liveBytes() <= budget)
+        return;
+    // 降到预算的 7/8 以下，避免之后每批都刚好超出、反复缩减
+    const qint64 target = budget - budget / 8;
+    m_shedOrder.clear();
+    for (int i = 0; i < m_tracks.size(); ++i)
+    {
+        if (m_tracks.at(i).trail.capacity() > MinShedKeep)
+            m_shedOrder.append(i);
+    }
+    // 威胁分级低的在前，同级最久未更新的在前
+    std::sort(m_shedOrder.begin(), m_shedOrder.end(), [this](int a, int b)
+              {
+        const Track &ta = m_tracks.at(a), &tb = m_tracks.at(b);
+        if (ta.tier != tb.tier)
+            return ta.tier < tb.tier;
+        return ta.lastMs < tb.lastMs; });
+    for (int i : m_shedOrder)
+    {
+        if (m_trailPool.liveBytes() <= target)
+            break;
+        Track &t = m_tracks.at(i);
+        // 逐次减半，够用即止：优先释放空余容量，不够再丢最旧的点
+        int dropped = 0;
+        while (t.trail.capacity() > MinShedKeep && m_trailPool.liveBytes() > target)
+            dropped += t.trail.shrinkTo(qMin(t.trail.size(), t.trail.capacity() / 2));
+        ++m_shedTracks;
+        if (dropped == 0)
+            continue;
+        m_shedPoints += quint64(dropped);
+        if (t.trail.size() <= 2)
+            t.trailFit.reset();
+        if (t.pending == None)
+        {
+            t.pending = Updated;
+            m_changes.updated.append(t.id);
+        }
+    }
+    // 全部航迹都已缩到最少点数仍超出：只提示一次，直到重新回到预算内
+    const bool over = m_trailPool.liveBytes() > budget;
+    if (over && !m_budgetWarned)
+        qWarning() << "Trail memory budget" << budget << "bytes exceeded:" << m_trailPool.liveBytes()
+                   << "bytes in use by" << m_tracks.size() << "tracks at minimum history";
+    m_budgetWarned = over;
+}
+
+int TrackModel::pick(QPointF pos, float maxDist, qint64 nowMs) const
+{
+    QVector<quint16> candidates;
+    m_grid.withinRadius(pos, maxDist + m_filter.maxLead(nowMs), &candidates);
+    int best = -1;
+    qreal bestDist2 = qreal(maxDist) * maxDist;
+    for (quint16 id : candidates)
+    {
+        const QPointF d = m_filter.predict(id, nowMs) - pos;
+        const qreal dist2 = d.x() * d.x() + d.y() * d.y();
+        if (dist2 <= bestDist2)
+        {
+            bestDist2 = dist2;
+            best = id;
+        }
+    }
+    return best;
+}
+
+TrailStats TrackModel::trailStats() const
+{
+    TrailStats s;
+    s.tracks = m_tracks.size();
+    s.receivedPoints = m_receivedPoints;
+    s.keptPoints = m_keptPoints;
+    for (const Track &t : m_tracks)
+        s.points += t.trail.size();
+    s.mirrorLiveBytes = m_mirrorPool ? m_mirrorPool->liveBytes() : 0;
+    s.mirrorCachedBytes = m_mirrorPool ? m_mirrorPool->cachedBytes() : 0;
+    s.bytes = qint64(m_tracks.size()) * qint64(sizeof(Track)) + m_trailPool.liveBytes() + s.mirrorLiveBytes;
+    s.poolLiveBytes = m_trailPool.liveBytes();
+    s.poolCachedBytes = m_trailPool.cachedBytes();
+    s.poolPeakBytes = m_trailPool.peakLiveBytes();
+    s.budgetBytes = m_trailBudget;
+    s.shedPoints = m_shedPoints;
+    s.shedTracks = m_shedTracks;
+    return s;
+}
+
+TrackModel::Track *TrackModel::touch(quint16 id, float distance, float azimuth, qint64 nowMs)
+{
+    // 超出量程：删除已存在航迹并忽略该点
+    if (distance > m_maxRange)
+    {
+        erase(id);
+        return nullptr;
+    }
+    bool created = false;
+    Track &t = m_tracks.insert(id, &created);
+    if (created)
+    {
+        t.id = id;
+        t.trail.setPool(&m_trailPool);
+        t.firstMs = nowMs;
+        t.pending = Added;
+        m_changes.added.append(id);
+    }
+    else if (t.pending == None)
+    {
+        t.pending = Updated;
+        m_changes.updated.append(id);
+    }
+    t.distance = distance;
+    t.azimuth = azimuth;
+    t.lastMs = nowMs;
+    // 距离/方位转为东-北坐标（米）：东 = d·sin(az)，北 = d·cos(az)，azimuth 相对正北顺时针
+    const float az = qDegreesToRadians(azimuth);
+    const QPointF pos(distance * qSin(az), distance * qCos(az));
+    const TrailPoint pt{pos, nowMs};
+    const int n = t.trail.size();
+    ++m_receivedPoints;
+    if (m_trailTolerance > 0.0f && n >= 2 && t.trailFit.tryExtend(t.trail[n - 2].pos, pos, m_trailTolerance))
+    {
+        t.trail[n - 1] = pt; // 末点在容差内可由新点代替
+    }
+    else
+    {
+        t.trail.push(pt, m_maxTrailPoints);
+        ++t.trailPushed;
+        ++m_keptPoints;
+        if (t.trail.size() >= 2)
+            t.trailFit.open(t.trail[t.trail.size() - 2].pos, pos, m_trailTolerance);
+        // 缓冲只在追加时增长：超出预算立即缩减，占用最多超出一个缓冲块
+        if (m_trailBudget > 0 && m_trailPool.liveBytes() > ownTrailBudget())
+            enforceTrailBudget();
+    }
+    return &t;
+}
+
+void TrackModel::erase(quint16 id)
+{
+    const Track *t = m_tracks.find(id);
+    if (!t)
+        return;
+    // 本周期内新增又删除的航迹对视图不可见，不必发布
+    if (t->pending != Added)
+        m_changes.removed.append(id);
+    m_tracks.remove(id);
+    m_scorer.remove(id);
+    m_grid.remove(id);
+    m_filter.remove(id);
+    m_expiry.cancel(id);
+}
+
+void TrackModel::publish()
+{
+    // 整批重算威胁分；输入未变但分数变了（改权重/量程）的航迹也记为更新
+    if (m_scorer.hasPending())
+    {
+        m_rescored.clear();
+        m_scorer.rescore(&m_rescored);
+        for (quint16 id : m_rescored)
+        {
+            Track *t = m_tracks.find(id);
+            if (!t)
+                continue;
+            t->score = m_scorer.score(id);
+            t->tier = m_scorer.tier(id);
+            if (t->pending == None)
+            {
+                t->pending = Updated;
+                m_changes.updated.append(id);
+            }
+        }
+    }
+    if (m_changes.isEmpty())
+        return;
+    // 只保留仍处于对应状态的批号（本周期内被删除的已在 erase 中处理）
+    m_published.clear();
+    m_published.removed = m_changes.removed;
+    for (quint16 id : m_changes.added)
+    {
+        Track *t = m_tracks.find(id);
+        if (t && t->pending == Added)
+        {
+            m_published.added.append(id);
+            t->pending = None;
+        }
+    }
+    for (quint16 id : m_changes.updated)
+    {
+        Track *t = m_tracks.find(id);
+        if (t && t->pending == Updated)
+        {
+            m_published.updated.append(id);
+            t->pending = None;
+        }
+    }
+    m_changes.clear();
+    emit changed(m_published);
+}
@@ -0,0 +1,219 @@
+// TrackModel.h
+#pragma once
+
+#include <QObject>
+#include <QPointF>
+#include <QTimer>
+#include <QVector>
+#include "BlockPool.h"
+#include "RingBuffer.h"
+#include "ThreatScorer.h"
+#include "TimerWheel.h"
+#include "TrailSimplifier.h"
+#include "TrackBatch.h"
+#include "TrackFilter.h"
+#include "TrackGrid.h"
+#include "TrackMessage.h"
+#include "TrackTable.h"
+
+// 轨迹内存与抽稀效果（trailStats() 现算，O(航迹数)）
+struct TrailStats
+{
+    int tracks{};
+    qint64 points{};            // 当前保存的轨迹点
+    quint64 receivedPoints{};   // 累计收到的轨迹点
+    quint64 keptPoints{};       // 累计保留的轨迹点（其余被抽稀合并）
+    qint64 bytes{};             // 航迹与轨迹缓冲占用（按容量计，含副本）
+    qint64 poolLiveBytes{};     // 轨迹缓冲池：在用
+    qint64 poolCachedBytes{};   // 轨迹缓冲池：空闲待复用
+    qint64 poolPeakBytes{};     // 轨迹缓冲池：在用峰值
+    qint64 budgetBytes{};       // 轨迹内存预算，0 为不限（含副本）
+    qint64 mirrorLiveBytes{};   // 轨迹副本（绘制镜像）的缓冲池：在用，计入预算
+    qint64 mirrorCachedBytes{}; // 轨迹副本的缓冲池：空闲待复用
+    quint64 shedPoints{};       // 因预算不足丢弃的轨迹点
+    quint64 shedTracks{};       // 因预算不足被缩减轨迹的次数（按航迹计）
+
+    double compression() const { return keptPoints ? double(receivedPoints) / double(keptPoints) : 1.0; }
+    qint64 bytesPerTrack() const { return tracks ? bytes / tracks : 0; }
+};
+
+// 一次发布的航迹变化（批号）。同一发布周期内先增后删的航迹不出现；
+// 删除后又以同一批号出现的航迹同时在 removed 与 added 中，按 removed -> added -> updated 顺序处理即可。
+struct TrackChangeSet
+{
+    QVector<quint16> added;
+    QVector<quint16> updated;
+    QVector<quint16> removed;
+
+    bool isEmpty() const { return added.isEmpty() && updated.isEmpty() && removed.isEmpty(); }
+    void clear()
+    {
+        added.clear();
+        updated.clear();
+        removed.clear();
+    }
+};
+
+// 航迹状态（所有视图共用的唯一一份）：
+// - 每条解析后的航迹只在这里应用一次：量程判定、轨迹点在此计算，威胁分与分级由 ThreatScorer
+//   在发布前整批重算（只算输入变化的航迹；改权重/量程时整表重算，分数变化的航迹记为更新）；
+// - 每次 applyBatch/applyTrack/过期/删除结束后发布一次 changed（整批一次），视图据此增量刷新；
+// - 轨迹点在线抽稀（见 TrailSimplifier）：直线段只留端点，误差不超过 trailTolerance() 米，长时间保留轨迹内存仍有界；
+// - 过期由时间轮驱动：每条航迹一个截止时刻（超时删除或最旧轨迹点到期，取较早者），到时才处理该航迹，
+//   不再每秒遍历全部航迹；外推/丢失中的航迹超时更短（coastTimeoutMs）；
+// - 每条航迹有 α-β 滤波状态 filter()：平滑位置、估计速度，视图按显示时刻预测位置、拦截按其提前量瞄准；
+// - 轨迹缓冲从按2的幂分级的块池取得（航迹删除后缓冲留给新航迹复用），总量受 trailMemoryBudget() 约束：
+//   超出时按 威胁分级低 -> 最久未更新 的顺序缩减轨迹历史（只留最新的点），直到回到预算的 7/8 以下；
+//   挂了轨迹副本的块池（setTrailMirrorPool）时预算由模型与副本各占一半；
+// - 最新位置同时登记在网格索引 grid() 中（随更新增量维护），点选、就近与范围查询不必遍历全部航迹；
+// - 只依赖 QtCore，不需要界面即可运行（基准、离线回放分析）。
+class TrackModel : public QObject
+{
+    Q_OBJECT
+public:
+    struct TrailPoint
+    {
+        QPointF pos; // 东、北 (m)，以雷达为原点
+        qint64 ms;
+    };
+
+    struct Track
+    {
+        quint16 id{};
+        float distance{};  // m
+        float azimuth{};   // deg
+        float elevation{}; // deg
+        float speed{};     // m/s（取绝对值）
+        float course{};    // deg
+        quint8 targetType{};
+        quint8 targetSize{};
+        quint8 pointType{}; // 0检测点 1外推点
+        quint8 trackType{};
+        quint8 lostCount{};
+        quint8 quality{};
+        bool identityKnown{}; // targetType != 0 视为身份已知
+        float score{};        // 威胁分 0..1
+        quint8 tier{};        // 威胁分级 0/1/2，见 ThreatScorer
+        qint64 firstMs{};     // 首次出现
+        qint64 lastMs{};      // 最近一次更新
+        RingBuffer<TrailPoint> trail;
+        quint32 trailPushed{};    // 累计追加的轨迹点数（末点被代替不计）：trail[i] 的序号为 trailPushed - trail.size() + i
+        TrailSimplifier trailFit; // 轨迹末段的抽稀状态
+        quint8 pending{}; // 本发布周期内的变化（模型内部使用）
+
+        // 最近一点为外推点或连续丢失中
+        bool coasting() const { return pointType == 1 || lostCount > 0; }
+    };
+
+    using Tracks = TrackTable<Track>;
+
+    explicit TrackModel(QObject *parent = nullptr);
+
+    // 量程（米）：超出量程的航迹删除，威胁分的距离归一化也用它
+    void setMaxRange(float meters);
+    float maxRange() const { return m_maxRange; }
+    // 威胁评分参数，可随时修改：全部航迹重算，分数变化的随下一次发布通知
+    void setThreatWeights(const ThreatWeights &w);
+    const ThreatWeights &threatWeights() const { return m_scorer.weights(); }
+    void setMaxSpeed(float mps);
+    float maxSpeed() const { return m_scorer.maxSpeed(); }
+    // 轨迹保留（默认：保留5分钟，单条轨迹最多2000点）
+    void setTrailRetentionMs(qint64 ms);
+    qint64 trailRetentionMs() const { return m_trailKeepMs; }
+    void setMaxTrailPoints(int n) { m_maxTrailPoints = qMax(10, n); }
+    int maxTrailPoints() const { return m_maxTrailPoints; }
+    // 轨迹抽稀容差（米，默认5m，约为默认量程下的半个像素）；0 表示保留每个点
+    void setTrailTolerance(float meters) { m_trailTolerance = qMax(0.0f, meters); }
+    float trailTolerance() const { return m_trailTolerance; }
+    // 轨迹缓冲内存预算（字节，默认64MB，0 为不限）：轨迹缓冲增长时检查，超出则低威胁、久未更新的航迹先让出历史
+    void setTrailMemoryBudget(qint64 bytes);
+    qint64 trailMemoryBudget() const { return m_trailBudget; }
+    // 轨迹副本（雷达盘的绘制镜像 ScopeScene）所用的块池，nullptr 为取消；最多挂一个，池须在取消前一直有效。
+    // 挂上后预算的一半留给副本（副本每条轨迹的容量不超过模型中对应的一条），模型自己按另一半缩减，
+    // 副本的在用字节计入 trailStats
+    void setTrailMirrorPool(BlockPool *pool);
+    TrailStats trailStats() const;
+    // 航迹超过此时长无更新即删除（默认60s）；最近一点为外推点或连续丢失中的航迹用 coastTimeoutMs（默认10s）
+    void setTrackTimeoutMs(qint64 ms);
+    qint64 trackTimeoutMs() const { return m_trackTimeoutMs; }
+    void setCoastTimeoutMs(qint64 ms);
+    qint64 coastTimeoutMs() const { return m_coastTimeoutMs; }
+
+    const Tracks &tracks() const { return m_tracks; }
+    int size() const { return m_tracks.size(); }
+    const Track *find(quint16 id) const { return m_tracks.find(id); }
+    const Track *find(Tracks::Handle h) const { return m_tracks.find(h); }
+    Tracks::Handle handle(quint16 id) const { return m_tracks.handle(id); }
+    // 航迹滤波位置（东-北，米，最近一次更新时刻）的空间索引；显示位置是 nowMs 的预测，点选用 pick
+    const TrackGrid &grid() const { return m_grid; }
+    // 点选：nowMs 时刻的预测位置（即雷达盘上末端点的位置）距 pos 不超过 maxDist 的最近一条，没有返回 -1；
+    // 网格按滤波位置索引，查询半径放宽 filter().maxLead(nowMs)，再逐条按预测位置比较
+    int pick(QPointF pos, float maxDist, qint64 nowMs) const;
+    // 航迹滤波状态：predict(id, 时刻) 得到显示/拦截用的位置
+    const TrackFilter &filter() const { return m_filter; }
+    void setFilterGains(float alpha, float beta) { m_filter.setGains(alpha, beta); }
+    // 同 applyTrack，但以 nowMs 作为该点的时刻（回放、基准构造历史轨迹用）；nowMs 应单调不减
+    void applyTrackAt(const TrackMessage &msg, qint64 nowMs);
+
+public slots:
+    void applyTrack(const TrackMessage &msg);
+    void applyBatch(const TrackBatch &batch);
+    // 删除一条航迹（如被命中），立即发布
+    bool remove(quint16 id);
+    void clear();
+    // 处理截止时刻不晚于 nowMs 的航迹：裁剪过期轨迹点、删除超时航迹（内部定时器按时间轮 tick 调用）
+    void expire(qint64 nowMs);
+
+signals:
+    void changed(const TrackChangeSet &changes);
+
+private:
+    enum Pending : quint8
+    {
+        None,
+        Added,
+        Updated
+    };
+
+    // 应用一条记录的公共部分：量程判定、建立航迹、追加轨迹点；超出量程返回 nullptr
+    Track *touch(quint16 id, float distance, float azimuth, qint64 nowMs);
+    void erase(quint16 id);
+    void publish();
+    // 航迹的下一个截止时刻：超时删除与最旧轨迹点到期取较早者
+    qint64 deadlineOf(const Track &t) const;
+    // 截止时刻提前时改期；推迟的不改，到时重新计算（每次更新不必动时间轮）
+    void scheduleExpiry(const Track &t);
+    void runExpiry(qint64 nowMs);
+    void rescheduleAll();
+    void enforceTrailBudget();
+    // 模型自己的轨迹缓冲可用的预算（挂了副本时为一半）
+    qint64 ownTrailBudget() const { return m_mirrorPool ? m_trailBudget / 2 : m_trailBudget; }
+    void applyTrailCacheLimits();
+
+    BlockPool m_trailPool;            // 须先于 m_tracks 构造、后于其析构
+    BlockPool *m_mirrorPool{nullptr}; // 轨迹副本的块池（不拥有）
+    Tracks m_tracks;
+    TrackChangeSet m_changes; // 本发布周期累计
+    TrackChangeSet m_published;
+    ThreatScorer m_scorer;
+    TrackGrid m_grid;
+    TrackFilter m_filter;
+    QVector<quint16> m_rescored; // 本次重算中分数变化的批号
+    TimerWheel m_expiry;
+    QVector<quint16> m_due; // 本次到期的批号
+    QTimer m_expiryTimer;
+    QVector<int> m_shedOrder; // 缩减轨迹的候选（m_tracks 中的位置）
+
+    float m_maxRange = 5000.0f;
+    qint64 m_trailKeepMs = 5ll * 60ll * 1000ll;
+    int m_maxTrailPoints = 2000;
+    qint64 m_trackTimeoutMs = 60000;
+    qint64 m_coastTimeoutMs = 10000;
+    float m_trailTolerance = 5.0f;
+    quint64 m_receivedPoints = 0;
+    quint64 m_keptPoints = 0;
+    qint64 m_trailBudget = 64ll << 20;
+    quint64 m_shedPoints = 0;
+    quint64 m_shedTracks = 0;
+    bool m_budgetWarned = false;
+};
@@ -0,0 +1,139 @@
+// TrackTable.h
+#pragma once
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+#include "DenseIdIndex.h"
+
+// 以批号（quint16）为键的航迹表：
+// - 批号 -> 稠密数组位置用 DenseIdIndex，查找/插入/删除均为 O(1)，与航迹数无关；
+// - 元素在稠密数组中连续存放，遍历不经过空槽；删除时用末尾元素填补空位（遍历顺序因此会变）；
+// - Handle 记录批号与插入代号：航迹删除后即便同一批号重新出现，旧 Handle 也不再命中；
+// - 索引与代号表在第一次插入时才分配（共512KB），空表几乎不占内存。
+// 指向元素的指针/引用在下一次插入或删除后失效，需要跨调用持有时用 Handle。
+template <typename T>
+class TrackTable
+{
+public:
+    struct Handle
+    {
+        quint16 id{0};
+        quint32 gen{0}; // 0 表示空 Handle
+        explicit operator bool() const { return gen != 0; }
+    };
+
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    TrackTable() = default;
+    TrackTable(const TrackTable &) = delete;
+    TrackTable &operator=(const TrackTable &) = delete;
+
+    int size() const { return int(m_items.size()); }
+    bool isEmpty() const { return m_items.empty(); }
+    void reserve(int n)
+    {
+        m_items.reserve(std::size_t(n));
+        m_index.reserve(n);
+    }
+
+    bool contains(quint16 id) const { return m_index.contains(id); }
+
+    T *find(quint16 id)
+    {
+        const int pos = m_index.rowOf(id);
+        return pos < 0 ? nullptr : &m_items[std::size_t(pos)];
+    }
+    const T *find(quint16 id) const { return const_cast<TrackTable *>(this)->find(id); }
+
+    // Handle 对应的航迹已删除（或批号已被新航迹复用）时返回 nullptr
+    T *find(Handle h)
+    {
+        if (!h || !m_gens || m_gens[h.id] != h.gen)
+            return nullptr;
+        return find(h.id);
+    }
+    const T *find(Handle h) const { return const_cast<TrackTable *>(this)->find(h); }
+
+    Handle handle(quint16 id) const
+    {
+        if (!contains(id))
+            return {};
+        return {id, m_gens[id]};
+    }
+
+    // 查找，不存在则默认构造一项；created 返回是否新建
+    T &insert(quint16 id, bool *created = nullptr)
+    {
+        int pos = m_index.rowOf(id);
+        if (created)
+            *created = pos < 0;
+        if (pos < 0)
+        {
+            if (!m_gens)
+                m_gens.reset(new quint32[IndexSize]());
+            if (++m_nextGen == 0)
+                m_nextGen = 1;
+            m_gens[id] = m_nextGen;
+            pos = m_index.append(id);
+            m_items.emplace_back();
+        }
+        return m_items[std::size_t(pos)];
+    }
+
+    bool remove(quint16 id)
+    {
+        const int pos = m_index.rowOf(id);
+        if (pos < 0)
+            return false;
+        eraseAt(pos);
+        return true;
+    }
+
+    // 删除满足 pred(const T &) 的所有项，返回删除个数
+    template <typename Pred>
+    int removeIf(Pred pred)
+    {
+        int removed = 0;
+        for (int i = size() - 1; i >= 0; --i)
+        {
+            if (pred(m_items[std::size_t(i)]))
+            {
+                eraseAt(i);
+                ++removed;
+            }
+        }
+        return removed;
+    }
+
+    void clear()
+    {
+        m_index.clear();
+        m_items.clear();
+    }
+
+    // 稠密遍历；idAt(i) 为第 i 项的批号
+    iterator begin() { return m_items.begin(); }
+    iterator end() { return m_items.end(); }
+    const_iterator begin() const { return m_items.begin(); }
+    const_iterator end() const { return m_items.end(); }
+    T &at(int i) { return m_items[std::size_t(i)]; }
+    const T &at(int i) const { return m_items[std::size_t(i)]; }
+    quint16 idAt(int i) const { return m_index.idAt(i); }
+
+private:
+    static constexpr std::size_t IndexSize = 65536;
+
+    void eraseAt(int pos)
+    {
+        // 末尾元素移到空位
+        m_index.removeRow(pos);
+        DenseIdIndex::eraseRow(pos, m_items);
+    }
+
+    DenseIdIndex m_index;              // 批号 <-> 位置
+    std::unique_ptr<quint32[]> m_gens; // 批号 -> 最近一次插入的代号
+    std::vector<T> m_items;
+    quint32 m_nextGen{0};
+};
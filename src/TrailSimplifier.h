@@ -0,0 +1,90 @@
+// TrailSimplifier.h
+#pragma once
+
+#include <QPointF>
+#include <QtMath>
+#include <cmath>
+
+// 轨迹在线抽稀（每条航迹一个，O(1) 状态）：
+// - 轨迹末两点为锚点 A 与浮动点 B；新点 C 到达时，若 A 之后收到的每个原始点到直线 A->C 的距离
+//   都不超过容差，且 C 不比这些点更靠近 A（不回头），则用 C 替换 B，被丢弃的点到线段 A-C 的距离
+//   不超过容差；否则 C 作为新的浮动点、B 成为新锚点；
+// - 判定用“方向锥”：每个原始点 P 允许的方向为 A->P 方向 ± asin(容差/|AP|)，各点区间求交，
+//   不需要保存被丢弃的点；
+// - 匀速直线的目标只保留首尾几个点，机动处保留拐点，误差上界为容差（米）。
+class TrailSimplifier
+{
+public:
+    // 轨迹首端被裁剪或清空后调用：下一个点重新开始一段
+    void reset() { m_open = false; }
+
+    // anchor 为末点之前的一点（A），next 为新点（C）；返回 true 表示末点（B）可由 C 替换
+    bool tryExtend(QPointF anchor, QPointF next, float tolerance)
+    {
+        if (!m_open)
+            return false;
+        const qreal dx = next.x() - anchor.x(), dy = next.y() - anchor.y();
+        const qreal d = std::hypot(dx, dy);
+        if (d < m_far)
+            return false; // 回头：线段 A->C 覆盖不到更远的点
+        if (d <= tolerance)
+        {
+            // 本段的点都在 A 的容差圆内；C 是目前最远的点，后续点不得回到它之内
+            m_far = d;
+            return true;
+        }
+        const qreal w = qAsin(tolerance / d);
+        if (m_lo <= -M_PI)
+        {
+            // 此前的点都离 A 很近，方向尚无约束：以 C 的方向为参考
+            m_refX = dx / d;
+            m_refY = dy / d;
+            m_lo = -w;
+            m_hi = w;
+            m_far = d;
+            return true;
+        }
+        const qreal rel = relativeAngle(dx, dy);
+        if (rel < m_lo || rel > m_hi)
+            return false;
+        m_lo = qMax(m_lo, rel - w);
+        m_hi = qMin(m_hi, rel + w);
+        m_far = d;
+        return true;
+    }
+
+    // C 未能替换 B（或是一段的第二个点）：以 anchor 为新锚点、next 为浮动点开一段
+    void open(QPointF anchor, QPointF next, float tolerance)
+    {
+        const qreal dx = next.x() - anchor.x(), dy = next.y() - anchor.y();
+        const qreal d = std::hypot(dx, dy);
+        m_open = true;
+        m_far = d;
+        if (d > tolerance)
+        {
+            m_refX = dx / d;
+            m_refY = dy / d;
+            const qreal w = qAsin(tolerance / d);
+            m_lo = -w;
+            m_hi = w;
+        }
+        else
+        {
+            // 离锚点太近，方向不确定：暂不约束
+            m_lo = -M_PI;
+            m_hi = M_PI;
+        }
+    }
+
+private:
+    // 相对参考方向的转角，(-pi, pi]
+    qreal relativeAngle(qreal dx, qreal dy) const
+    {
+        return std::atan2(m_refX * dy - m_refY * dx, m_refX * dx + m_refY * dy);
+    }
+
+    bool m_open{false};
+    qreal m_refX{1.0}, m_refY{0.0}; // 锥的参考方向（单位向量）
+    qreal m_lo{}, m_hi{};           // 允许方向区间，相对参考方向（弧度）
+    qreal m_far{};                  // 本段原始点离锚点的最远距离
+};
@@ -7,8 +7,10 @@
 #include "RadarConfigWidget.h"
 #include "RadarStatusWidget.h"
 #include <QDebug>
+#include <QStandardPaths>
 #include "NetworkManager.h"
 #include "RadarScopeWidget.h"
+#include "TrackModel.h"
 #include "RadarStatus.h"
 #include "Protocol.h"
 #include "MessageIds.h"
@@ -17,6 +19,32 @@ int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // 航迹状态只有一份：雷达盘与目标列表都从这个模型渲染（须比窗口活得久）
+    TrackModel tracks;
+    // 威胁分权重可用 RADAR_THREAT_WEIGHTS="距离,速度,类型,身份" 覆盖（如 "0.4,0.4,0.1,0.1"）
+    if (qEnvironmentVariableIsSet("RADAR_THREAT_WEIGHTS"))
+    {
+        const QStringList parts = qEnvironmentVariable("RADAR_THREAT_WEIGHTS").split(QLatin1Char(','));
+        bool ok = parts.size() == 4;
+        float v[4] = {};
+        for (int i = 0; ok && i < 4; ++i)
+            v[i] = parts[i].trimmed().toFloat(&ok);
+        if (ok)
+            tracks.setThreatWeights(ThreatWeights{v[0], v[1], v[2], v[3]});
+        else
+            qWarning() << "Ignoring malformed RADAR_THREAT_WEIGHTS, expected 4 comma-separated numbers";
+    }
+    // 轨迹内存预算：RADAR_TRAIL_BUDGET_MB（默认64，0 为不限）
+    if (qEnvironmentVariableIsSet("RADAR_TRAIL_BUDGET_MB"))
+    {
+        bool ok = false;
+        const double mb = qEnvironmentVariable("RADAR_TRAIL_BUDGET_MB").toDouble(&ok);
+        if (ok && mb >= 0.0)
+            tracks.setTrailMemoryBudget(qint64(mb * 1024.0 * 1024.0));
+        else
+            qWarning() << "Ignoring malformed RADAR_TRAIL_BUDGET_MB, expected a non-negative number";
+    }
+
     QWidget window;
     window.setWindowTitle("雷达状态与任务配置");
 
@@ -36,12 +64,17 @@ int main(int argc, char *argv[])
     auto *scope = new RadarScopeWidget();
     scope->setMinimumHeight(420);
     scope->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    scope->setTrackModel(&tracks);
+    // RADAR_SCOPE_THREADED=1：雷达盘在后台线程光栅化，界面线程只贴图
+    if (qEnvironmentVariableIntValue("RADAR_SCOPE_THREADED") != 0)
+        scope->setThreadedRendering(true);
     leftSplit->addWidget(scope);
     leftSplit->setStretchFactor(0, 1); // 状态区
     leftSplit->setStretchFactor(1, 2); // 雷达盘更大
 
     // 右侧：配置 + 滚动条
     auto *cfg = new RadarConfigWidget();
+    cfg->setTrackModel(&tracks);
     auto *scroll = new QScrollArea();
     scroll->setWidgetResizable(true);
     scroll->setWidget(cfg);
@@ -61,9 +94,54 @@ int main(int argc, char *argv[])
 
     // Network manager: listen for local clients (6553) and connect to radar (6280)
     NetworkManager net;
+    // 采集参数可用环境变量覆盖：RADAR_RECV_BATCH（recvmmsg批大小）、RADAR_RECV_POOL（缓冲池槽数）、
+    // RADAR_VERIFY_CHECKSUM=0（不校验帧尾，联调用）、RADAR_RECORD_DIR（原始数据报记录目录）、RADAR_RECORD=0（关闭记录）
+    IngestConfig ingestCfg;
+    if (qEnvironmentVariableIsSet("RADAR_RECV_BATCH"))
+        ingestCfg.batchSize = qEnvironmentVariableIntValue("RADAR_RECV_BATCH");
+    if (qEnvironmentVariableIsSet("RADAR_RECV_POOL"))
+        ingestCfg.poolSize = qEnvironmentVariableIntValue("RADAR_RECV_POOL");
+    if (qEnvironmentVariableIsSet("RADAR_VERIFY_CHECKSUM"))
+        ingestCfg.verifyChecksums = qEnvironmentVariableIntValue("RADAR_VERIFY_CHECKSUM") != 0;
+    // 原始数据报默认始终记录，便于事后复现
+    ingestCfg.recorder.directory = qEnvironmentVariableIsSet("RADAR_RECORD_DIR")
+                                       ? qEnvironmentVariable("RADAR_RECORD_DIR")
+                                       : QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QStringLiteral("/recordings");
+    if (qEnvironmentVariableIsSet("RADAR_RECORD") && qEnvironmentVariableIntValue("RADAR_RECORD") == 0)
+        ingestCfg.recorder.directory.clear();
+    net.setIngestConfig(ingestCfg);
     net.start();
     net.setTarget(QHostAddress(QHostAddress::LocalHost), 6280);
 
+    // 回放记录：RADAR_REPLAY=<.rec文件或记录目录>，RADAR_REPLAY_SPEED（1 实时，N 倍速，0 最快，用于测吞吐）
+    if (qEnvironmentVariableIsSet("RADAR_REPLAY"))
+    {
+        bool ok = false;
+        double speed = qEnvironmentVariable("RADAR_REPLAY_SPEED").toDouble(&ok);
+        if (!ok)
+            speed = 1.0;
+        QObject::connect(&net, &NetworkManager::replayFinished, &net, [&net, &tracks, scope](const ReplayStats &s)
+                         {
+            const IngestStats is = net.ingestStats();
+            qInfo().nospace() << "Replay finished: " << s.datagrams << " datagrams in " << s.elapsedNs / 1e6 << " ms ("
+                              << s.datagramsPerSec << "/s, " << s.megabytesPerSec << " MB/s), backpressure "
+                              << s.backpressure << ", queue high water " << is.queueHighWater;
+            const TrailStats ts = tracks.trailStats();
+            qInfo().nospace() << "Trails: " << ts.tracks << " tracks, " << ts.points << " points, compression "
+                              << ts.compression() << ":1, " << ts.bytesPerTrack() << " bytes/track";
+            qInfo().nospace() << "Trail pool: " << ts.poolLiveBytes << " bytes live (peak " << ts.poolPeakBytes << "), "
+                              << ts.poolCachedBytes << " cached, scope mirror " << ts.mirrorLiveBytes << " live, budget "
+                              << ts.budgetBytes << ", shed " << ts.shedPoints
+                              << " points from " << ts.shedTracks << " tracks";
+            const ScopeRenderStats rs = scope->renderStats();
+            qInfo().nospace() << "Scope render" << (scope->threadedRendering() ? " (threaded)" : "") << ": " << rs.frames
+                              << " frames, snapshot avg " << rs.snapshot.avgNs / 1e6 << " ms (max " << rs.snapshot.maxNs / 1e6
+                              << "), build avg " << rs.build.avgNs / 1e6 << " ms (max " << rs.build.maxNs / 1e6
+                              << "), raster avg " << rs.raster.avgNs / 1e6 << " ms (max " << rs.raster.maxNs / 1e6
+                              << "), deferred " << rs.deferred; });
+        net.startReplay(qEnvironmentVariable("RADAR_REPLAY"), speed);
+    }
+
     auto sendToRadar = [&net](const QJsonObject &obj)
     {
         QJsonDocument d(obj);
@@ -104,23 +182,24 @@ int main(int argc, char *argv[])
         scope->clearTrails(); });
     // removed: servo connection
 
-    // log messages from network
-    QObject::connect(&net, &NetworkManager::clientMessageReceived, [](const QByteArray &data)
-                     { qDebug() << "Client->APP:" << data; });
     QObject::connect(&net, &NetworkManager::radarConnected, [](bool c)
                      { qDebug() << "Radar connected:" << c; });
 
-    // forward radar UDP payloads into UI preview/log
-    QObject::connect(&net, &NetworkManager::radarDatagramReceived, cfg, &RadarConfigWidget::onRadarDatagramReceived);
-    QObject::connect(&net, &NetworkManager::radarDatagramReceived, status, &RadarStatusWidget::onRadarDatagram);
-    QObject::connect(&net, &NetworkManager::radarDatagramReceived, scope, &RadarScopeWidget::onTrackDatagram);
+    // forward radar UDP payloads into UI log; 解析已在采集线程完成，界面只接收解析结果
+    // （数据报是缓冲槽的无拷贝视图，只在发出期间有效，必须直连）
+    QObject::connect(&net, &NetworkManager::radarDatagramReceived, cfg, &RadarConfigWidget::onRadarDatagramReceived,
+                     Qt::DirectConnection);
+    QObject::connect(&net, &NetworkManager::radarStatusReceived, status, &RadarStatusWidget::onRadarStatus);
+    // 航迹按批分发：单航迹帧与批量帧在每轮取队列时合并，模型整批应用一次、发布一次变化，各视图每批只刷新一次
+    QObject::connect(&net, &NetworkManager::trackBatchReceived, &tracks, &TrackModel::applyBatch);
     // 当右侧选择目标时，在雷达盘高亮
     QObject::connect(cfg, &RadarConfigWidget::targetSelected, scope, &RadarScopeWidget::highlightTarget);
+    // 在雷达盘上点选目标时，右侧列表同步选中并显示详情
+    QObject::connect(scope, &RadarScopeWidget::targetPicked, cfg, &RadarConfigWidget::selectTarget);
     // 锁定/下达打击：目前仅打印，后续可以发送网络指令
     QObject::connect(cfg, &RadarConfigWidget::targetLockRequested, scope, &RadarScopeWidget::lockTarget);
     QObject::connect(cfg, &RadarConfigWidget::targetEngageRequested, scope, &RadarScopeWidget::engageTarget);
-    // when scope reports a hit, remove from right panel
-    QObject::connect(scope, &RadarScopeWidget::targetHit, cfg, &RadarConfigWidget::removeTargetById);
+    // 命中的目标已由雷达盘从模型删除，右侧列表随模型变化移除
     // when scope reports a hit, also send HitReport (0x4444) packet via network
     QObject::connect(scope, &RadarScopeWidget::targetHit, &net, [&net](quint16 id)
                      {
@@ -130,13 +209,15 @@ int main(int argc, char *argv[])
         QByteArray pkt = Protocol::buildHitPacket(hc, quint8(id & 0xFF));
         net.sendToRadar(pkt); });
     // 用状态报文动态更新量程
-    QObject::connect(&net, &NetworkManager::radarDatagramReceived, &window, [scope, cfg](const QByteArray &data)
+    QObject::connect(&net, &NetworkManager::radarStatusReceived, &window, [scope, cfg, &tracks](const RadarStatus &s)
                      {
-        RadarStatus s; if (RadarStatusParser::parseLittleEndian(data, s)) {
-            if (s.detectRange > 0) scope->setMaxRangeMeters(float(s.detectRange));
-            // 通知配置面板当前雷达是否为撤收状态
-            cfg->onRadarStatusUpdated(s);
-        } });
+        if (s.detectRange > 0) {
+            scope->setMaxRangeMeters(float(s.detectRange));
+            // 量程外的航迹由模型删除，威胁分按新量程重算
+            tracks.setMaxRange(float(s.detectRange));
+        }
+        // 通知配置面板当前雷达是否为撤收状态
+        cfg->onRadarStatusUpdated(s); });
 
     return app.exec();
 }
@@ -0,0 +1,132 @@
+// IngestBatchTest.cpp
+// 端到端：经回环 UDP 发送 500 条航迹的批量帧（0x3003，约 35KB），由采集对象接收、解码入队，
+// 取出后逐行与发送内容比对。recvmmsg 与 QUdpSocket 两种接收后端各跑一遍，
+// 每种连发几帧，确认队列交换复用批的容量后内容仍正确。失败时返回非0。
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QUdpSocket>
+#include <cstdio>
+#include "Protocol.h"
+#include "RadarIngest.h"
+#include "TrackBatch.h"
+
+namespace
+{
+    constexpr int Records = 500;
+    constexpr int Frames = 3;
+
+    int g_failures = 0;
+
+    void check(bool ok, const char *what, int backend, int frame)
+    {
+        if (ok)
+            return;
+        ++g_failures;
+        std::fprintf(stderr, "FAIL [%s frame %d] %s\n", backend ? "recvmmsg" : "qudpsocket", frame, what);
+    }
+
+    TrackBatch makeBatch(int frame)
+    {
+        TrackBatch b;
+        b.insValid = true;
+        b.radarLon = 116.3975;
+        b.radarLat = 39.9087;
+        b.radarAlt = 50.0f;
+        for (int i = 0; i < Records; ++i)
+        {
+            TrackInfo ti;
+            ti.trackId = quint16(frame * Records + i + 1);
+            ti.tgtLon = b.radarLon + 1e-5 * i;
+            ti.tgtLat = b.radarLat - 1e-5 * i;
+            ti.distance = 10.0f * float(i);
+            ti.azimuth = float(i % 360);
+            ti.elevation = 3.0f;
+            ti.speed = float(frame);
+            ti.course = float((i * 7) % 360);
+            ti.trackType = 2;
+            ti.quality = quint8(i % 101);
+            ti.rawDistance = ti.distance;
+            ti.rawAzimuth = ti.azimuth;
+            ti.rawElevation = ti.elevation;
+            b.append(ti);
+        }
+        return b;
+    }
+
+    void runBackend(bool batched, quint16 port)
+    {
+        IngestConfig cfg;
+        cfg.batchedReceive = batched;
+        cfg.queueCapacity = 16;
+        cfg.poolSize = 64;
+        cfg.batchSize = 8;
+        RadarIngestWorker worker(port, cfg);
+        bool bound = false;
+        QObject::connect(&worker, &RadarIngestWorker::bindFinished, [&](bool ok)
+                         { bound = ok; });
+        worker.start();
+        check(bound, "bind", batched, -1);
+        if (!bound)
+            return;
+
+        QUdpSocket sender;
+        Protocol::HeaderConfig hc;
+        hc.checkMethod = 2; // 整帧 CRC16
+        IngestFrame frame;
+        for (int f = 0; f < Frames; ++f)
+        {
+            const TrackBatch sent = makeBatch(f);
+            const QByteArray packet = Protocol::buildTrackBatchPacket(hc, sent, 0, sent.size(), quint8(f), quint32(f));
+            check(packet.size() == TrackBatchView::frameSize(Records), "packet size", batched, f);
+            check(sender.writeDatagram(packet, QHostAddress::LocalHost, port) == packet.size(), "send", batched, f);
+
+            QElapsedTimer timer;
+            timer.start();
+            bool got = false;
+            while (!(got = worker.queue().tryPopSwap(frame)) && timer.elapsed() < 2000)
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            check(got, "frame received", batched, f);
+            if (!got)
+                return;
+
+            check(frame.kind == MessageDispatcher::Result::TrackBatch, "dispatched as track batch", batched, f);
+            check(frame.hasBatch && !frame.hasTrack && !frame.hasStatus, "frame flags", batched, f);
+            check(frame.raw.size() == packet.size(), "raw size", batched, f);
+            const TrackBatch &b = frame.batch;
+            check(b.size() == Records, "record count", batched, f);
+            check(b.insValid && b.radarLon == sent.radarLon && b.radarLat == sent.radarLat && b.radarAlt == sent.radarAlt,
+                  "common fields", batched, f);
+            bool rowsOk = b.size() == Records;
+            for (int i = 0; rowsOk && i < Records; ++i)
+            {
+                rowsOk = b.trackId[i] == sent.trackId[i] && b.tgtLon[i] == sent.tgtLon[i] &&
+                         b.tgtLat[i] == sent.tgtLat[i] && b.distance[i] == sent.distance[i] &&
+                         b.azimuth[i] == sent.azimuth[i] && b.speed[i] == sent.speed[i] &&
+                         b.course[i] == sent.course[i] && b.quality[i] == sent.quality[i];
+            }
+            check(rowsOk, "record contents", batched, f);
+            frame.release();
+        }
+
+        const IngestStats st = worker.stats();
+        check(st.truncated == 0, "no truncated datagrams", batched, -1);
+        check(st.batchRecords == quint64(Records * Frames), "batch record count", batched, -1);
+        check(st.invalidRecords == 0, "no invalid records", batched, -1);
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+#if defined(Q_OS_LINUX)
+    runBackend(true, 46553);
+#endif
+    runBackend(false, 46554);
+    if (g_failures)
+    {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("ingest batch: %d x %d records ok\n", Frames, Records);
+    return 0;
+}